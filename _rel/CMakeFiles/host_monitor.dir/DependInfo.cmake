@@ -0,0 +1,52 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Endpoint.cpp" "CMakeFiles/host_monitor.dir/src/Endpoint.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Endpoint.cpp.o.d"
+  "/root/repo/src/EventLoop.cpp" "CMakeFiles/host_monitor.dir/src/EventLoop.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/EventLoop.cpp.o.d"
+  "/root/repo/src/FlapDamper.cpp" "CMakeFiles/host_monitor.dir/src/FlapDamper.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/FlapDamper.cpp.o.d"
+  "/root/repo/src/HostMonitor.cpp" "CMakeFiles/host_monitor.dir/src/HostMonitor.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/HostMonitor.cpp.o.d"
+  "/root/repo/src/HttpProbe.cpp" "CMakeFiles/host_monitor.dir/src/HttpProbe.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/HttpProbe.cpp.o.d"
+  "/root/repo/src/IcmpProbe.cpp" "CMakeFiles/host_monitor.dir/src/IcmpProbe.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/IcmpProbe.cpp.o.d"
+  "/root/repo/src/IcmpTransport.cpp" "CMakeFiles/host_monitor.dir/src/IcmpTransport.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/IcmpTransport.cpp.o.d"
+  "/root/repo/src/LatencyHistogram.cpp" "CMakeFiles/host_monitor.dir/src/LatencyHistogram.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/LatencyHistogram.cpp.o.d"
+  "/root/repo/src/Metrics.cpp" "CMakeFiles/host_monitor.dir/src/Metrics.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Metrics.cpp.o.d"
+  "/root/repo/src/MetricsRegistry.cpp" "CMakeFiles/host_monitor.dir/src/MetricsRegistry.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/MetricsRegistry.cpp.o.d"
+  "/root/repo/src/MonitorEngine.cpp" "CMakeFiles/host_monitor.dir/src/MonitorEngine.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/MonitorEngine.cpp.o.d"
+  "/root/repo/src/MonitorSet.cpp" "CMakeFiles/host_monitor.dir/src/MonitorSet.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/MonitorSet.cpp.o.d"
+  "/root/repo/src/MonitorThread.cpp" "CMakeFiles/host_monitor.dir/src/MonitorThread.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/MonitorThread.cpp.o.d"
+  "/root/repo/src/Notifier.cpp" "CMakeFiles/host_monitor.dir/src/Notifier.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Notifier.cpp.o.d"
+  "/root/repo/src/PersistentTcpProbe.cpp" "CMakeFiles/host_monitor.dir/src/PersistentTcpProbe.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/PersistentTcpProbe.cpp.o.d"
+  "/root/repo/src/Poller.cpp" "CMakeFiles/host_monitor.dir/src/Poller.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Poller.cpp.o.d"
+  "/root/repo/src/Probe.cpp" "CMakeFiles/host_monitor.dir/src/Probe.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Probe.cpp.o.d"
+  "/root/repo/src/RateLimiter.cpp" "CMakeFiles/host_monitor.dir/src/RateLimiter.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/RateLimiter.cpp.o.d"
+  "/root/repo/src/Resolver.cpp" "CMakeFiles/host_monitor.dir/src/Resolver.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Resolver.cpp.o.d"
+  "/root/repo/src/ResolvingProbe.cpp" "CMakeFiles/host_monitor.dir/src/ResolvingProbe.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/ResolvingProbe.cpp.o.d"
+  "/root/repo/src/Socket.cpp" "CMakeFiles/host_monitor.dir/src/Socket.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Socket.cpp.o.d"
+  "/root/repo/src/StateJournal.cpp" "CMakeFiles/host_monitor.dir/src/StateJournal.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/StateJournal.cpp.o.d"
+  "/root/repo/src/TcpProbe.cpp" "CMakeFiles/host_monitor.dir/src/TcpProbe.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/TcpProbe.cpp.o.d"
+  "/root/repo/src/TestConnection.cpp" "CMakeFiles/host_monitor.dir/src/TestConnection.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/TestConnection.cpp.o.d"
+  "/root/repo/src/TimerWheel.cpp" "CMakeFiles/host_monitor.dir/src/TimerWheel.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/TimerWheel.cpp.o.d"
+  "/root/repo/src/UdpProbe.cpp" "CMakeFiles/host_monitor.dir/src/UdpProbe.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/UdpProbe.cpp.o.d"
+  "/root/repo/src/UringPoller.cpp" "CMakeFiles/host_monitor.dir/src/UringPoller.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/UringPoller.cpp.o.d"
+  "/root/repo/src/Version.cpp" "CMakeFiles/host_monitor.dir/src/Version.cpp.o" "gcc" "CMakeFiles/host_monitor.dir/src/Version.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_rel/libhost_monitor.so" "/root/repo/_rel/libhost_monitor.so.2.0.0"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,66 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/host_monitor.dir/src/Endpoint.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Endpoint.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/EventLoop.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/EventLoop.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/FlapDamper.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/FlapDamper.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/HostMonitor.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/HostMonitor.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/HttpProbe.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/HttpProbe.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/IcmpProbe.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/IcmpProbe.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/IcmpTransport.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/IcmpTransport.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/LatencyHistogram.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/LatencyHistogram.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/Metrics.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Metrics.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/MetricsRegistry.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/MetricsRegistry.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/MonitorEngine.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/MonitorEngine.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/MonitorSet.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/MonitorSet.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/MonitorThread.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/MonitorThread.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/Notifier.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Notifier.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/PersistentTcpProbe.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/PersistentTcpProbe.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/Poller.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Poller.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/Probe.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Probe.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/RateLimiter.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/RateLimiter.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/Resolver.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Resolver.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/ResolvingProbe.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/ResolvingProbe.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/Socket.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Socket.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/StateJournal.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/StateJournal.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/TcpProbe.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/TcpProbe.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/TestConnection.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/TestConnection.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/TimerWheel.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/TimerWheel.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/UdpProbe.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/UdpProbe.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/UringPoller.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/UringPoller.cpp.o.d"
+  "CMakeFiles/host_monitor.dir/src/Version.cpp.o"
+  "CMakeFiles/host_monitor.dir/src/Version.cpp.o.d"
+  "libhost_monitor.pdb"
+  "libhost_monitor.so"
+  "libhost_monitor.so.2.0.0"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/host_monitor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
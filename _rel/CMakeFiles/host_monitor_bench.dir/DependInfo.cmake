@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/IcmpBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/IcmpBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/IcmpBench.cpp.o.d"
+  "/root/repo/bench/MonitorBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/MonitorBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/MonitorBench.cpp.o.d"
+  "/root/repo/bench/PollerBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/PollerBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/PollerBench.cpp.o.d"
+  "/root/repo/bench/RateLimiterBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/RateLimiterBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/RateLimiterBench.cpp.o.d"
+  "/root/repo/bench/StateJournalBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/StateJournalBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/StateJournalBench.cpp.o.d"
+  "/root/repo/bench/TcpBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/TcpBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/TcpBench.cpp.o.d"
+  "/root/repo/bench/TestConnectionBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/TestConnectionBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/TestConnectionBench.cpp.o.d"
+  "/root/repo/bench/TimerWheelBench.cpp" "CMakeFiles/host_monitor_bench.dir/bench/TimerWheelBench.cpp.o" "gcc" "CMakeFiles/host_monitor_bench.dir/bench/TimerWheelBench.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel/CMakeFiles/host_monitor.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
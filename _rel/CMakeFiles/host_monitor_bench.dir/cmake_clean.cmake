@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/host_monitor_bench.dir/bench/IcmpBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/IcmpBench.cpp.o.d"
+  "CMakeFiles/host_monitor_bench.dir/bench/MonitorBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/MonitorBench.cpp.o.d"
+  "CMakeFiles/host_monitor_bench.dir/bench/PollerBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/PollerBench.cpp.o.d"
+  "CMakeFiles/host_monitor_bench.dir/bench/RateLimiterBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/RateLimiterBench.cpp.o.d"
+  "CMakeFiles/host_monitor_bench.dir/bench/StateJournalBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/StateJournalBench.cpp.o.d"
+  "CMakeFiles/host_monitor_bench.dir/bench/TcpBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/TcpBench.cpp.o.d"
+  "CMakeFiles/host_monitor_bench.dir/bench/TestConnectionBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/TestConnectionBench.cpp.o.d"
+  "CMakeFiles/host_monitor_bench.dir/bench/TimerWheelBench.cpp.o"
+  "CMakeFiles/host_monitor_bench.dir/bench/TimerWheelBench.cpp.o.d"
+  "host_monitor_bench"
+  "host_monitor_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/host_monitor_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
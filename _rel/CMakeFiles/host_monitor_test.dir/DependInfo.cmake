@@ -0,0 +1,42 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/DependencyTest.cpp" "CMakeFiles/host_monitor_test.dir/test/DependencyTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/DependencyTest.cpp.o.d"
+  "/root/repo/test/EndpointTest.cpp" "CMakeFiles/host_monitor_test.dir/test/EndpointTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/EndpointTest.cpp.o.d"
+  "/root/repo/test/FlapDamperTest.cpp" "CMakeFiles/host_monitor_test.dir/test/FlapDamperTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/FlapDamperTest.cpp.o.d"
+  "/root/repo/test/HostMonitorObserverTest.cpp" "CMakeFiles/host_monitor_test.dir/test/HostMonitorObserverTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/HostMonitorObserverTest.cpp.o.d"
+  "/root/repo/test/HostMonitorTest.cpp" "CMakeFiles/host_monitor_test.dir/test/HostMonitorTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/HostMonitorTest.cpp.o.d"
+  "/root/repo/test/HttpProbeTest.cpp" "CMakeFiles/host_monitor_test.dir/test/HttpProbeTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/HttpProbeTest.cpp.o.d"
+  "/root/repo/test/IcmpTransportTest.cpp" "CMakeFiles/host_monitor_test.dir/test/IcmpTransportTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/IcmpTransportTest.cpp.o.d"
+  "/root/repo/test/LatencyHistogramTest.cpp" "CMakeFiles/host_monitor_test.dir/test/LatencyHistogramTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/LatencyHistogramTest.cpp.o.d"
+  "/root/repo/test/MetricsTest.cpp" "CMakeFiles/host_monitor_test.dir/test/MetricsTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/MetricsTest.cpp.o.d"
+  "/root/repo/test/MonitorEngineTest.cpp" "CMakeFiles/host_monitor_test.dir/test/MonitorEngineTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/MonitorEngineTest.cpp.o.d"
+  "/root/repo/test/MonitorSetTest.cpp" "CMakeFiles/host_monitor_test.dir/test/MonitorSetTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/MonitorSetTest.cpp.o.d"
+  "/root/repo/test/NotifierTest.cpp" "CMakeFiles/host_monitor_test.dir/test/NotifierTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/NotifierTest.cpp.o.d"
+  "/root/repo/test/PersistentTcpProbeTest.cpp" "CMakeFiles/host_monitor_test.dir/test/PersistentTcpProbeTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/PersistentTcpProbeTest.cpp.o.d"
+  "/root/repo/test/PollerTest.cpp" "CMakeFiles/host_monitor_test.dir/test/PollerTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/PollerTest.cpp.o.d"
+  "/root/repo/test/RateLimiterTest.cpp" "CMakeFiles/host_monitor_test.dir/test/RateLimiterTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/RateLimiterTest.cpp.o.d"
+  "/root/repo/test/ResolverTest.cpp" "CMakeFiles/host_monitor_test.dir/test/ResolverTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/ResolverTest.cpp.o.d"
+  "/root/repo/test/ScheduleTest.cpp" "CMakeFiles/host_monitor_test.dir/test/ScheduleTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/ScheduleTest.cpp.o.d"
+  "/root/repo/test/SeqLockTest.cpp" "CMakeFiles/host_monitor_test.dir/test/SeqLockTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/SeqLockTest.cpp.o.d"
+  "/root/repo/test/StateJournalTest.cpp" "CMakeFiles/host_monitor_test.dir/test/StateJournalTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/StateJournalTest.cpp.o.d"
+  "/root/repo/test/TimerWheelTest.cpp" "CMakeFiles/host_monitor_test.dir/test/TimerWheelTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/TimerWheelTest.cpp.o.d"
+  "/root/repo/test/UdpProbeTest.cpp" "CMakeFiles/host_monitor_test.dir/test/UdpProbeTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/UdpProbeTest.cpp.o.d"
+  "/root/repo/test/VersionTest.cpp" "CMakeFiles/host_monitor_test.dir/test/VersionTest.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/VersionTest.cpp.o.d"
+  "/root/repo/test/main.cpp" "CMakeFiles/host_monitor_test.dir/test/main.cpp.o" "gcc" "CMakeFiles/host_monitor_test.dir/test/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel/CMakeFiles/host_monitor.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/host_monitor_test.dir/test/DependencyTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/DependencyTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/EndpointTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/EndpointTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/FlapDamperTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/FlapDamperTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/HostMonitorObserverTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/HostMonitorObserverTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/HostMonitorTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/HostMonitorTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/HttpProbeTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/HttpProbeTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/IcmpTransportTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/IcmpTransportTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/LatencyHistogramTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/LatencyHistogramTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/MetricsTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/MetricsTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/MonitorEngineTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/MonitorEngineTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/MonitorSetTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/MonitorSetTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/NotifierTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/NotifierTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/PersistentTcpProbeTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/PersistentTcpProbeTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/PollerTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/PollerTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/RateLimiterTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/RateLimiterTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/ResolverTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/ResolverTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/ScheduleTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/ScheduleTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/SeqLockTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/SeqLockTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/StateJournalTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/StateJournalTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/TimerWheelTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/TimerWheelTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/UdpProbeTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/UdpProbeTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/VersionTest.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/VersionTest.cpp.o.d"
+  "CMakeFiles/host_monitor_test.dir/test/main.cpp.o"
+  "CMakeFiles/host_monitor_test.dir/test/main.cpp.o.d"
+  "host_monitor_test"
+  "host_monitor_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/host_monitor_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
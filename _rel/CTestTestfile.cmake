@@ -0,0 +1,272 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_rel
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(VersionTest.MajorNumber "/root/repo/_rel/host_monitor_test" "--gtest_filter=VersionTest.MajorNumber")
+set_tests_properties(VersionTest.MajorNumber PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(VersionTest.MinorNumber "/root/repo/_rel/host_monitor_test" "--gtest_filter=VersionTest.MinorNumber")
+set_tests_properties(VersionTest.MinorNumber PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(VersionTest.PatchNumber "/root/repo/_rel/host_monitor_test" "--gtest_filter=VersionTest.PatchNumber")
+set_tests_properties(VersionTest.PatchNumber PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(VersionTest.VersionNumber "/root/repo/_rel/host_monitor_test" "--gtest_filter=VersionTest.VersionNumber")
+set_tests_properties(VersionTest.VersionNumber PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(DependencyTest.SuppressesChildren "/root/repo/_rel/host_monitor_test" "--gtest_filter=DependencyTest.SuppressesChildren")
+set_tests_properties(DependencyTest.SuppressesChildren PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(DependencyTest.Transitive "/root/repo/_rel/host_monitor_test" "--gtest_filter=DependencyTest.Transitive")
+set_tests_properties(DependencyTest.Transitive PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(DependencyTest.RemovedParent "/root/repo/_rel/host_monitor_test" "--gtest_filter=DependencyTest.RemovedParent")
+set_tests_properties(DependencyTest.RemovedParent PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(DependencyTest.Cycles "/root/repo/_rel/host_monitor_test" "--gtest_filter=DependencyTest.Cycles")
+set_tests_properties(DependencyTest.Cycles PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(DependencyTest.SharedParentEndpoint "/root/repo/_rel/host_monitor_test" "--gtest_filter=DependencyTest.SharedParentEndpoint")
+set_tests_properties(DependencyTest.SharedParentEndpoint PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(DependencyTest.DampingAppliesAfterRecovery "/root/repo/_rel/host_monitor_test" "--gtest_filter=DependencyTest.DampingAppliesAfterRecovery")
+set_tests_properties(DependencyTest.DampingAppliesAfterRecovery PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(EndpointTest.Accessors "/root/repo/_rel/host_monitor_test" "--gtest_filter=EndpointTest.Accessors")
+set_tests_properties(EndpointTest.Accessors PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(EndpointTest.NamesAreInterned "/root/repo/_rel/host_monitor_test" "--gtest_filter=EndpointTest.NamesAreInterned")
+set_tests_properties(EndpointTest.NamesAreInterned PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(EndpointTest.InternedNamesOutliveTheirOrigin "/root/repo/_rel/host_monitor_test" "--gtest_filter=EndpointTest.InternedNamesOutliveTheirOrigin")
+set_tests_properties(EndpointTest.InternedNamesOutliveTheirOrigin PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(EndpointTest.EqualityAndHashing "/root/repo/_rel/host_monitor_test" "--gtest_filter=EndpointTest.EqualityAndHashing")
+set_tests_properties(EndpointTest.EqualityAndHashing PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(EndpointTest.PreResolvedAddress "/root/repo/_rel/host_monitor_test" "--gtest_filter=EndpointTest.PreResolvedAddress")
+set_tests_properties(EndpointTest.PreResolvedAddress PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.DefaultFollowsEachResult "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.DefaultFollowsEachResult")
+set_tests_properties(FlapDamperTest.DefaultFollowsEachResult PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.ConsecutiveThresholds "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.ConsecutiveThresholds")
+set_tests_properties(FlapDamperTest.ConsecutiveThresholds PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.SeededAvailability "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.SeededAvailability")
+set_tests_properties(FlapDamperTest.SeededAvailability PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.SlidingWindow "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.SlidingWindow")
+set_tests_properties(FlapDamperTest.SlidingWindow PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.ForcedAvailability "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.ForcedAvailability")
+set_tests_properties(FlapDamperTest.ForcedAvailability PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.FlappingIsSuppressed "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.FlappingIsSuppressed")
+set_tests_properties(FlapDamperTest.FlappingIsSuppressed PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.InvalidDamping "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.InvalidDamping")
+set_tests_properties(FlapDamperTest.InvalidDamping PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(FlapDamperTest.ObserversSeeDampedState "/root/repo/_rel/host_monitor_test" "--gtest_filter=FlapDamperTest.ObserversSeeDampedState")
+set_tests_properties(FlapDamperTest.ObserversSeeDampedState PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.ICMPv4ToGoogle "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.ICMPv4ToGoogle")
+set_tests_properties(HostMonitorTest.ICMPv4ToGoogle PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.ICMPv6ToGoogle "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.ICMPv6ToGoogle")
+set_tests_properties(HostMonitorTest.ICMPv6ToGoogle PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.TCPToGoogle "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.TCPToGoogle")
+set_tests_properties(HostMonitorTest.TCPToGoogle PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.ICMPv4ToLoopback "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.ICMPv4ToLoopback")
+set_tests_properties(HostMonitorTest.ICMPv4ToLoopback PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.ICMPv6ToLoopback "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.ICMPv6ToLoopback")
+set_tests_properties(HostMonitorTest.ICMPv6ToLoopback PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.TCPToLoopbackListener "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.TCPToLoopbackListener")
+set_tests_properties(HostMonitorTest.TCPToLoopbackListener PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.TCPToLoopbackClosedPort "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.TCPToLoopbackClosedPort")
+set_tests_properties(HostMonitorTest.TCPToLoopbackClosedPort PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.StateOfLoopbackListener "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.StateOfLoopbackListener")
+set_tests_properties(HostMonitorTest.StateOfLoopbackListener PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.StateOfLoopbackClosedPort "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.StateOfLoopbackClosedPort")
+set_tests_properties(HostMonitorTest.StateOfLoopbackClosedPort PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.SubSecondInterval "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.SubSecondInterval")
+set_tests_properties(HostMonitorTest.SubSecondInterval PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.TimeoutCountsAsFailure "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.TimeoutCountsAsFailure")
+set_tests_properties(HostMonitorTest.TimeoutCountsAsFailure PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.ICMPv4ToInvalid "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.ICMPv4ToInvalid")
+set_tests_properties(HostMonitorTest.ICMPv4ToInvalid PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.ICMPv6ToInvalid "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.ICMPv6ToInvalid")
+set_tests_properties(HostMonitorTest.ICMPv6ToInvalid PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorTest.TCPToInvalid "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorTest.TCPToInvalid")
+set_tests_properties(HostMonitorTest.TCPToInvalid PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.ICMPv4ToGoogle "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.ICMPv4ToGoogle")
+set_tests_properties(HostMonitorObserverTest.ICMPv4ToGoogle PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.ICMPv6ToGoogle "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.ICMPv6ToGoogle")
+set_tests_properties(HostMonitorObserverTest.ICMPv6ToGoogle PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.TCPToGoogle "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.TCPToGoogle")
+set_tests_properties(HostMonitorObserverTest.TCPToGoogle PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.TCPToLoopbackListener "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.TCPToLoopbackListener")
+set_tests_properties(HostMonitorObserverTest.TCPToLoopbackListener PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.TCPToLoopbackListenerNotified "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.TCPToLoopbackListenerNotified")
+set_tests_properties(HostMonitorObserverTest.TCPToLoopbackListenerNotified PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.ICMPv4ToInvalid "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.ICMPv4ToInvalid")
+set_tests_properties(HostMonitorObserverTest.ICMPv4ToInvalid PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.ICMPv6ToInvalid "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.ICMPv6ToInvalid")
+set_tests_properties(HostMonitorObserverTest.ICMPv6ToInvalid PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.TCPToInvalid "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.TCPToInvalid")
+set_tests_properties(HostMonitorObserverTest.TCPToInvalid PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HostMonitorObserverTest.ChangeObserversFromObserver "/root/repo/_rel/host_monitor_test" "--gtest_filter=HostMonitorObserverTest.ChangeObserversFromObserver")
+set_tests_properties(HostMonitorObserverTest.ChangeObserversFromObserver PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.ParseContentLength "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.ParseContentLength")
+set_tests_properties(HttpProbeTest.ParseContentLength PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.ParseChunked "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.ParseChunked")
+set_tests_properties(HttpProbeTest.ParseChunked PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.ParseConnectionHandling "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.ParseConnectionHandling")
+set_tests_properties(HttpProbeTest.ParseConnectionHandling PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.ParseInvalid "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.ParseInvalid")
+set_tests_properties(HttpProbeTest.ParseInvalid PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.StatusAndBody "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.StatusAndBody")
+set_tests_properties(HttpProbeTest.StatusAndBody PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.ClosedPort "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.ClosedPort")
+set_tests_properties(HttpProbeTest.ClosedPort PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.ConnectionIsKeptAlive "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.ConnectionIsKeptAlive")
+set_tests_properties(HttpProbeTest.ConnectionIsKeptAlive PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.StaleConnectionIsReplaced "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.StaleConnectionIsReplaced")
+set_tests_properties(HttpProbeTest.StaleConnectionIsReplaced PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(HttpProbeTest.MonitorKeepsConnectionAlive "/root/repo/_rel/host_monitor_test" "--gtest_filter=HttpProbeTest.MonitorKeepsConnectionAlive")
+set_tests_properties(HttpProbeTest.MonitorKeepsConnectionAlive PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(IcmpTransportTest.BatchToLoopbackV4 "/root/repo/_rel/host_monitor_test" "--gtest_filter=IcmpTransportTest.BatchToLoopbackV4")
+set_tests_properties(IcmpTransportTest.BatchToLoopbackV4 PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(IcmpTransportTest.BatchToLoopbackV6 "/root/repo/_rel/host_monitor_test" "--gtest_filter=IcmpTransportTest.BatchToLoopbackV6")
+set_tests_properties(IcmpTransportTest.BatchToLoopbackV6 PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(IcmpTransportTest.CancelledRequestsAreNotReported "/root/repo/_rel/host_monitor_test" "--gtest_filter=IcmpTransportTest.CancelledRequestsAreNotReported")
+set_tests_properties(IcmpTransportTest.CancelledRequestsAreNotReported PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(LatencyHistogramTest.Empty "/root/repo/_rel/host_monitor_test" "--gtest_filter=LatencyHistogramTest.Empty")
+set_tests_properties(LatencyHistogramTest.Empty PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(LatencyHistogramTest.SmallValuesAreExact "/root/repo/_rel/host_monitor_test" "--gtest_filter=LatencyHistogramTest.SmallValuesAreExact")
+set_tests_properties(LatencyHistogramTest.SmallValuesAreExact PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(LatencyHistogramTest.RelativeErrorIsBounded "/root/repo/_rel/host_monitor_test" "--gtest_filter=LatencyHistogramTest.RelativeErrorIsBounded")
+set_tests_properties(LatencyHistogramTest.RelativeErrorIsBounded PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(LatencyHistogramTest.Percentiles "/root/repo/_rel/host_monitor_test" "--gtest_filter=LatencyHistogramTest.Percentiles")
+set_tests_properties(LatencyHistogramTest.Percentiles PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(LatencyHistogramTest.Merge "/root/repo/_rel/host_monitor_test" "--gtest_filter=LatencyHistogramTest.Merge")
+set_tests_properties(LatencyHistogramTest.Merge PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(LatencyHistogramTest.ConcurrentRecording "/root/repo/_rel/host_monitor_test" "--gtest_filter=LatencyHistogramTest.ConcurrentRecording")
+set_tests_properties(LatencyHistogramTest.ConcurrentRecording PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MetricsTest.ReportsAreCounted "/root/repo/_rel/host_monitor_test" "--gtest_filter=MetricsTest.ReportsAreCounted")
+set_tests_properties(MetricsTest.ReportsAreCounted PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MetricsTest.CountsOfExitedThreadsAreKept "/root/repo/_rel/host_monitor_test" "--gtest_filter=MetricsTest.CountsOfExitedThreadsAreKept")
+set_tests_properties(MetricsTest.CountsOfExitedThreadsAreKept PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MetricsTest.Server "/root/repo/_rel/host_monitor_test" "--gtest_filter=MetricsTest.Server")
+set_tests_properties(MetricsTest.Server PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MetricsTest.ShutdownDoesntWaitForIdleClients "/root/repo/_rel/host_monitor_test" "--gtest_filter=MetricsTest.ShutdownDoesntWaitForIdleClients")
+set_tests_properties(MetricsTest.ShutdownDoesntWaitForIdleClients PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorEngineTest.Configuration "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorEngineTest.Configuration")
+set_tests_properties(MonitorEngineTest.Configuration PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorEngineTest.EventLoopManyMonitors "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorEngineTest.EventLoopManyMonitors")
+set_tests_properties(MonitorEngineTest.EventLoopManyMonitors PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorEngineTest.ThreadPerMonitorToLoopback "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorEngineTest.ThreadPerMonitorToLoopback")
+set_tests_properties(MonitorEngineTest.ThreadPerMonitorToLoopback PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorEngineTest.DestroyFromObserver "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorEngineTest.DestroyFromObserver")
+set_tests_properties(MonitorEngineTest.DestroyFromObserver PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorEngineTest.DestroyDuringProbe "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorEngineTest.DestroyDuringProbe")
+set_tests_properties(MonitorEngineTest.DestroyDuringProbe PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorEngineTest.DestroyWhileLoopIsBusy "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorEngineTest.DestroyWhileLoopIsBusy")
+set_tests_properties(MonitorEngineTest.DestroyWhileLoopIsBusy PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.Load "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.Load")
+set_tests_properties(MonitorSetTest.Load PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.ReloadTouchesChangedMonitorsOnly "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.ReloadTouchesChangedMonitorsOnly")
+set_tests_properties(MonitorSetTest.ReloadTouchesChangedMonitorsOnly PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.LastDuplicateWins "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.LastDuplicateWins")
+set_tests_properties(MonitorSetTest.LastDuplicateWins PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.InvalidListIsRejected "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.InvalidListIsRejected")
+set_tests_properties(MonitorSetTest.InvalidListIsRejected PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.LoadFile "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.LoadFile")
+set_tests_properties(MonitorSetTest.LoadFile PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.LoadFifo "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.LoadFifo")
+set_tests_properties(MonitorSetTest.LoadFifo PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.ObserversFollowTheSet "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.ObserversFollowTheSet")
+set_tests_properties(MonitorSetTest.ObserversFollowTheSet PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(MonitorSetTest.ErrorsNameTheParser "/root/repo/_rel/host_monitor_test" "--gtest_filter=MonitorSetTest.ErrorsNameTheParser")
+set_tests_properties(MonitorSetTest.ErrorsNameTheParser PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(NotifierTest.SlowObserverDoesNotDelayReporting "/root/repo/_rel/host_monitor_test" "--gtest_filter=NotifierTest.SlowObserverDoesNotDelayReporting")
+set_tests_properties(NotifierTest.SlowObserverDoesNotDelayReporting PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(NotifierTest.OverflowDropsNewest "/root/repo/_rel/host_monitor_test" "--gtest_filter=NotifierTest.OverflowDropsNewest")
+set_tests_properties(NotifierTest.OverflowDropsNewest PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(NotifierTest.OverflowDropsOldest "/root/repo/_rel/host_monitor_test" "--gtest_filter=NotifierTest.OverflowDropsOldest")
+set_tests_properties(NotifierTest.OverflowDropsOldest PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(NotifierTest.UnknownObserver "/root/repo/_rel/host_monitor_test" "--gtest_filter=NotifierTest.UnknownObserver")
+set_tests_properties(NotifierTest.UnknownObserver PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PersistentTcpProbeTest.ConnectionIsReused "/root/repo/_rel/host_monitor_test" "--gtest_filter=PersistentTcpProbeTest.ConnectionIsReused")
+set_tests_properties(PersistentTcpProbeTest.ConnectionIsReused PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PersistentTcpProbeTest.BannerIsDiscarded "/root/repo/_rel/host_monitor_test" "--gtest_filter=PersistentTcpProbeTest.BannerIsDiscarded")
+set_tests_properties(PersistentTcpProbeTest.BannerIsDiscarded PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PersistentTcpProbeTest.ClosedConnectionIsReplaced "/root/repo/_rel/host_monitor_test" "--gtest_filter=PersistentTcpProbeTest.ClosedConnectionIsReplaced")
+set_tests_properties(PersistentTcpProbeTest.ClosedConnectionIsReplaced PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PersistentTcpProbeTest.HangUpIsDetectedBeforeInterval "/root/repo/_rel/host_monitor_test" "--gtest_filter=PersistentTcpProbeTest.HangUpIsDetectedBeforeInterval")
+set_tests_properties(PersistentTcpProbeTest.HangUpIsDetectedBeforeInterval PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PollerTest.Fallback "/root/repo/_rel/host_monitor_test" "--gtest_filter=PollerTest.Fallback")
+set_tests_properties(PollerTest.Fallback PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PollerTest.LevelTriggered "/root/repo/_rel/host_monitor_test" "--gtest_filter=PollerTest.LevelTriggered")
+set_tests_properties(PollerTest.LevelTriggered PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PollerTest.ModifyAndRemove "/root/repo/_rel/host_monitor_test" "--gtest_filter=PollerTest.ModifyAndRemove")
+set_tests_properties(PollerTest.ModifyAndRemove PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PollerTest.Timeout "/root/repo/_rel/host_monitor_test" "--gtest_filter=PollerTest.Timeout")
+set_tests_properties(PollerTest.Timeout PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PollerTest.ManyDescriptors "/root/repo/_rel/host_monitor_test" "--gtest_filter=PollerTest.ManyDescriptors")
+set_tests_properties(PollerTest.ManyDescriptors PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PollerTest.SmallRing "/root/repo/_rel/host_monitor_test" "--gtest_filter=PollerTest.SmallRing")
+set_tests_properties(PollerTest.SmallRing PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(PollerTest.EngineToLoopback "/root/repo/_rel/host_monitor_test" "--gtest_filter=PollerTest.EngineToLoopback")
+set_tests_properties(PollerTest.EngineToLoopback PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(RateLimiterTest.Unlimited "/root/repo/_rel/host_monitor_test" "--gtest_filter=RateLimiterTest.Unlimited")
+set_tests_properties(RateLimiterTest.Unlimited PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(RateLimiterTest.BurstThenSpaced "/root/repo/_rel/host_monitor_test" "--gtest_filter=RateLimiterTest.BurstThenSpaced")
+set_tests_properties(RateLimiterTest.BurstThenSpaced PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(RateLimiterTest.ProtocolBudget "/root/repo/_rel/host_monitor_test" "--gtest_filter=RateLimiterTest.ProtocolBudget")
+set_tests_properties(RateLimiterTest.ProtocolBudget PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(RateLimiterTest.Priorities "/root/repo/_rel/host_monitor_test" "--gtest_filter=RateLimiterTest.Priorities")
+set_tests_properties(RateLimiterTest.Priorities PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(RateLimiterTest.InvalidLimits "/root/repo/_rel/host_monitor_test" "--gtest_filter=RateLimiterTest.InvalidLimits")
+set_tests_properties(RateLimiterTest.InvalidLimits PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(RateLimiterTest.EngineSpreadsTests "/root/repo/_rel/host_monitor_test" "--gtest_filter=RateLimiterTest.EngineSpreadsTests")
+set_tests_properties(RateLimiterTest.EngineSpreadsTests PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(RateLimiterTest.StartupSpread "/root/repo/_rel/host_monitor_test" "--gtest_filter=RateLimiterTest.StartupSpread")
+set_tests_properties(RateLimiterTest.StartupSpread PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.NumericCompletesImmediately "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.NumericCompletesImmediately")
+set_tests_properties(ResolverTest.NumericCompletesImmediately PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.PositiveResultIsCached "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.PositiveResultIsCached")
+set_tests_properties(ResolverTest.PositiveResultIsCached PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.NegativeResultIsCached "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.NegativeResultIsCached")
+set_tests_properties(ResolverTest.NegativeResultIsCached PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.ConcurrentLookupsAreCoalesced "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.ConcurrentLookupsAreCoalesced")
+set_tests_properties(ResolverTest.ConcurrentLookupsAreCoalesced PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.ExpiredResultIsQueriedAgain "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.ExpiredResultIsQueriedAgain")
+set_tests_properties(ResolverTest.ExpiredResultIsQueriedAgain PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.UnansweredQueryFails "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.UnansweredQueryFails")
+set_tests_properties(ResolverTest.UnansweredQueryFails PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.SearchDomainsAreApplied "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.SearchDomainsAreApplied")
+set_tests_properties(ResolverTest.SearchDomainsAreApplied PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ResolverTest.TruncatedResponseRetriesOverTcp "/root/repo/_rel/host_monitor_test" "--gtest_filter=ResolverTest.TruncatedResponseRetriesOverTcp")
+set_tests_properties(ResolverTest.TruncatedResponseRetriesOverTcp PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ScheduleTest.Fixed "/root/repo/_rel/host_monitor_test" "--gtest_filter=ScheduleTest.Fixed")
+set_tests_properties(ScheduleTest.Fixed PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ScheduleTest.FailuresAreRetriedQuickly "/root/repo/_rel/host_monitor_test" "--gtest_filter=ScheduleTest.FailuresAreRetriedQuickly")
+set_tests_properties(ScheduleTest.FailuresAreRetriedQuickly PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ScheduleTest.StableHostsBackOff "/root/repo/_rel/host_monitor_test" "--gtest_filter=ScheduleTest.StableHostsBackOff")
+set_tests_properties(ScheduleTest.StableHostsBackOff PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(ScheduleTest.Limits "/root/repo/_rel/host_monitor_test" "--gtest_filter=ScheduleTest.Limits")
+set_tests_properties(ScheduleTest.Limits PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(SeqLockTest.StoreAndLoad "/root/repo/_rel/host_monitor_test" "--gtest_filter=SeqLockTest.StoreAndLoad")
+set_tests_properties(SeqLockTest.StoreAndLoad PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(SeqLockTest.ConcurrentReadsAreNeverTorn "/root/repo/_rel/host_monitor_test" "--gtest_filter=SeqLockTest.ConcurrentReadsAreNeverTorn")
+set_tests_properties(SeqLockTest.ConcurrentReadsAreNeverTorn PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(StateJournalTest.WarmRestart "/root/repo/_rel/host_monitor_test" "--gtest_filter=StateJournalTest.WarmRestart")
+set_tests_properties(StateJournalTest.WarmRestart PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(StateJournalTest.ChangesAreRecorded "/root/repo/_rel/host_monitor_test" "--gtest_filter=StateJournalTest.ChangesAreRecorded")
+set_tests_properties(StateJournalTest.ChangesAreRecorded PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(StateJournalTest.SharedEndpointHasOneWriter "/root/repo/_rel/host_monitor_test" "--gtest_filter=StateJournalTest.SharedEndpointHasOneWriter")
+set_tests_properties(StateJournalTest.SharedEndpointHasOneWriter PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(StateJournalTest.TornRecord "/root/repo/_rel/host_monitor_test" "--gtest_filter=StateJournalTest.TornRecord")
+set_tests_properties(StateJournalTest.TornRecord PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(StateJournalTest.Capacity "/root/repo/_rel/host_monitor_test" "--gtest_filter=StateJournalTest.Capacity")
+set_tests_properties(StateJournalTest.Capacity PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(StateJournalTest.InvalidFiles "/root/repo/_rel/host_monitor_test" "--gtest_filter=StateJournalTest.InvalidFiles")
+set_tests_properties(StateJournalTest.InvalidFiles PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(TimerWheelTest.NeverFiresEarly "/root/repo/_rel/host_monitor_test" "--gtest_filter=TimerWheelTest.NeverFiresEarly")
+set_tests_properties(TimerWheelTest.NeverFiresEarly PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(TimerWheelTest.Cancel "/root/repo/_rel/host_monitor_test" "--gtest_filter=TimerWheelTest.Cancel")
+set_tests_properties(TimerWheelTest.Cancel PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(TimerWheelTest.CascadeFromHigherLevels "/root/repo/_rel/host_monitor_test" "--gtest_filter=TimerWheelTest.CascadeFromHigherLevels")
+set_tests_properties(TimerWheelTest.CascadeFromHigherLevels PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(TimerWheelTest.RescheduleFromCallback "/root/repo/_rel/host_monitor_test" "--gtest_filter=TimerWheelTest.RescheduleFromCallback")
+set_tests_properties(TimerWheelTest.RescheduleFromCallback PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(TimerWheelTest.NextTimeout "/root/repo/_rel/host_monitor_test" "--gtest_filter=TimerWheelTest.NextTimeout")
+set_tests_properties(TimerWheelTest.NextTimeout PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(UdpProbeTest.EchoResponds "/root/repo/_rel/host_monitor_test" "--gtest_filter=UdpProbeTest.EchoResponds")
+set_tests_properties(UdpProbeTest.EchoResponds PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(UdpProbeTest.ResponseIsMatched "/root/repo/_rel/host_monitor_test" "--gtest_filter=UdpProbeTest.ResponseIsMatched")
+set_tests_properties(UdpProbeTest.ResponseIsMatched PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(UdpProbeTest.PortUnreachableFailsFast "/root/repo/_rel/host_monitor_test" "--gtest_filter=UdpProbeTest.PortUnreachableFailsFast")
+set_tests_properties(UdpProbeTest.PortUnreachableFailsFast PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
+add_test(UdpProbeTest.SilenceTimesOut "/root/repo/_rel/host_monitor_test" "--gtest_filter=UdpProbeTest.SilenceTimesOut")
+set_tests_properties(UdpProbeTest.SilenceTimesOut PROPERTIES  _BACKTRACE_TRIPLES "/usr/share/cmake-3.25/Modules/GoogleTest.cmake;402;add_test;/root/repo/CMakeLists.txt;156;gtest_add_tests;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,77 @@
+/**
+ * @file      IcmpBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <poll.h>
+#include "IcmpProbe.hpp"
+#include "IcmpTransport.hpp"
+
+using host_monitor::IcmpProbe;
+using host_monitor::IcmpTransport;
+using host_monitor::wait_for;
+using host_monitor::resolve_address;
+using host_monitor::run_probe;
+
+// Native echo request over an ICMP socket.
+static void BM_IcmpNativeLoopback(benchmark::State& state)
+{
+    auto address = resolve_address("127.0.0.1", AF_INET).value();
+    for (auto _ : state)
+    {
+        auto probe = IcmpProbe(address);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        benchmark::DoNotOptimize(run_probe(probe, deadline));
+    }
+}
+BENCHMARK(BM_IcmpNativeLoopback);
+
+// Batches of echo requests over one shared socket, replies matched by (identifier, sequence).
+static void BM_IcmpBatchedLoopback(benchmark::State& state)
+{
+    auto address = resolve_address("127.0.0.1", AF_INET).value();
+    auto transport = IcmpTransport(AF_INET);
+    auto batch = static_cast<std::size_t>(state.range(0));
+    auto replied = std::vector<std::uint64_t>();
+    auto failed = std::vector<std::uint64_t>();
+
+    for (auto _ : state)
+    {
+        for (auto token = std::size_t(0); token < batch; ++token)
+        {
+            transport.submit(address, token);
+        }
+        transport.flush(failed);
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (transport.get_pending_count() != 0 && wait_for(transport.get_fd(), POLLIN, deadline))
+        {
+            transport.receive(replied);
+        }
+        replied.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IcmpBatchedLoopback)->RangeMultiplier(8)->Range(1, 4096);
+
+// Previous implementation: fork a shell running ping for each probe.
+static void BM_IcmpSystemLoopback(benchmark::State& state)
+{
+    auto cmd = std::string("ping -c 1 127.0.0.1 > /dev/null 2>&1");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::system(cmd.c_str()));
+    }
+}
+BENCHMARK(BM_IcmpSystemLoopback);
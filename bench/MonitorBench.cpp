@@ -0,0 +1,166 @@
+/**
+ * @file      MonitorBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "HostMonitorImpl.hpp"
+#include "MonitorEngine.hpp"
+#include "Notifier.hpp"
+#include "../test/LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::HostMonitorObserver;
+using host_monitor::MonitorEngine;
+using host_monitor::Notifier;
+using namespace std::chrono;
+
+namespace
+{
+struct CountingObserver : public HostMonitorObserver
+{
+    void state_change(Data const&) override
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> calls = 0;
+};
+
+// Resident set size of the process in bytes
+double get_rss()
+{
+    auto pages = 0L;
+    auto resident = 0L;
+    auto statm = std::ifstream("/proc/self/statm");
+    statm >> pages >> resident;
+    return static_cast<double>(resident) * static_cast<double>(::sysconf(_SC_PAGESIZE));
+}
+
+// CPU time (user and system) consumed by the process so far
+duration<double> get_cpu_time()
+{
+    auto usage = rusage();
+    ::getrusage(RUSAGE_SELF, &usage);
+    auto to_duration = [] (timeval const& tv)
+    {
+        return seconds(tv.tv_sec) + microseconds(tv.tv_usec);
+    };
+    return to_duration(usage.ru_utime) + to_duration(usage.ru_stime);
+}
+} // anon namespace
+
+// Register and unregister a monitor. Its first test hits a closed loopback port.
+static void BM_MonitorConstructDestroy(benchmark::State& state)
+{
+    auto engine = MonitorEngine(1);
+    auto closed = LoopbackSocket();
+    auto endpoint = Endpoint::make_tcp_endpoint("127.0.0.1", closed.port);
+    for (auto _ : state)
+    {
+        auto monitor = HostMonitor(endpoint, hours(1), engine);
+        benchmark::DoNotOptimize(monitor);
+    }
+}
+BENCHMARK(BM_MonitorConstructDestroy);
+
+// Report a state change to a growing number of synchronous observers.
+static void BM_ObserverFanOut(benchmark::State& state)
+{
+    auto monitor = std::make_shared<HostMonitor::Impl>( Endpoint::make_icmpv4_endpoint("127.0.0.1")
+                                                      , HostMonitor::Schedule::fixed(seconds(1)));
+    auto observer = std::make_shared<CountingObserver>();
+    for (auto i = 0; i < state.range(0); ++i)
+    {
+        monitor->add_observer(observer);
+    }
+
+    auto available = false;
+    for (auto _ : state)
+    {
+        available = !available;
+        monitor->report(available, microseconds(100));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(observer->calls.load()));
+}
+BENCHMARK(BM_ObserverFanOut)->RangeMultiplier(4)->Range(1, 1024);
+
+// Report a state change to a growing number of observers informed by a Notifier.
+static void BM_ObserverFanOutNotifier(benchmark::State& state)
+{
+    auto monitor = std::make_shared<HostMonitor::Impl>( Endpoint::make_icmpv4_endpoint("127.0.0.1")
+                                                      , HostMonitor::Schedule::fixed(seconds(1)));
+    auto notifier = std::make_unique<Notifier::Impl>(4096, Notifier::OverflowPolicy::BLOCK);
+    auto observer = std::make_shared<CountingObserver>();
+    for (auto i = 0; i < state.range(0); ++i)
+    {
+        monitor->add_observer(observer, notifier.get());
+    }
+
+    auto available = false;
+    for (auto _ : state)
+    {
+        available = !available;
+        monitor->report(available, microseconds(100));
+    }
+
+    // Include delivery of all queued notifications
+    notifier.reset();
+    state.SetItemsProcessed(static_cast<std::int64_t>(observer->calls.load()));
+}
+BENCHMARK(BM_ObserverFanOutNotifier)->RangeMultiplier(4)->Range(1, 256);
+
+// Memory and CPU use of many monitors testing loopback every 2 seconds.
+static void BM_MonitorScale(benchmark::State& state)
+{
+    auto const interval = seconds(2);
+    auto count = static_cast<std::size_t>(state.range(0));
+    auto endpoint = Endpoint::make_icmpv4_endpoint("127.0.0.1");
+
+    for (auto _ : state)
+    {
+        auto engine = MonitorEngine(2);
+        auto rss = get_rss();
+        auto setup = steady_clock::now();
+
+        auto monitors = std::vector<std::unique_ptr<HostMonitor>>();
+        monitors.reserve(count);
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            monitors.push_back(std::make_unique<HostMonitor>(endpoint, interval, engine));
+        }
+        auto setup_time = duration<double>(steady_clock::now() - setup);
+
+        // Skip the burst of initial tests, then measure one steady interval
+        std::this_thread::sleep_for(interval);
+        auto cpu = get_cpu_time();
+        auto wall = steady_clock::now();
+        std::this_thread::sleep_for(interval);
+        auto cpu_time = get_cpu_time() - cpu;
+        auto wall_time = duration<double>(steady_clock::now() - wall);
+
+        auto monitors_n = static_cast<double>(count);
+        auto tests = monitors_n * wall_time.count() / duration<double>(interval).count();
+        state.counters["rss_per_monitor"] = (get_rss() - rss) / monitors_n;
+        state.counters["cpu_usage"] = cpu_time.count() / wall_time.count();
+        state.counters["cpu_per_test_us"] = cpu_time.count() * 1e6 / tests;
+        state.counters["setup_per_monitor_us"] = setup_time.count() * 1e6 / monitors_n;
+    }
+}
+BENCHMARK(BM_MonitorScale)->Arg(1000)->Arg(10000)->Arg(100000)->Iterations(1)->Unit(benchmark::kMillisecond);
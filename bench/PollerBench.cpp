@@ -0,0 +1,153 @@
+/**
+ * @file      PollerBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "Poller.hpp"
+#include "Socket.hpp"
+#include "../test/LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using host_monitor::PollEvent;
+using host_monitor::Poller;
+using host_monitor::Socket;
+using namespace std::chrono;
+
+namespace
+{
+// CPU time (user and system) consumed by the process so far
+duration<double> get_cpu_time()
+{
+    auto usage = rusage();
+    ::getrusage(RUSAGE_SELF, &usage);
+    auto to_duration = [] (timeval const& tv)
+    {
+        return seconds(tv.tv_sec) + microseconds(tv.tv_usec);
+    };
+    return to_duration(usage.ru_utime) + to_duration(usage.ru_stime);
+}
+
+// Accepts and closes connections until destroyed
+struct AcceptDrain
+{
+    AcceptDrain()
+        : listener()
+        , stop(false)
+        , thread()
+    {
+        listener.listen(SOMAXCONN);
+        thread = std::thread([this] ()
+        {
+            auto pfd = pollfd{listener.fd, POLLIN, 0};
+            while (!stop)
+            {
+                if (::poll(&pfd, 1, 10) > 0)
+                {
+                    auto peer = Socket(::accept(listener.fd, nullptr, nullptr));
+                }
+            }
+        });
+    }
+
+    ~AcceptDrain()
+    {
+        stop = true;
+        thread.join();
+    }
+
+    LoopbackSocket    listener;
+    std::atomic<bool> stop;
+    std::thread       thread;
+};
+} // anon namespace
+
+// Register a batch of ready file descriptors, collect their events and unregister them.
+// Models the registration churn of short probes.
+static void BM_PollerChurn(benchmark::State& state)
+{
+    auto poller = Poller::create(static_cast<MonitorEngine::Backend>(state.range(0)));
+    auto count = static_cast<std::size_t>(state.range(1));
+    auto fds = std::vector<Socket>();
+    for (auto i = std::size_t(0); i < count; ++i)
+    {
+        fds.emplace_back(::eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC));
+    }
+
+    auto events = std::array<PollEvent, 256>();
+    for (auto _ : state)
+    {
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            poller->add(fds[i].get(), EPOLLIN, i);
+        }
+
+        auto seen = std::size_t(0);
+        while (seen < count)
+        {
+            seen += poller->wait(events.data(), events.size(), 100);
+        }
+
+        for (auto const& fd : fds)
+        {
+            poller->remove(fd.get());
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * state.range(1)));
+    state.SetLabel(poller->get_backend() == MonitorEngine::Backend::IO_URING ? "io_uring" : "epoll");
+}
+BENCHMARK(BM_PollerChurn)->ArgsProduct({{0, 1}, {16, 256}});
+
+// CPU per test of TCP monitors probing a loopback listener every second.
+static void BM_PollerEngineTcp(benchmark::State& state)
+{
+    auto const interval = seconds(1);
+    auto backend = static_cast<MonitorEngine::Backend>(state.range(0));
+    auto count = static_cast<std::size_t>(state.range(1));
+    auto drain = AcceptDrain();
+    auto endpoint = Endpoint::make_tcp_endpoint("127.0.0.1", drain.listener.port);
+
+    for (auto _ : state)
+    {
+        auto engine = MonitorEngine(1, backend);
+        auto monitors = std::vector<std::unique_ptr<HostMonitor>>();
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            monitors.push_back(std::make_unique<HostMonitor>(endpoint, interval, engine));
+        }
+
+        // Skip the burst of initial tests, then measure steady intervals
+        std::this_thread::sleep_for(interval);
+        auto cpu = get_cpu_time();
+        auto wall = steady_clock::now();
+        std::this_thread::sleep_for(2 * interval);
+        auto cpu_time = get_cpu_time() - cpu;
+        auto wall_time = duration<double>(steady_clock::now() - wall);
+
+        auto tests = static_cast<double>(count) * wall_time.count() / duration<double>(interval).count();
+        state.counters["cpu_per_test_us"] = cpu_time.count() * 1e6 / tests;
+        state.SetLabel(engine.get_backend() == MonitorEngine::Backend::IO_URING ? "io_uring" : "epoll");
+    }
+}
+BENCHMARK(BM_PollerEngineTcp)->ArgsProduct({{0, 1}, {100, 1000}})->Iterations(1)->Unit(benchmark::kMillisecond);
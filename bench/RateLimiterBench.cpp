@@ -0,0 +1,40 @@
+/**
+ * @file      RateLimiterBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include "RateLimiter.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using host_monitor::RateLimiter;
+
+// Reserve the start of a connection test, the cost added to each test.
+// Arg 0 leaves the limiter unlimited, Arg 1 limits all tests and TCP tests.
+static void BM_RateLimiterReserve(benchmark::State& state)
+{
+    static auto limiter = RateLimiter();
+    if (state.thread_index() == 0)
+    {
+        auto limit = (state.range(0) != 0) ? MonitorEngine::RateLimit{1e6, 100} : MonitorEngine::RateLimit();
+        limiter.set_limit(limit);
+        limiter.set_limit(Endpoint::Protocol::TCP, limit);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(limiter.reserve( Endpoint::Protocol::TCP, HostMonitor::Priority::NORMAL
+                                                , RateLimiter::Clock::now()));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+BENCHMARK(BM_RateLimiterReserve)->Arg(0)->Arg(1)->Threads(1)->Threads(4);
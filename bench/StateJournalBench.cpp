@@ -0,0 +1,92 @@
+/**
+ * @file      StateJournalBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+#include "StateJournalImpl.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::StateJournal;
+using namespace std::chrono;
+
+namespace
+{
+std::string journal_path()
+{
+    return "/tmp/host_monitor_bench_journal_" + std::to_string(::getpid());
+}
+
+std::vector<Endpoint> make_endpoints(std::size_t count)
+{
+    auto endpoints = std::vector<Endpoint>();
+    endpoints.reserve(count);
+    for (auto i = std::size_t(0); i < count; ++i)
+    {
+        endpoints.push_back(Endpoint::make_tcp_endpoint("host" + std::to_string(i) + ".example.org", "443"));
+    }
+    return endpoints;
+}
+} // anon namespace
+
+// Record the result of a connection test, the cost added to each test.
+static void BM_JournalStore(benchmark::State& state)
+{
+    auto path = journal_path();
+    ::unlink(path.c_str());
+    auto journal = std::make_unique<StateJournal::Impl>(path, 1024);
+    auto* record = journal->acquire(Endpoint::make_icmpv4_endpoint("127.0.0.1"));
+
+    auto entry = StateJournal::Entry();
+    for (auto _ : state)
+    {
+        entry.available = !entry.available;
+        entry.last_probe = system_clock::now();
+        StateJournal::Impl::store(*record, entry, !entry.available, true);
+    }
+
+    journal.reset();
+    ::unlink(path.c_str());
+}
+BENCHMARK(BM_JournalStore);
+
+// Reopen a journal and seed all of its endpoints, as on a restart.
+static void BM_JournalRestart(benchmark::State& state)
+{
+    auto path = journal_path();
+    ::unlink(path.c_str());
+    auto endpoints = make_endpoints(static_cast<std::size_t>(state.range(0)));
+    {
+        auto journal = StateJournal::Impl(path, endpoints.size() * 2);
+        auto entry = StateJournal::Entry();
+        entry.available = true;
+        for (auto const& ep : endpoints)
+        {
+            StateJournal::Impl::store(*journal.acquire(ep), entry, false, true);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        auto journal = StateJournal::Impl(path, 0);
+        for (auto const& ep : endpoints)
+        {
+            benchmark::DoNotOptimize(StateJournal::Impl::load(*journal.acquire(ep)));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * state.range(0)));
+    ::unlink(path.c_str());
+}
+BENCHMARK(BM_JournalRestart)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
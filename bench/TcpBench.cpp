@@ -0,0 +1,69 @@
+/**
+ * @file      TcpBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <cstdlib>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "TcpProbe.hpp"
+
+using host_monitor::Address;
+using host_monitor::Socket;
+using host_monitor::TcpProbe;
+using host_monitor::resolve_address;
+using host_monitor::run_probe;
+
+namespace
+{
+// Listening socket on 127.0.0.1, bound to an ephemeral port.
+Socket make_listener(Address& address)
+{
+    address = resolve_address("127.0.0.1", AF_INET).value();
+    auto sock = Socket(::socket(AF_INET, SOCK_STREAM, 0));
+    ::bind(sock.get(), address.get(), address.length);
+    ::listen(sock.get(), SOMAXCONN);
+    ::getsockname(sock.get(), reinterpret_cast<sockaddr*>(&address.storage), &address.length);
+    return sock;
+}
+} // anon namespace
+
+// Native non-blocking connect against a loopback listener.
+static void BM_TcpNativeLoopback(benchmark::State& state)
+{
+    auto address = Address();
+    auto listener = make_listener(address);
+    for (auto _ : state)
+    {
+        auto probe = TcpProbe(address);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        benchmark::DoNotOptimize(run_probe(probe, deadline));
+
+        // Drain the accept queue, the listener would run full otherwise
+        auto peer = Socket(::accept(listener.get(), nullptr, nullptr));
+    }
+}
+BENCHMARK(BM_TcpNativeLoopback);
+
+// Previous implementation: fork a shell running nc for each probe.
+static void BM_TcpSystemLoopback(benchmark::State& state)
+{
+    auto address = Address();
+    auto listener = make_listener(address);
+    auto port = ntohs(reinterpret_cast<sockaddr_in const*>(address.get())->sin_port);
+    auto cmd = "nc -z 127.0.0.1 " + std::to_string(port) + " > /dev/null 2>&1";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::system(cmd.c_str()));
+    }
+}
+BENCHMARK(BM_TcpSystemLoopback);
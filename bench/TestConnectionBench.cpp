@@ -0,0 +1,70 @@
+/**
+ * @file      TestConnectionBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include "Socket.hpp"
+#include "TestConnection.hpp"
+#include "../test/LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::Socket;
+using host_monitor::test_connection;
+
+// Blocking connection test of an ICMPv4 endpoint, including name resolution.
+static void BM_TestConnectionIcmpv4(benchmark::State& state)
+{
+    auto endpoint = Endpoint::make_icmpv4_endpoint("127.0.0.1");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(test_connection(endpoint));
+    }
+}
+BENCHMARK(BM_TestConnectionIcmpv4);
+
+// Blocking connection test of an ICMPv6 endpoint, including name resolution.
+static void BM_TestConnectionIcmpv6(benchmark::State& state)
+{
+    auto endpoint = Endpoint::make_icmpv6_endpoint("::1");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(test_connection(endpoint));
+    }
+}
+BENCHMARK(BM_TestConnectionIcmpv6);
+
+// Blocking connection test of a TCP endpoint accepting connections.
+static void BM_TestConnectionTcpListening(benchmark::State& state)
+{
+    auto listener = LoopbackSocket();
+    listener.listen(SOMAXCONN);
+    auto endpoint = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(test_connection(endpoint));
+
+        // Drain the accept queue, the listener would run full otherwise
+        auto peer = Socket(::accept(listener.fd, nullptr, nullptr));
+    }
+}
+BENCHMARK(BM_TestConnectionTcpListening);
+
+// Blocking connection test of a TCP endpoint refusing connections.
+static void BM_TestConnectionTcpRefused(benchmark::State& state)
+{
+    auto closed = LoopbackSocket();
+    auto endpoint = Endpoint::make_tcp_endpoint("127.0.0.1", closed.port);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(test_connection(endpoint));
+    }
+}
+BENCHMARK(BM_TestConnectionTcpRefused);
@@ -0,0 +1,168 @@
+/**
+ * @file      TimerWheelBench.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <sys/epoll.h>
+#include "Socket.hpp"
+#include "TimerWheel.hpp"
+
+using host_monitor::Socket;
+using host_monitor::TimerWheel;
+using namespace std::chrono;
+
+namespace
+{
+// Nodes with periods of 1s - 60s, the typical range of probe intervals.
+struct PeriodicNodes
+{
+    PeriodicNodes(TimerWheel& wheel, TimerWheel::Clock::time_point start, std::size_t count)
+        : wheel(wheel)
+        , nodes(count)
+        , periods(count)
+        , due(count)
+    {
+        auto rng = std::minstd_rand(42);
+        auto dist = std::uniform_int_distribution<int>(1000, 60000);
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            nodes[i].id = i;
+            periods[i] = milliseconds(dist(rng));
+            due[i] = start + periods[i];
+            wheel.schedule(nodes[i], due[i]);
+        }
+    }
+
+    ~PeriodicNodes()
+    {
+        for (auto& node : nodes)
+        {
+            wheel.cancel(node);
+        }
+    }
+
+    // Re-arm anchored to the previous due time, as the event loop does.
+    void rearm(TimerWheel::Node& node)
+    {
+        due[node.id] += periods[node.id];
+        wheel.schedule(node, due[node.id]);
+    }
+
+    TimerWheel&                                 wheel;
+    std::vector<TimerWheel::Node>               nodes;
+    std::vector<milliseconds>                   periods;
+    std::vector<TimerWheel::Clock::time_point>  due;
+};
+} // anon namespace
+
+// Insert and cancel of a single deadline with N other deadlines pending.
+static void BM_TimerWheelScheduleCancel(benchmark::State& state)
+{
+    auto start = TimerWheel::Clock::time_point();
+    auto wheel = TimerWheel(start);
+    auto others = PeriodicNodes(wheel, start, static_cast<std::size_t>(state.range(0)));
+    auto node = TimerWheel::Node();
+    auto offset = 0u;
+
+    for (auto _ : state)
+    {
+        offset = (offset + 7919u) % 60000u;
+        wheel.schedule(node, start + milliseconds(offset));
+        wheel.cancel(node);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheelScheduleCancel)->RangeMultiplier(10)->Range(1000, 1000000);
+
+// Expiry and re-arm throughput of N periodic deadlines, advancing 10ms per iteration.
+static void BM_TimerWheelExpire(benchmark::State& state)
+{
+    auto start = TimerWheel::Clock::time_point();
+    auto wheel = TimerWheel(start);
+    auto periodic = PeriodicNodes(wheel, start, static_cast<std::size_t>(state.range(0)));
+    auto now = start;
+    auto fired = std::int64_t(0);
+
+    for (auto _ : state)
+    {
+        now += milliseconds(10);
+        wheel.advance(now, [&] (TimerWheel::Node& node)
+        {
+            fired += 1;
+            periodic.rearm(node);
+        });
+    }
+    state.SetItemsProcessed(fired);
+}
+BENCHMARK(BM_TimerWheelExpire)->RangeMultiplier(10)->Range(1000, 1000000);
+
+// Lateness of N periodic 10ms deadlines, driven like the event loop: epoll_wait
+// on the wheels timeout, then advance to the current time.
+static void BM_TimerWheelDrift(benchmark::State& state)
+{
+    auto epoll = Socket(::epoll_create1(EPOLL_CLOEXEC));
+    auto event = epoll_event();
+    auto count = static_cast<std::size_t>(state.range(0));
+
+    auto samples = std::int64_t(0);
+    auto total = microseconds(0);
+    auto worst = microseconds(0);
+    auto drift = microseconds(0);
+
+    for (auto _ : state)
+    {
+        auto start = TimerWheel::Clock::now();
+        auto wheel = TimerWheel(start);
+        auto nodes = std::vector<TimerWheel::Node>(count);
+        auto due = std::vector<TimerWheel::Clock::time_point>(count);
+        auto fired = std::vector<unsigned>(count);
+
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            nodes[i].id = i;
+            due[i] = start + milliseconds(10);
+            wheel.schedule(nodes[i], due[i]);
+        }
+
+        // Run 50 periods
+        while (wheel.size() != 0)
+        {
+            ::epoll_wait(epoll.get(), &event, 1, wheel.next_timeout(TimerWheel::Clock::now()));
+
+            auto now = TimerWheel::Clock::now();
+            wheel.advance(now, [&] (TimerWheel::Node& node)
+            {
+                auto late = duration_cast<microseconds>(now - due[node.id]);
+                total += late;
+                worst = std::max(worst, late);
+                samples += 1;
+
+                if (++fired[node.id] < 50u)
+                {
+                    due[node.id] += milliseconds(10);
+                    wheel.schedule(node, due[node.id]);
+                }
+            });
+        }
+
+        // Anchored periods: the last expiry should lag by no more than one period's lateness
+        auto ideal = start + milliseconds(10) * 50;
+        drift = std::max(drift, duration_cast<microseconds>(TimerWheel::Clock::now() - ideal));
+    }
+
+    state.counters["mean_lateness_us"] = static_cast<double>(total.count()) / static_cast<double>(std::max<std::int64_t>(samples, 1));
+    state.counters["max_lateness_us"] = static_cast<double>(worst.count());
+    state.counters["drift_us"] = static_cast<double>(drift.count());
+}
+BENCHMARK(BM_TimerWheelDrift)->Arg(1000)->Arg(10000)->Iterations(1)->Unit(benchmark::kMillisecond);
@@ -1,5 +1,5 @@
 /**
- * @file      Version.hpp
+ * @file      Endpoint.hpp
  * @author    Simon Brummer <simon.brummer@posteo.de>
  * @copyright 2017 Simon Brummer. All rights reserved.
  */
@@ -14,36 +14,52 @@
 #define ENDPOINT_HPP_201706130847
 
 #include <string>
+#include <string_view>
 #include <optional>
+#include <memory>
+#include <cstddef>
 #include <cstdint>
 
+#include <sys/socket.h>
+
 namespace host_monitor
 {
-/// @brief Endpoint structure used to hold connection parameters.
+/**
+ * @brief Endpoint structure used to hold connection parameters.
+ * @note  Host names are interned: Endpoints of the same host share a single,
+ *        process wide copy of its name, released with the last Endpoint of
+ *        the host. Constructing an Endpoint of a known host doesn't allocate memory.
+ */
 class Endpoint
 {
 public:
     /// @brief Protocol type used to reach an Endpoint.
     enum class Protocol
     {
-        ICMPV4 = 0, ///< Use ICMP Packets to reach Endpoint via IPv4.
-        ICMPV6,     ///< Use ICMP Packets to reach Endpoint via IPv6.
-        TCP,        ///< Use TCP Packets to reach Endpoint.
+        ICMPV4 = 0,     ///< Use ICMP Packets to reach Endpoint via IPv4.
+        ICMPV6,         ///< Use ICMP Packets to reach Endpoint via IPv6.
+        TCP,            ///< Use TCP Packets to reach Endpoint.
+        UDP,            ///< Use UDP Datagrams to reach Endpoint. The endpoint must respond.
+        HTTP,           ///< Use HTTP/1.1 GET requests to reach Endpoint. Connections are kept alive.
+        TCP_PERSISTENT, ///< Keep a TCP connection to the Endpoint open, watch its state.
     };
 
+    /// @brief Number of protocols. Protocols are numbered consecutively, new ones are appended.
+    static constexpr std::size_t PROTOCOL_COUNT = static_cast<std::size_t>(Protocol::TCP_PERSISTENT) + 1;
+
     /**
      * @brief Build icmpv4 endpoint.
      * @param[in] fqhn   The target that should be monitored. Either FQDN or IPv4-Address.
      * @returns Configured Endpoint.
      */
-    static Endpoint make_icmpv4_endpoint(std::string fqhn);
+    static Endpoint make_icmpv4_endpoint(std::string_view fqhn);
 
     /**
      * @brief Build icmpv6 endpoint.
      * @param[in] fqhn   The target that should be monitored. Either FQDN or IPv6-Address.
      * @returns Configured Endpoint.
      */
-    static Endpoint make_icmpv6_endpoint(std::string fqhn);
+    static Endpoint make_icmpv6_endpoint(std::string_view fqhn);
 
     /**
      * @brief Function to generate an TCP Endpoint.
@@ -52,25 +68,92 @@ public:
      * @param[in] port   Port number to connect to.
      * @returns Configured Endpoint.
      */
-    static Endpoint make_tcp_endpoint(std::string fqhn, std::string port);
+    static Endpoint make_tcp_endpoint(std::string_view fqhn, std::string_view port);
+
+    /**
+     * @brief Function to generate a persistent TCP Endpoint.
+     * @note  A single connection is kept open and checked via TCP_INFO and kernel
+     *        keepalives instead of connecting on each test. Loss of the connection
+     *        is detected as it happens and triggers a reconnect.
+     * @throws std::runtime_error in case @p port is invalid.
+     * @param[in] fqhn   The target that should be monitored. Either FQDN or IP-Address.
+     * @param[in] port   Port number to connect to.
+     * @returns Configured Endpoint.
+     */
+    static Endpoint make_tcp_persistent_endpoint(std::string_view fqhn, std::string_view port);
+
+    /**
+     * @brief Function to generate an UDP Endpoint.
+     * @note  The endpoint is reachable if it answers @p payload with a datagram starting
+     *        with @p expected. ICMP port unreachable messages fail the test immediately.
+     * @throws std::runtime_error in case @p port is invalid.
+     * @param[in] fqhn       The target that should be monitored. Either FQDN or IP-Address.
+     * @param[in] port       Port number to send to.
+     * @param[in] payload    Datagram sent to the endpoint.
+     * @param[in] expected   Prefix the response must start with, matched within its first
+     *                       2048 bytes. None accepts any response.
+     * @returns Configured Endpoint.
+     */
+    static Endpoint make_udp_endpoint( std::string_view           fqhn
+                                     , std::string_view           port
+                                     , std::string                payload = std::string()
+                                     , std::optional<std::string> expected = std::nullopt);
+
+    /**
+     * @brief Function to generate an HTTP Endpoint.
+     * @note  The endpoint is reachable if it answers a GET request of @p path with
+     *        @p status and, if given, a body containing @p body.
+     * @throws std::runtime_error in case @p port, @p path or @p status is invalid.
+     * @param[in] fqhn     The target that should be monitored. Either FQDN or IP-Address.
+     * @param[in] port     Port number to connect to.
+     * @param[in] path     Absolute request path, e.g. "/health". Must not contain whitespace.
+     * @param[in] status   Expected status code in [100, 599].
+     * @param[in] body     Text the response body must contain. None accepts any body.
+     * @returns Configured Endpoint.
+     */
+    static Endpoint make_http_endpoint( std::string_view           fqhn
+                                      , std::string_view           port
+                                      , std::string                path = "/"
+                                      , std::uint16_t              status = 200
+                                      , std::optional<std::string> body = std::nullopt);
 
     /**
      * @brief Get endpoints target.
-     * @returns string in the form "<fqhn>:<port>".
+     * @returns string in the form "<fqhn>:<port>", followed by the path for HTTP endpoints.
      */
     std::string get_target() const;
 
     /**
      * @brief Get endpoints fqhn.
-     * @returns fqhn of the endpoint.
+     * @returns fqhn of the endpoint. Valid as long as this Endpoint (or another Endpoint
+     *          of the same host) exists.
      */
-    std::string get_fqhn() const;
+    std::string_view get_fqhn() const;
 
     /**
      * @brief Get endpoints port.
      * @returns port if endpoint in case it exists.
      */
-    std::optional<std::string> get_port() const;
+    std::optional<std::uint16_t> get_port() const;
+
+    /**
+     * @brief Get datagram sent to UDP endpoints, respectively request path of HTTP endpoints.
+     * @returns payload of the request. Empty for other protocols.
+     */
+    std::string_view get_payload() const;
+
+    /**
+     * @brief Get prefix responses of UDP endpoints must start with, respectively
+     *        text response bodies of HTTP endpoints must contain.
+     * @returns expected response, if any.
+     */
+    std::optional<std::string_view> get_expected_response() const;
+
+    /**
+     * @brief Get status code responses of HTTP endpoints must carry.
+     * @returns expected status code. None for other protocols.
+     */
+    std::optional<std::uint16_t> get_expected_status() const;
 
     /**
      * @brief Get Protocol of Endpoint.
@@ -78,14 +161,52 @@ public:
      */
     Endpoint::Protocol get_protocol() const;
 
+    /**
+     * @brief Build endpoint with a pre-resolved address. Probes of the returned
+     *        Endpoint use @p address instead of resolving the fqhn.
+     * @param[in] address   Address of the target. The port is ignored.
+     * @returns Copy of this endpoint, holding @p address.
+     */
+    Endpoint with_address(sockaddr_storage const& address) const;
+
+    /**
+     * @brief Get pre-resolved address.
+     * @returns address set by with_address(). nullptr if there is none.
+     */
+    sockaddr_storage const* get_address() const;
+
+    /**
+     * @brief Compare endpoints. The pre-resolved address is not taken into account.
+     * @param[in] other   Endpoint to compare with.
+     * @returns true if protocol, fqhn, port and the UDP or HTTP request are equal.
+     */
+    bool operator == (Endpoint const& other) const;
+
+    /**
+     * @brief Compare endpoints. The pre-resolved address is not taken into account.
+     * @param[in] other   Endpoint to compare with.
+     * @returns true if protocol, fqhn, port or the UDP or HTTP request differ.
+     */
+    bool operator != (Endpoint const& other) const;
+
+    /**
+     * @brief Hash endpoint, consistent with operator ==.
+     * @returns hash value of the endpoint.
+     */
+    std::size_t hash() const;
+
 private:
-    Endpoint( Endpoint::Protocol         protocol
-            , std::string                fqhn
-            , std::optional<std::string> port);
+    struct Request;
+
+    Endpoint( Endpoint::Protocol protocol
+            , std::string_view   fqhn
+            , std::uint16_t      port);
 
-    Endpoint::Protocol         protocol_;
-    std::string                fqhn_;
-    std::optional<std::string> port_;
+    std::shared_ptr<std::string const>      fqhn_;     // Interned host name, shared by Endpoints of the host
+    std::shared_ptr<sockaddr_storage const> address_;  // Pre-resolved address, shared by copies
+    std::shared_ptr<Request const>          request_;  // Request of UDP and HTTP endpoints, shared by copies
+    std::uint16_t                           port_;     // Port in host byte order, 0 without port
+    Endpoint::Protocol                      protocol_;
 };
 
 /**
@@ -101,7 +222,21 @@ std::string protocol_to_string(Endpoint::Protocol p);
  * @returns @p as protocol. In case the given string can't be converted to a
  *          protocol, the optional is none.
  */
-std::optional<Endpoint::Protocol> string_to_protocol(std::string const& s);
+std::optional<Endpoint::Protocol> string_to_protocol(std::string_view s);
 
 } // namespace host_monitor
+
+namespace std
+{
+/// @brief Hash support for Endpoints, e.g. for use in std::unordered_map.
+template <>
+struct hash<host_monitor::Endpoint>
+{
+    std::size_t operator () (host_monitor::Endpoint const& endpoint) const
+    {
+        return endpoint.hash();
+    }
+};
+} // namespace std
+
 #endif // ENDPOINT_HPP_201706130847
@@ -22,6 +22,9 @@
 
 #include "Endpoint.hpp"
 #include "HostMonitorObserver.hpp"
+#include "LatencyHistogram.hpp"
+#include "MonitorEngine.hpp"
+#include "Notifier.hpp"
 
 namespace host_monitor
 {
@@ -33,12 +36,133 @@ namespace host_monitor
 class HostMonitor
 {
 public:
+    /// @brief Snapshot of the monitors state.
+    struct State
+    {
+        bool                                  available = false;        ///< Result of the last connection test.
+        std::uint32_t                         consecutive_failures = 0; ///< Failed tests since the last successful one.
+        std::chrono::system_clock::time_point last_probe;               ///< End of the last test. Epoch if none finished yet.
+        std::chrono::system_clock::time_point last_change;              ///< Last change of availability. Epoch if none yet.
+        std::chrono::nanoseconds              rtt = std::chrono::nanoseconds(0); ///< Duration of the last successful test.
+        bool                                  suppressed = false;       ///< State changes are suppressed due to flapping.
+        bool                                  unreachable = false;      ///< Unavailable because the endpoint it depends on is down. Not tested meanwhile.
+    };
+
+    /**
+     * @brief Hysteresis applied to test results before the availability changes.
+     * @note  The monitor goes down after 'failures' failed tests and comes up after
+     *        'successes' successful tests, either in a row or within the last
+     *        'window' tests. Optionally, each state change adds 'penalty' to an
+     *        exponentially decaying flap penalty (like BGP route dampening). Above
+     *        'suppress_limit', state changes are withheld until the penalty decayed
+     *        below 'reuse_limit'. The default values change state on each test.
+     */
+    struct Damping
+    {
+        std::uint32_t             failures = 1;       ///< Failed tests before going down.
+        std::uint32_t             successes = 1;      ///< Successful tests before coming up.
+        std::uint32_t             window = 0;         ///< Count within the last 'window' tests (at most 64). 0 counts in a row.
+        double                    penalty = 0.0;      ///< Penalty added per state change. 0 disables suppression.
+        double                    suppress_limit = 0.0; ///< Penalty above that state changes are suppressed.
+        double                    reuse_limit = 0.0;  ///< Penalty below that suppression ends.
+        std::chrono::milliseconds half_life = std::chrono::milliseconds(0); ///< Half-life of the penalty.
+    };
+
+    /// @brief Priority of a monitors connection tests under a probe rate limit.
+    enum class Priority
+    {
+        HIGH = 0, ///< Never delayed. Tests still count against the rate limit.
+        NORMAL,   ///< Delayed once the budget is exhausted.
+        LOW,      ///< Delayed once half of the burst is used.
+    };
+
+    /**
+     * @brief Timing of connection tests.
+     * @note  After a failed test, up to 'retries' tests follow after 'retry_interval'
+     *        to confirm the failure quickly. After every 'stable_tests' successful
+     *        tests in a row, the interval is stretched by 'backoff'. A failure
+     *        restores 'interval'. All intervals are clamped to [min_interval, max_interval].
+     */
+    struct Schedule
+    {
+        std::chrono::milliseconds interval;       ///< Base duration between connection tests.
+        std::chrono::milliseconds min_interval;   ///< Floor of all intervals.
+        std::chrono::milliseconds max_interval;   ///< Ceiling of all intervals.
+        std::chrono::milliseconds retry_interval; ///< Duration after a failed test.
+        std::uint32_t             retries;        ///< Number of fast retries after a failure.
+        std::uint32_t             stable_tests;   ///< Successful tests before stretching the interval. 0 disables it.
+        double                    backoff;        ///< Factor the interval is stretched by.
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(1000); ///< Deadline of a connection test. A timeout counts as failure.
+        Priority                  priority = Priority::NORMAL; ///< Priority under the rate limit of the MonitorEngine.
+
+        /**
+         * @brief Build a schedule testing at a fixed interval.
+         * @param[in] interval   The duration between performed connection tests.
+         * @returns Configured Schedule.
+         */
+        static Schedule fixed(std::chrono::milliseconds interval);
+
+        /**
+         * @brief Build an adaptive schedule. Failures are retried after a quarter of
+         *        @p interval twice, stable hosts are tested up to 8 times less often.
+         * @param[in] interval   The base duration between performed connection tests.
+         * @returns Configured Schedule.
+         */
+        static Schedule adaptive(std::chrono::milliseconds interval);
+    };
+
+    /**
+     * @brief Constructor. The monitor is registered on the default MonitorEngine.
+     * @throws std::runtime_error in case @p interval is not positive.
+     * @param[in] endpoint   The target that should be monitored.
+     * @param[in] interval   The duration between performed connection tests.
+     */
+    HostMonitor(Endpoint endpoint, std::chrono::milliseconds interval);
+
     /**
      * @brief Constructor.
+     * @throws std::runtime_error in case @p interval is not positive.
      * @param[in] endpoint   The target that should be monitored.
      * @param[in] interval   The duration between performed connection tests.
+     * @param[in] engine     The engine executing the connection tests. Must outlive the monitor.
+     */
+    HostMonitor(Endpoint endpoint, std::chrono::milliseconds interval, MonitorEngine& engine);
+
+    /**
+     * @brief Constructor. The monitor is registered on the default MonitorEngine.
+     * @throws std::runtime_error in case @p schedule is invalid.
+     * @param[in] endpoint   The target that should be monitored.
+     * @param[in] schedule   The timing of connection tests.
+     */
+    HostMonitor(Endpoint endpoint, Schedule schedule);
+
+    /**
+     * @brief Constructor.
+     * @throws std::runtime_error in case @p schedule is invalid.
+     * @param[in] endpoint   The target that should be monitored.
+     * @param[in] schedule   The timing of connection tests.
+     * @param[in] engine     The engine executing the connection tests. Must outlive the monitor.
+     */
+    HostMonitor(Endpoint endpoint, Schedule schedule, MonitorEngine& engine);
+
+    /**
+     * @brief Constructor. The monitor is registered on the default MonitorEngine.
+     * @throws std::runtime_error in case @p schedule or @p damping is invalid.
+     * @param[in] endpoint   The target that should be monitored.
+     * @param[in] schedule   The timing of connection tests.
+     * @param[in] damping    Hysteresis applied before the availability changes.
+     */
+    HostMonitor(Endpoint endpoint, Schedule schedule, Damping damping);
+
+    /**
+     * @brief Constructor.
+     * @throws std::runtime_error in case @p schedule or @p damping is invalid.
+     * @param[in] endpoint   The target that should be monitored.
+     * @param[in] schedule   The timing of connection tests.
+     * @param[in] damping    Hysteresis applied before the availability changes.
+     * @param[in] engine     The engine executing the connection tests. Must outlive the monitor.
      */
-    HostMonitor(Endpoint endpoint, std::chrono::seconds interval);
+    HostMonitor(Endpoint endpoint, Schedule schedule, Damping damping, MonitorEngine& engine);
 
     ~HostMonitor();
 
@@ -46,12 +170,25 @@ public:
      * @brief Add an Observer to the monitor.
      * @note @p observer must derive from the Interface 'HostMonitorObserver'.
      *       The update-method is called on each registered observer in case of a state change.
+     *       May be called from within HostMonitorObserver::state_change().
      * @param[in] observer   The observer that should be added.
      */
     void add_observer(std::shared_ptr<HostMonitorObserver> observer);
 
     /**
-     * @brief Remove an Observer from the monitor.
+     * @brief Add an Observer to the monitor, informed asynchronously.
+     * @note  State changes are delivered on the thread of @p notifier. Slow observers
+     *        don't delay connection tests. State changes queued before del_observer()
+     *        might still be delivered.
+     * @param[in] observer   The observer that should be added.
+     * @param[in] notifier   The notifier delivering state changes. Must outlive the monitor.
+     */
+    void add_observer(std::shared_ptr<HostMonitorObserver> observer, Notifier& notifier);
+
+    /**
+     * @brief Remove an Observer from the monitor, regardless of how it was added.
+     * @note  May be called from within HostMonitorObserver::state_change(). A state
+     *        change reported concurrently might still reach the observer.
      * @param[in] observer   The observer that should be removed.
      */
     void del_observer(std::shared_ptr<HostMonitorObserver> observer);
@@ -63,6 +200,20 @@ public:
      */
     bool is_available() const;
 
+    /**
+     * @brief Get a consistent snapshot of the monitors state.
+     * @note  Lock-free, readers never contend with each other or the monitor.
+     * @returns the state after the last connection test.
+     */
+    State get_state() const;
+
+    /**
+     * @brief Get round-trip times of all successful connection tests.
+     * @note  Histograms of several monitors can be aggregated with LatencyHistogram::merge().
+     * @returns Snapshot of the monitors latency histogram.
+     */
+    LatencyHistogram get_latency() const;
+
     /**
      * @brief Get monitored endpoint.
      * @returns Copy of the monitored endpoint.
@@ -71,9 +222,15 @@ public:
 
     /**
      * @brief Get test interval of the monitor.
-     * @returns Copy of the test interval.
+     * @returns Base interval of the monitors schedule.
      */
-    std::chrono::seconds const& get_interval() const;
+    std::chrono::milliseconds const& get_interval() const;
+
+    /**
+     * @brief Get test schedule of the monitor.
+     * @returns Schedule of the monitor.
+     */
+    Schedule const& get_schedule() const;
 
     /* Disable copying and moving */
     HostMonitor(HostMonitor const& other) = delete;
@@ -81,9 +238,11 @@ public:
     HostMonitor& operator = (HostMonitor const& other) = delete;
     HostMonitor&& operator = (HostMonitor&& other) = delete;
 
-private:
     class Impl;
-    std::unique_ptr<Impl> pimpl_;
+
+private:
+    std::shared_ptr<Impl> pimpl_;
+    MonitorEngine&        engine_;
 };
 
 } // namespace host_monitor
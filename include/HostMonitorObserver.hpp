@@ -33,9 +33,10 @@ public:
     /// @brief Contains all information of the registered monitor
     struct Data
     {
-        Endpoint const&             endpoint;  ///< Endpoint of the Host monitor this Observer is registered on.
-        std::chrono::seconds const& interval;  ///< Test interval of the Host monitor this Observer is registered on.
-        bool const                  available; ///< Availability of the monitored endpoint.
+        Endpoint const&                  endpoint;            ///< Endpoint of the Host monitor this Observer is registered on.
+        std::chrono::milliseconds const& interval;            ///< Base test interval of the Host monitor this Observer is registered on.
+        bool const                       available;           ///< Availability of the monitored endpoint.
+        bool const                       unreachable = false; ///< Unavailable because the endpoint it depends on is down.
     };
 
     virtual ~HostMonitorObserver() = default;
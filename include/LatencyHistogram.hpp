@@ -0,0 +1,94 @@
+/**
+ * @file      LatencyHistogram.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef LATENCYHISTOGRAM_HPP_202610161730
+#define LATENCYHISTOGRAM_HPP_202610161730
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace host_monitor
+{
+
+/**
+ * @brief Fixed size, log-linear histogram of round-trip times.
+ * @note  Values are recorded in microseconds. Each power of two range is split
+ *        into 16 linear buckets, bounding the relative error to 1/16. Values
+ *        above ~16.7s are counted in the highest bucket. Recording is wait-free
+ *        and may happen concurrently to queries on other threads.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    /**
+     * @brief Copy constructor. Copies a snapshot of the bucket counts.
+     * @param[in] other   Histogram to copy.
+     */
+    LatencyHistogram(LatencyHistogram const& other);
+
+    /**
+     * @brief Copy assignment. Copies a snapshot of the bucket counts.
+     * @param[in] other   Histogram to copy.
+     * @returns this histogram.
+     */
+    LatencyHistogram& operator = (LatencyHistogram const& other);
+
+    /**
+     * @brief Record a round-trip time. Wait-free.
+     * @param[in] rtt   Round-trip time to record. Negative values count as zero.
+     */
+    void record(std::chrono::nanoseconds rtt);
+
+    /**
+     * @brief Add the counts of another histogram, e.g. to aggregate several monitors.
+     * @param[in] other   Histogram to add.
+     */
+    void merge(LatencyHistogram const& other);
+
+    /// @brief Drop all recorded values.
+    void reset();
+
+    /**
+     * @brief Get number of recorded values.
+     * @returns number of recorded values.
+     */
+    std::uint64_t get_count() const;
+
+    /**
+     * @brief Get value at a percentile, e.g. 50.0, 99.0 or 99.9.
+     * @param[in] percentile   Percentile in [0, 100].
+     * @returns the highest value equivalent to the recorded value at @p percentile.
+     *          Zero if the histogram is empty.
+     */
+    std::chrono::microseconds get_percentile(double percentile) const;
+
+private:
+    static constexpr std::size_t SUB_BUCKET_BITS = 4;
+    static constexpr std::size_t SUB_BUCKETS = std::size_t(1) << SUB_BUCKET_BITS;
+    static constexpr std::size_t MAX_VALUE_BITS = 24;
+    static constexpr std::size_t BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static std::size_t to_index(std::uint64_t value);
+
+    static std::uint64_t highest_value(std::size_t index);
+
+    std::array<std::atomic<std::uint64_t>, BUCKETS> counts_; // Number of values per bucket
+};
+
+} // namespace host_monitor
+
+#endif // LATENCYHISTOGRAM_HPP_202610161730
@@ -0,0 +1,69 @@
+/**
+ * @file      Metrics.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef METRICS_HPP_202610162100
+#define METRICS_HPP_202610162100
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace host_monitor
+{
+
+/**
+ * @brief Render internal metrics in Prometheus text format.
+ * @note  Covers connection tests, failures, rate limited and suppressed tests by
+ *        protocol, test durations, state changes, scheduler lag and observer
+ *        callback durations of all monitors in the process.
+ * @param[in,out] out   String the metrics are appended to.
+ */
+void render_metrics(std::string& out);
+
+/**
+ * @brief Minimal HTTP listener serving render_metrics() on "GET /metrics".
+ * @note  Requests are served one at a time on a thread of its own.
+ */
+class MetricsServer
+{
+public:
+    /**
+     * @brief Constructor. Starts listening.
+     * @throws std::runtime_error in case the listener can't be set up.
+     * @param[in] address   Numeric IPv4 or IPv6 address to listen on.
+     * @param[in] port      Port to listen on. 0 picks an ephemeral port.
+     */
+    MetricsServer(std::string const& address, std::uint16_t port);
+
+    /// @brief Destructor. Stops listening.
+    ~MetricsServer();
+
+    /**
+     * @brief Get port the server listens on.
+     * @returns port in host byte order.
+     */
+    std::uint16_t get_port() const;
+
+    /* Disable copying and moving */
+    MetricsServer(MetricsServer const& other) = delete;
+    MetricsServer(MetricsServer&& other) = delete;
+    MetricsServer& operator = (MetricsServer const& other) = delete;
+    MetricsServer&& operator = (MetricsServer&& other) = delete;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace host_monitor
+
+#endif // METRICS_HPP_202610162100
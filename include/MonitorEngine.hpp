@@ -0,0 +1,181 @@
+/**
+ * @file      MonitorEngine.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef MONITORENGINE_HPP_202610161150
+#define MONITORENGINE_HPP_202610161150
+
+#include <chrono>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "Endpoint.hpp"
+
+namespace host_monitor
+{
+
+class StateJournal;
+
+/**
+ * @brief Executes the connection tests of all HostMonitors registered on it.
+ * @note  The engine must outlive all HostMonitors registered on it.
+ */
+class MonitorEngine
+{
+public:
+    /// @brief Execution model of the engine.
+    enum class Mode
+    {
+        EVENT_LOOP = 0,     ///< Multiplex all monitors over a fixed set of event-loop threads.
+        THREAD_PER_MONITOR, ///< Compatibility mode: each monitor runs its tests on a dedicated thread.
+    };
+
+    /// @brief I/O backend of the event-loop threads.
+    enum class Backend
+    {
+        EPOLL = 0, ///< Readiness notification via epoll(7).
+        IO_URING,  ///< Poll requests batched over io_uring(7). Falls back to EPOLL if the kernel lacks support.
+    };
+
+    /**
+     * @brief Token bucket limiting the start of connection tests.
+     * @note  Up to 'burst' tests start at once, further ones are spread at 'probes_per_second'.
+     *        Delayed tests start late, the schedule of their monitor doesn't drift.
+     */
+    struct RateLimit
+    {
+        double        probes_per_second = 0.0; ///< Sustained rate of test starts. 0 is unlimited.
+        std::uint32_t burst = 1;               ///< Tests that may start at once. Must be at least one.
+    };
+
+    /**
+     * @brief Constructor. Creates an engine in EVENT_LOOP mode.
+     * @param[in] threads   Number of event-loop threads. Must be at least one.
+     */
+    explicit MonitorEngine(std::size_t threads);
+
+    /**
+     * @brief Constructor.
+     * @param[in] mode      Execution model of the engine.
+     * @param[in] threads   Number of event-loop threads. Ignored in THREAD_PER_MONITOR mode.
+     */
+    MonitorEngine(Mode mode, std::size_t threads);
+
+    /**
+     * @brief Constructor. Creates an engine in EVENT_LOOP mode.
+     * @param[in] threads   Number of event-loop threads. Must be at least one.
+     * @param[in] backend   I/O backend of the event-loop threads.
+     */
+    MonitorEngine(std::size_t threads, Backend backend);
+
+    ~MonitorEngine();
+
+    /**
+     * @brief Get engine used by HostMonitors constructed without an explicit engine.
+     * @note  The default engine runs in EVENT_LOOP mode and lives until the process exits.
+     * @returns Process wide default engine.
+     */
+    static MonitorEngine& get_default();
+
+    /**
+     * @brief Keep the state of monitors in a journal across restarts.
+     * @note  Monitors registered afterwards start with the state recorded for their endpoint,
+     *        observers are only informed if a test changes it. Each test updates the record.
+     *        Endpoints exceeding the journals capacity are monitored without journal.
+     * @param[in] journal   The journal to use. Must outlive all HostMonitors registered on the engine.
+     */
+    void attach_journal(StateJournal& journal);
+
+    /**
+     * @brief Limit the rate of connection tests of all monitors registered on the engine.
+     * @note  Monitors are tested in order of their schedule, tests above the rate are delayed
+     *        as a whole: probe load stays flat instead of spiking when many monitors are due.
+     *        Monitors with Priority::HIGH are never delayed but use up the budget of others.
+     * @throws std::runtime_error in case @p limit is invalid.
+     * @param[in] limit   Limit of all tests. Unlimited by default.
+     */
+    void set_rate_limit(RateLimit limit);
+
+    /**
+     * @brief Limit the rate of connection tests of one protocol.
+     * @note  Applies in addition to the limit of all tests. A test starts once both allow it.
+     * @throws std::runtime_error in case @p limit is invalid.
+     * @param[in] protocol   Protocol the limit applies to.
+     * @param[in] limit      Limit of tests using @p protocol. Unlimited by default.
+     */
+    void set_rate_limit(Endpoint::Protocol protocol, RateLimit limit);
+
+    /**
+     * @brief Spread the first connection tests of monitors registered afterwards.
+     * @note  Each monitor starts at a random offset within @p spread, at most within its
+     *        interval. By default the first test starts immediately.
+     * @throws std::runtime_error in case @p spread is negative.
+     * @param[in] spread   Duration the first tests are spread over. 0 disables spreading.
+     */
+    void set_startup_spread(std::chrono::milliseconds spread);
+
+    /**
+     * @brief Declare that @p child is only reachable via @p parent, like a host behind its gateway.
+     * @note  While the monitor of @p parent reports it down, monitors of @p child are not tested.
+     *        Their observers are informed once about the child becoming unreachable instead of
+     *        about individual failures. The children are rechecked at their base interval and
+     *        tested again once the parent is available. Dependencies are transitive and may be
+     *        declared before or after the monitors of the endpoints are registered. A child has
+     *        one parent, declaring another one replaces it.
+     * @throws std::runtime_error in case the dependency would form a cycle.
+     * @param[in] parent   Endpoint @p child depends on.
+     * @param[in] child    Endpoint depending on @p parent.
+     */
+    void add_dependency(Endpoint const& parent, Endpoint const& child);
+
+    /**
+     * @brief Remove the dependency of an endpoint on its parent.
+     * @param[in] child   Endpoint depending on a parent. Endpoints without parent are ignored.
+     */
+    void del_dependency(Endpoint const& child);
+
+    /**
+     * @brief Get execution model of the engine.
+     * @returns mode of the engine.
+     */
+    Mode get_mode() const;
+
+    /**
+     * @brief Get I/O backend of the event-loop threads.
+     * @returns backend in use, EPOLL if IO_URING was requested but is unsupported.
+     *          EPOLL in THREAD_PER_MONITOR mode.
+     */
+    Backend get_backend() const;
+
+    /**
+     * @brief Get number of event-loop threads.
+     * @returns number of event-loop threads. 0 in THREAD_PER_MONITOR mode.
+     */
+    std::size_t get_thread_count() const;
+
+    /* Disable copying and moving */
+    MonitorEngine(MonitorEngine const& other) = delete;
+    MonitorEngine(MonitorEngine&& other) = delete;
+    MonitorEngine& operator = (MonitorEngine const& other) = delete;
+    MonitorEngine&& operator = (MonitorEngine&& other) = delete;
+
+    class Impl;
+
+private:
+    friend class HostMonitor;
+    friend class MonitorSet;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace host_monitor
+
+#endif // MONITORENGINE_HPP_202610161150
@@ -0,0 +1,133 @@
+/**
+ * @file      MonitorSet.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef MONITORSET_HPP_202610162000
+#define MONITORSET_HPP_202610162000
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+#include "Endpoint.hpp"
+#include "HostMonitor.hpp"
+#include "HostMonitorObserver.hpp"
+#include "MonitorEngine.hpp"
+#include "Notifier.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Set of HostMonitors maintained from an endpoint list.
+ * @note  The list contains one endpoint per line: "PROTOCOL host [port] interval".
+ *        PROTOCOL is ICMPV4, ICMPV6, TCP, TCP_PERSISTENT, UDP or HTTP, a port is given
+ *        for all but ICMP. The interval is a number with an optional unit: ms (default),
+ *        s or m. UDP lines may end with a hex encoded payload and expected response
+ *        prefix, HTTP lines with a request path, expected status and body text.
+ *        Empty lines and text following '#' are ignored. If an endpoint is listed
+ *        more than once, the last line wins.
+ *
+ *        On each load, the list is diffed against the running monitors: only new
+ *        endpoints and endpoints with a changed interval are (re)started, endpoints
+ *        missing in the list are stopped. Unchanged monitors are not touched.
+ *        Calls to a MonitorSet must be serialized by the caller.
+ */
+class MonitorSet
+{
+public:
+    /// @brief Monitors affected by a load.
+    struct Changes
+    {
+        std::size_t started = 0;   ///< Monitors started, including those with a changed interval.
+        std::size_t stopped = 0;   ///< Monitors stopped, including those with a changed interval.
+        std::size_t unchanged = 0; ///< Monitors kept running.
+    };
+
+    /// @brief Constructor. Monitors are registered on the default MonitorEngine.
+    MonitorSet();
+
+    /**
+     * @brief Constructor.
+     * @param[in] engine   The engine executing the connection tests. Must outlive the set.
+     */
+    explicit MonitorSet(MonitorEngine& engine);
+
+    /// @brief Destructor. Stops all monitors.
+    ~MonitorSet();
+
+    /**
+     * @brief Load an endpoint list from a file.
+     * @throws std::runtime_error in case the file can't be read or contains an
+     *         invalid line. Running monitors are left untouched in this case.
+     * @param[in] path   Path of the file.
+     * @returns monitors affected by the load.
+     */
+    Changes load_file(std::string const& path);
+
+    /**
+     * @brief Load an endpoint list.
+     * @throws std::runtime_error in case @p list contains an invalid line.
+     *         Running monitors are left untouched in this case.
+     * @param[in] list   The endpoint list.
+     * @returns monitors affected by the load.
+     */
+    Changes load(std::string_view list);
+
+    /**
+     * @brief Add an Observer to all current and future monitors of the set.
+     * @param[in] observer   The observer that should be added.
+     */
+    void add_observer(std::shared_ptr<HostMonitorObserver> observer);
+
+    /**
+     * @brief Add an Observer to all current and future monitors of the set,
+     *        informed asynchronously by @p notifier.
+     * @param[in] observer   The observer that should be added.
+     * @param[in] notifier   Notifier delivering state changes. Must outlive the set.
+     */
+    void add_observer(std::shared_ptr<HostMonitorObserver> observer, Notifier& notifier);
+
+    /**
+     * @brief Remove an Observer from all monitors of the set.
+     * @param[in] observer   The observer that should be removed.
+     */
+    void del_observer(std::shared_ptr<HostMonitorObserver> observer);
+
+    /**
+     * @brief Get monitor of an endpoint.
+     * @param[in] endpoint   The endpoint to look up.
+     * @returns monitor of @p endpoint. nullptr if it is not part of the set.
+     *          Valid until the next load.
+     */
+    HostMonitor const* find(Endpoint const& endpoint) const;
+
+    /**
+     * @brief Get number of monitors in the set.
+     * @returns number of running monitors.
+     */
+    std::size_t size() const;
+
+    /* Disable copying and moving */
+    MonitorSet(MonitorSet const& other) = delete;
+    MonitorSet(MonitorSet&& other) = delete;
+    MonitorSet& operator = (MonitorSet const& other) = delete;
+    MonitorSet&& operator = (MonitorSet&& other) = delete;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace host_monitor
+
+#endif // MONITORSET_HPP_202610162000
@@ -0,0 +1,84 @@
+/**
+ * @file      Notifier.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef NOTIFIER_HPP_202610161800
+#define NOTIFIER_HPP_202610161800
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "HostMonitorObserver.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Delivers state changes to observers on a thread of its own.
+ * @note  State changes are queued in a bounded lock-free queue, slow observers
+ *        don't delay connection tests. Notifications are delivered in order.
+ *        The notifier must outlive all HostMonitors using it.
+ */
+class Notifier
+{
+public:
+    /// @brief Handling of state changes that don't fit into the queue.
+    enum class OverflowPolicy
+    {
+        DROP_NEWEST = 0, ///< Discard the new state change.
+        DROP_OLDEST,     ///< Discard the oldest queued state change.
+        BLOCK,           ///< Wait for space. Delays connection tests of the reporting monitor.
+                         ///< Observers must not destroy HostMonitors then: the destruction can
+                         ///< wait for the very thread blocked on the full queue.
+    };
+
+    /// @brief Delivery statistics of a single observer.
+    struct Statistics
+    {
+        std::size_t   queued = 0;    ///< State changes waiting for delivery.
+        std::uint64_t delivered = 0; ///< State changes delivered.
+        std::uint64_t dropped = 0;   ///< State changes discarded on overflow.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] capacity   Number of state changes the queue can hold. Rounded up to a power of two.
+     * @param[in] policy     Handling of state changes on a full queue.
+     */
+    Notifier(std::size_t capacity, OverflowPolicy policy);
+
+    /// @brief Destructor. Delivers all queued state changes before returning.
+    ~Notifier();
+
+    /**
+     * @brief Get delivery statistics of an observer, summed over all monitors it is registered on.
+     * @param[in] observer   The observer to get statistics of.
+     * @returns statistics of @p observer. All zero if it was never registered.
+     */
+    Statistics get_statistics(std::shared_ptr<HostMonitorObserver> const& observer) const;
+
+    /* Disable copying and moving */
+    Notifier(Notifier const& other) = delete;
+    Notifier(Notifier&& other) = delete;
+    Notifier& operator = (Notifier const& other) = delete;
+    Notifier&& operator = (Notifier&& other) = delete;
+
+    class Impl;
+
+private:
+    friend class HostMonitor;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace host_monitor
+
+#endif // NOTIFIER_HPP_202610161800
@@ -0,0 +1,103 @@
+/**
+ * @file      StateJournal.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef STATEJOURNAL_HPP_202610171400
+#define STATEJOURNAL_HPP_202610171400
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include "Endpoint.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Memory-mapped file keeping the last known state of each endpoint across restarts.
+ * @note  The journal is a fixed-size hash table of 64 byte records, keyed by endpoint.
+ *        Monitors registered on a MonitorEngine the journal is attached to start with the
+ *        recorded availability instead of "unavailable", restarts don't cause a storm of
+ *        state changes. Each connection test updates its record in place: a few stores
+ *        into shared memory, no system call and no fsync. The kernel writes the pages back,
+ *        the journal survives crashes of the process. Records torn by a crash of the system
+ *        are detected and ignored. The journal must outlive all monitors using it.
+ */
+class StateJournal
+{
+public:
+    /// @brief Recorded state of an endpoint.
+    struct Entry
+    {
+        bool                                  available = false;        ///< Availability after the last test.
+        std::uint32_t                         consecutive_failures = 0; ///< Failed tests since the last successful one.
+        std::chrono::system_clock::time_point last_probe;               ///< End of the last test.
+        std::chrono::system_clock::time_point last_change;              ///< Last change of availability. Epoch if none yet.
+        std::uint64_t                         probes = 0;               ///< Tests performed, over all runs.
+        std::uint64_t                         failures = 0;             ///< Failed tests, over all runs.
+        std::uint64_t                         changes = 0;              ///< Changes of availability, over all runs.
+    };
+
+    /**
+     * @brief Constructor. Opens the journal at @p path, creates it if it doesn't exist.
+     * @throws std::runtime_error in case the file can't be opened or mapped, isn't a
+     *         journal or is in use by another StateJournal.
+     * @param[in] path       Path of the journal file.
+     * @param[in] capacity   Number of endpoints a new journal can hold. Rounded up to a power
+     *                       of two. Existing journals keep their capacity.
+     */
+    explicit StateJournal(std::string const& path, std::size_t capacity = 131072);
+
+    /// @brief Destructor. Unmaps the journal without waiting for write-back.
+    ~StateJournal();
+
+    /**
+     * @brief Get recorded state of an endpoint.
+     * @param[in] endpoint   The endpoint to look up.
+     * @returns state of @p endpoint. None if it was never tested or its record is torn.
+     */
+    std::optional<Entry> find(Endpoint const& endpoint) const;
+
+    /**
+     * @brief Get number of endpoints the journal can hold.
+     * @returns capacity of the journal.
+     */
+    std::size_t get_capacity() const;
+
+    /**
+     * @brief Get number of endpoints in the journal.
+     * @returns number of used records.
+     */
+    std::size_t get_size() const;
+
+    /// @brief Write the journal back to disk and wait for completion. Not needed to survive process crashes.
+    void flush();
+
+    /* Disable copying and moving */
+    StateJournal(StateJournal const& other) = delete;
+    StateJournal(StateJournal&& other) = delete;
+    StateJournal& operator = (StateJournal const& other) = delete;
+    StateJournal&& operator = (StateJournal&& other) = delete;
+
+    class Impl;
+
+private:
+    friend class MonitorEngine;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace host_monitor
+
+#endif // STATEJOURNAL_HPP_202610171400
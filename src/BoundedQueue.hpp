@@ -0,0 +1,161 @@
+/**
+ * @file      BoundedQueue.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef BOUNDEDQUEUE_HPP_202610161800
+#define BOUNDEDQUEUE_HPP_202610161800
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace host_monitor
+{
+
+/**
+ * @brief Bounded, lock-free multi-producer queue.
+ * @note  Each cell carries a sequence number telling producers and consumers
+ *        whose turn it is (D. Vyukov's bounded queue). Producers may pop as
+ *        well, e.g. to drop the oldest element on overflow.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] capacity   Number of elements the queue can hold. Rounded up to a power of two.
+     */
+    explicit BoundedQueue(std::size_t capacity)
+        : cells_()
+        , mask_(0)
+        , push_pos_(0)
+        , pop_pos_(0)
+    {
+        auto size = std::size_t(2);
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+
+        cells_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (auto i = std::size_t(0); i < size; ++i)
+        {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Append an element.
+     * @param[in] value   The element to append. Left untouched if the queue is full.
+     * @returns true if @p value was appended, false if the queue is full.
+     */
+    bool try_push(T& value)
+    {
+        auto pos = push_pos_.load(std::memory_order_relaxed);
+        auto* cell = static_cast<Cell*>(nullptr);
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            auto seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = push_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element.
+     * @param[out] value   Receives the removed element.
+     * @returns true if an element was removed, false if the queue is empty.
+     */
+    bool try_pop(T& value)
+    {
+        auto pos = pop_pos_.load(std::memory_order_relaxed);
+        auto* cell = static_cast<Cell*>(nullptr);
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            auto seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (pop_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = pop_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->value);
+        cell->value = T();
+        cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get capacity of the queue.
+     * @returns maximum number of elements.
+     */
+    std::size_t get_capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    /* Disable copying and moving */
+    BoundedQueue(BoundedQueue const& other) = delete;
+    BoundedQueue(BoundedQueue&& other) = delete;
+    BoundedQueue& operator = (BoundedQueue const& other) = delete;
+    BoundedQueue&& operator = (BoundedQueue&& other) = delete;
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> seq;   // Position the cell is ready for
+        T                        value; // Stored element
+    };
+
+    std::unique_ptr<Cell[]>               cells_;    // Ring of cells
+    std::size_t                           mask_;     // Capacity - 1
+    alignas(64) std::atomic<std::size_t>  push_pos_; // Next position to push to
+    alignas(64) std::atomic<std::size_t>  pop_pos_;  // Next position to pop from
+};
+
+} // namespace host_monitor
+
+#endif // BOUNDEDQUEUE_HPP_202610161800
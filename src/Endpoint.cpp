@@ -10,11 +10,77 @@
  * directory for more details.
  */
 
+#include <mutex>
+#include <algorithm>
+#include <memory>
+#include <charconv>
 #include <stdexcept>
+#include <functional>
+#include <unordered_map>
 #include "Endpoint.hpp"
 
 namespace host_monitor
 {
+namespace
+{
+std::optional<std::uint16_t> parse_port(std::string_view port)
+{
+    auto val = 0;
+    auto const* end = port.data() + port.size();
+    auto [ptr, ec] = std::from_chars(port.data(), end, val);
+    if (port.empty() || ec != std::errc() || ptr != end || val < 1 || 0xFFFF < val)
+    {
+        return std::nullopt;
+    }
+    return static_cast<std::uint16_t>(val);
+}
+
+std::shared_ptr<std::string const> intern(std::string_view name)
+{
+    // Keys view the owned strings, lookups of known names don't allocate.
+    // The last Endpoint of a host releases its name, names don't pile up on reloads.
+    using Names = std::unordered_map<std::string_view, std::weak_ptr<std::string const>>;
+    static auto* mtx = new std::mutex();
+    static auto* names = new Names();
+
+    auto lock = std::lock_guard<std::mutex>(*mtx);
+    auto it = names->find(name);
+    if (it != names->end())
+    {
+        if (auto str = it->second.lock())
+        {
+            return str;
+        }
+
+        // Expired, its deleter waits for the lock. The key views the expiring string.
+        names->erase(it);
+    }
+
+    auto str = std::shared_ptr<std::string const>(new std::string const(name), [] (std::string const* p)
+    {
+        {
+            // The entry might have been replaced by a new copy of the name already
+            auto lock = std::lock_guard<std::mutex>(*mtx);
+            auto entry = names->find(*p);
+            if (entry != names->end() && entry->first.data() == p->data())
+            {
+                names->erase(entry);
+            }
+        }
+        delete p;
+    });
+    names->emplace(std::string_view(*str), str);
+    return str;
+}
+} // anon namespace
+
+// Request of UDP and HTTP endpoints
+struct Endpoint::Request
+{
+    std::string                payload;  // Datagram sent to the endpoint, HTTP request path
+    std::optional<std::string> expected; // Prefix the response must start with, HTTP body text
+    std::uint16_t              status;   // Expected HTTP status code, 0 for UDP
+};
 
 // Protocol related implementation
 std::string protocol_to_string(Endpoint::Protocol p)
@@ -29,11 +95,20 @@ std::string protocol_to_string(Endpoint::Protocol p)
 
         case Endpoint::Protocol::TCP:
             return std::string("TCP");
+
+        case Endpoint::Protocol::UDP:
+            return std::string("UDP");
+
+        case Endpoint::Protocol::HTTP:
+            return std::string("HTTP");
+
+        case Endpoint::Protocol::TCP_PERSISTENT:
+            return std::string("TCP_PERSISTENT");
     }
     return std::string();
 }
 
-std::optional<Endpoint::Protocol> string_to_protocol(std::string const& s)
+std::optional<Endpoint::Protocol> string_to_protocol(std::string_view s)
 {
     if (s == "ICMPV4")
     {
@@ -49,54 +124,118 @@ std::optional<Endpoint::Protocol> string_to_protocol(std::string const& s)
     {
         return Endpoint::Protocol::TCP;
     }
+
+    if (s == "UDP")
+    {
+        return Endpoint::Protocol::UDP;
+    }
+
+    if (s == "HTTP")
+    {
+        return Endpoint::Protocol::HTTP;
+    }
+
+    if (s == "TCP_PERSISTENT")
+    {
+        return Endpoint::Protocol::TCP_PERSISTENT;
+    }
     return {};
 }
 
 
-Endpoint::Endpoint( Endpoint::Protocol         protocol
-                  , std::string                fqhn
-                  , std::optional<std::string> port)
-    : protocol_(protocol)
-    , fqhn_(std::move(fqhn))
-    , port_(std::move(port))
+Endpoint::Endpoint( Endpoint::Protocol protocol
+                  , std::string_view   fqhn
+                  , std::uint16_t      port)
+    : fqhn_(intern(fqhn))
+    , address_()
+    , request_()
+    , port_(port)
+    , protocol_(protocol)
 {
 }
 
-Endpoint Endpoint::make_icmpv4_endpoint(std::string fqhn)
+Endpoint Endpoint::make_icmpv4_endpoint(std::string_view fqhn)
 {
-    return Endpoint(Protocol::ICMPV4, std::move(fqhn), std::nullopt);
+    return Endpoint(Protocol::ICMPV4, fqhn, 0);
 }
 
-Endpoint Endpoint::make_icmpv6_endpoint(std::string fqhn)
+Endpoint Endpoint::make_icmpv6_endpoint(std::string_view fqhn)
 {
-    return Endpoint(Protocol::ICMPV6, std::move(fqhn), std::nullopt);
+    return Endpoint(Protocol::ICMPV6, fqhn, 0);
 }
 
-Endpoint Endpoint::make_tcp_endpoint(std::string fqhn, std::string port)
+Endpoint Endpoint::make_tcp_endpoint(std::string_view fqhn, std::string_view port)
 {
-    // Try to convert the given port number to an int
-    auto val = 0;
-    try
+    auto val = parse_port(port);
+    if (!val)
     {
-        val = std::stoi(port);
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": " + std::string(port) + " is not a port in [1, 65535]");
     }
-    catch (...)
+    return Endpoint(Endpoint::Protocol::TCP, fqhn, *val);
+}
+
+Endpoint Endpoint::make_tcp_persistent_endpoint(std::string_view fqhn, std::string_view port)
+{
+    auto val = parse_port(port);
+    if (!val)
     {
         throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
-                                 ": " + port + " is not a valid number");
+                                 ": " + std::string(port) + " is not a port in [1, 65535]");
     }
+    return Endpoint(Endpoint::Protocol::TCP_PERSISTENT, fqhn, *val);
+}
 
-    // Check if given Port number is within the port number range
-    auto min = std::uint16_t(0x0001);
-    auto max = std::uint16_t(0xFFFF);
-    if (val < min || max < val)
+Endpoint Endpoint::make_udp_endpoint( std::string_view           fqhn
+                                    , std::string_view           port
+                                    , std::string                payload
+                                    , std::optional<std::string> expected)
+{
+    auto val = parse_port(port);
+    if (!val)
     {
         throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
-                                 ": " + port + " is not in [1, 65535]");
+                                 ": " + std::string(port) + " is not a port in [1, 65535]");
     }
 
-    // Create endpoint
-    return Endpoint(Endpoint::Protocol::TCP, std::move(fqhn), std::move(port));
+    auto endpoint = Endpoint(Endpoint::Protocol::UDP, fqhn, *val);
+    endpoint.request_ = std::make_shared<Request const>(Request{std::move(payload), std::move(expected), 0});
+    return endpoint;
+}
+
+Endpoint Endpoint::make_http_endpoint( std::string_view           fqhn
+                                     , std::string_view           port
+                                     , std::string                path
+                                     , std::uint16_t              status
+                                     , std::optional<std::string> body)
+{
+    auto val = parse_port(port);
+    if (!val)
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": " + std::string(port) + " is not a port in [1, 65535]");
+    }
+
+    // The path is sent verbatim, it must not break the request line
+    auto is_space = [] (char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    };
+    if (path.empty() || path.front() != '/' || std::any_of(path.begin(), path.end(), is_space))
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": " + path + " is not an absolute path");
+    }
+
+    if (status < 100 || 599 < status)
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": " + std::to_string(status) + " is not a status code");
+    }
+
+    auto endpoint = Endpoint(Endpoint::Protocol::HTTP, fqhn, *val);
+    endpoint.request_ = std::make_shared<Request const>(Request{std::move(path), std::move(body), status});
+    return endpoint;
 }
 
 std::string Endpoint::get_target() const
@@ -106,29 +245,95 @@ std::string Endpoint::get_target() const
     {
         case Endpoint::Protocol::ICMPV4:
         case Endpoint::Protocol::ICMPV6:
-            str = get_fqhn();
+            str = *fqhn_;
             break;
 
         case Endpoint::Protocol::TCP:
-            str = get_fqhn() + ":" + get_port().value();
+        case Endpoint::Protocol::UDP:
+        case Endpoint::Protocol::TCP_PERSISTENT:
+            str = *fqhn_ + ":" + std::to_string(port_);
+            break;
+
+        case Endpoint::Protocol::HTTP:
+            str = *fqhn_ + ":" + std::to_string(port_) + request_->payload;
             break;
     }
     return str;
 }
 
-std::string Endpoint::get_fqhn() const
+std::string_view Endpoint::get_fqhn() const
 {
-    return fqhn_;
+    return *fqhn_;
 }
 
-std::optional<std::string> Endpoint::get_port() const
+std::optional<std::uint16_t> Endpoint::get_port() const
 {
+    if (port_ == 0)
+    {
+        return std::nullopt;
+    }
     return port_;
 }
 
+std::string_view Endpoint::get_payload() const
+{
+    return request_ ? std::string_view(request_->payload) : std::string_view();
+}
+
+std::optional<std::string_view> Endpoint::get_expected_response() const
+{
+    if (!request_ || !request_->expected)
+    {
+        return std::nullopt;
+    }
+    return std::string_view(*request_->expected);
+}
+
+std::optional<std::uint16_t> Endpoint::get_expected_status() const
+{
+    if (!request_ || request_->status == 0)
+    {
+        return std::nullopt;
+    }
+    return request_->status;
+}
+
 Endpoint::Protocol Endpoint::get_protocol() const
 {
     return protocol_;
 }
 
+Endpoint Endpoint::with_address(sockaddr_storage const& address) const
+{
+    auto endpoint = *this;
+    endpoint.address_ = std::make_shared<sockaddr_storage const>(address);
+    return endpoint;
+}
+
+sockaddr_storage const* Endpoint::get_address() const
+{
+    return address_.get();
+}
+
+bool Endpoint::operator == (Endpoint const& other) const
+{
+    // Interned names are equal if they are the same object
+    auto same_request = (request_ == other.request_)
+                     || (request_ && other.request_ && request_->payload == other.request_->payload
+                                                    && request_->expected == other.request_->expected
+                                                    && request_->status == other.request_->status);
+    return fqhn_ == other.fqhn_ && port_ == other.port_ && protocol_ == other.protocol_ && same_request;
+}
+
+bool Endpoint::operator != (Endpoint const& other) const
+{
+    return !(*this == other);
+}
+
+std::size_t Endpoint::hash() const
+{
+    auto key = (std::size_t(protocol_) << 16) | port_;
+    return std::hash<std::string const*>()(fqhn_.get()) ^ (key * 0x9E3779B97F4A7C15ull);
+}
+
 } // namespace host_monitor
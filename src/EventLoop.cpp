@@ -0,0 +1,568 @@
+/**
+ * @file      EventLoop.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <stdexcept>
+#include <algorithm>
+#include <cerrno>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "EventLoop.hpp"
+#include "TestConnection.hpp"
+#include "MetricsRegistry.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Ids below FIRST_ENTRY_ID mark file descriptors not owned by an entry
+std::uint64_t const WAKEUP_ID = 0;
+std::uint64_t const ICMPV4_ID = 1;
+std::uint64_t const ICMPV6_ID = 2;
+std::uint64_t const FIRST_ENTRY_ID = 3;
+} // anon namespace
+
+EventLoop::SharedIcmp::SharedIcmp(int family)
+    : transport(family)
+    , registered_events(0)
+{
+}
+
+EventLoop::EventLoop(MonitorEngine::Backend backend, std::shared_ptr<RateLimiter> limiter)
+    : poller_(Poller::create(backend))
+    , limiter_(std::move(limiter))
+    , wakeup_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    , commands_mtx_()
+    , commands_()
+    , icmpv4_(AF_INET)
+    , icmpv6_(AF_INET6)
+    , entries_()
+    , ids_()
+    , removed_()
+    , wheel_(Clock::now())
+    , rng_(std::random_device()())
+    , next_id_(FIRST_ENTRY_ID)
+    , shutdown_(false)
+    , thread_()
+{
+    if (!wakeup_.is_valid())
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": failed to create eventfd");
+    }
+    poller_->add(wakeup_.get(), EPOLLIN, WAKEUP_ID);
+
+    // Without ICMP sockets, probes fall back to sockets of their own and fail there
+    update_registration(icmpv4_, ICMPV4_ID);
+    update_registration(icmpv6_, ICMPV6_ID);
+
+    thread_ = std::thread(&EventLoop::run, this);
+}
+
+EventLoop::~EventLoop()
+{
+    post([this] ()
+    {
+        shutdown_ = true;
+    });
+    thread_.join();
+}
+
+MonitorEngine::Backend EventLoop::get_backend() const
+{
+    return poller_->get_backend();
+}
+
+void EventLoop::add_monitor(std::shared_ptr<HostMonitor::Impl> monitor)
+{
+    // Called from an observer on this loop: insert immediately
+    if (std::this_thread::get_id() == thread_.get_id())
+    {
+        insert(std::move(monitor));
+        return;
+    }
+
+    post([this, monitor] ()
+    {
+        insert(monitor);
+    });
+}
+
+void EventLoop::del_monitor(HostMonitor::Impl const* monitor)
+{
+    // Called from an observer on this loop: remove immediately
+    if (std::this_thread::get_id() == thread_.get_id())
+    {
+        remove(monitor);
+        return;
+    }
+
+    // The monitor is retired, nothing is reported anymore. The entry keeps it alive until removed.
+    post([this, monitor] ()
+    {
+        remove(monitor);
+    });
+}
+
+void EventLoop::add_monitors(std::vector<std::shared_ptr<HostMonitor::Impl>> monitors)
+{
+    if (std::this_thread::get_id() == thread_.get_id())
+    {
+        for (auto& monitor : monitors)
+        {
+            insert(std::move(monitor));
+        }
+        return;
+    }
+
+    post([this, monitors = std::move(monitors)] () mutable
+    {
+        for (auto& monitor : monitors)
+        {
+            insert(std::move(monitor));
+        }
+    });
+}
+
+void EventLoop::del_monitors(std::vector<HostMonitor::Impl const*> monitors)
+{
+    if (std::this_thread::get_id() == thread_.get_id())
+    {
+        for (auto const* monitor : monitors)
+        {
+            remove(monitor);
+        }
+        return;
+    }
+
+    post([this, monitors = std::move(monitors)] ()
+    {
+        for (auto const* monitor : monitors)
+        {
+            remove(monitor);
+        }
+    });
+}
+
+void EventLoop::run()
+{
+    auto events = std::array<PollEvent, 256>();
+
+    while (shutdown_ == false)
+    {
+        auto timeout = wheel_.next_timeout(Clock::now());
+        auto n = poller_->wait(events.data(), events.size(), timeout);
+
+        for (auto i = std::size_t(0); i < n; ++i)
+        {
+            auto const& ev = events[i];
+            if (ev.id == WAKEUP_ID)
+            {
+                process_commands();
+            }
+            else if (ev.id == ICMPV4_ID)
+            {
+                process_icmp(icmpv4_, ICMPV4_ID, ev.events);
+            }
+            else if (ev.id == ICMPV6_ID)
+            {
+                process_icmp(icmpv6_, ICMPV6_ID, ev.events);
+            }
+            else
+            {
+                process_event(ev.id, ev.events);
+            }
+        }
+
+        auto now = Clock::now();
+        wheel_.advance(now, [this, now] (TimerWheel::Node& node)
+        {
+            process_timer(node.id, now);
+        });
+
+        // Echo requests started during this iteration go out in batches
+        flush_icmp(icmpv4_, ICMPV4_ID);
+        flush_icmp(icmpv6_, ICMPV6_ID);
+        collect_removed();
+    }
+}
+
+void EventLoop::post(std::function<void()> command)
+{
+    {
+        auto lock = std::lock_guard<std::mutex>(commands_mtx_);
+        commands_.push_back(std::move(command));
+    }
+
+    auto val = std::uint64_t(1);
+    auto ret = ::write(wakeup_.get(), &val, sizeof(val));
+    static_cast<void>(ret);
+}
+
+void EventLoop::process_commands()
+{
+    auto val = std::uint64_t();
+    auto ret = ::read(wakeup_.get(), &val, sizeof(val));
+    static_cast<void>(ret);
+
+    auto commands = CommandVector();
+    {
+        auto lock = std::lock_guard<std::mutex>(commands_mtx_);
+        commands.swap(commands_);
+    }
+
+    for (auto& command : commands)
+    {
+        command();
+    }
+}
+
+void EventLoop::process_event(std::uint64_t id, std::uint32_t events)
+{
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second.removed)
+    {
+        return;
+    }
+
+    // Watched idle connection was closed or failed: test right away
+    auto& entry = it->second;
+    if (!entry.probe)
+    {
+        if (entry.registered_fd < 0 || entry.registered_fd != entry.connection.get())
+        {
+            return;
+        }
+
+        auto now = Clock::now();
+        if (!entry.reserved)
+        {
+            entry.due = now;
+            if (admit(entry, now))
+            {
+                start_probe(id, entry, now);
+                return;
+            }
+        }
+
+        // Hang-ups stay reported while waiting for the rate limiter, stop watching meanwhile
+        unregister(entry);
+        return;
+    }
+
+    auto status = entry.probe->on_event(events);
+    if (status == Probe::Status::PENDING)
+    {
+        update_registration(id, entry);
+        return;
+    }
+    complete_probe(entry, status == Probe::Status::UP);
+}
+
+void EventLoop::process_timer(std::uint64_t id, Clock::time_point now)
+{
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second.removed)
+    {
+        return;
+    }
+
+    auto& entry = it->second;
+    if (entry.probe)
+    {
+        // Probe deadline expired, a timeout counts as failure
+        complete_probe(entry, false);
+    }
+    else if (entry.monitor->is_parent_down())
+    {
+        suppress_probe(entry, now);
+    }
+    else if (admit(entry, now))
+    {
+        start_probe(id, entry, now);
+    }
+}
+
+void EventLoop::process_icmp(SharedIcmp& icmp, std::uint64_t id, std::uint32_t events)
+{
+    if (events & (EPOLLIN | EPOLLERR))
+    {
+        auto replied = std::vector<std::uint64_t>();
+        icmp.transport.receive(replied);
+        complete_tokens(replied, true);
+    }
+
+    if (events & EPOLLOUT)
+    {
+        flush_icmp(icmp, id);
+    }
+}
+
+void EventLoop::flush_icmp(SharedIcmp& icmp, std::uint64_t id)
+{
+    auto failed = std::vector<std::uint64_t>();
+    icmp.transport.flush(failed);
+    update_registration(icmp, id);
+    complete_tokens(failed, false);
+}
+
+void EventLoop::update_registration(SharedIcmp& icmp, std::uint64_t id)
+{
+    if (!icmp.transport.is_valid())
+    {
+        return;
+    }
+
+    auto events = icmp.transport.get_events();
+    if (events == icmp.registered_events)
+    {
+        return;
+    }
+
+    auto fd = icmp.transport.get_fd();
+    auto ok = (icmp.registered_events == 0) ? poller_->add(fd, events, id)
+                                            : poller_->modify(fd, events, id);
+    if (ok)
+    {
+        icmp.registered_events = events;
+    }
+}
+
+void EventLoop::complete_tokens(std::vector<std::uint64_t> const& tokens, bool available)
+{
+    // Tokens are entry ids. Probes cancel their request on destruction,
+    // a token always refers to the entries current probe.
+    for (auto id : tokens)
+    {
+        auto it = entries_.find(id);
+        if (it != entries_.end() && !it->second.removed && it->second.probe)
+        {
+            complete_probe(it->second, available);
+        }
+    }
+}
+
+bool EventLoop::admit(Entry& entry, Clock::time_point now)
+{
+    // The reserved slot has come
+    if (entry.reserved)
+    {
+        entry.reserved = false;
+        return true;
+    }
+
+    auto protocol = entry.monitor->get_endpoint().get_protocol();
+    auto slot = limiter_->reserve(protocol, entry.monitor->get_schedule().priority, now);
+    if (slot <= now)
+    {
+        return true;
+    }
+
+    MetricsRegistry::get().record_rate_limited(protocol);
+    entry.reserved = true;
+    wheel_.schedule(entry.timer, slot);
+    return false;
+}
+
+void EventLoop::start_probe(std::uint64_t id, Entry& entry, Clock::time_point now)
+{
+    auto context = ProbeContext();
+    context.icmpv4 = &icmpv4_.transport;
+    context.icmpv6 = &icmpv6_.transport;
+    context.token = id;
+    context.connection = &entry.connection;
+    context.keepalive = entry.monitor->get_schedule().interval;
+
+    // Probes take over the idle connection, its watch ends
+    unregister(entry);
+
+    // The first test of a monitor starts ahead of its period
+    if (now >= entry.due)
+    {
+        MetricsRegistry::get().record_scheduler_lag(now - entry.due);
+    }
+
+    entry.started = now;
+    entry.probe = make_probe(entry.monitor->get_endpoint(), context);
+    if (!entry.probe)
+    {
+        complete_probe(entry, false);
+        return;
+    }
+
+    auto status = entry.probe->start();
+    if (status != Probe::Status::PENDING)
+    {
+        complete_probe(entry, status == Probe::Status::UP);
+        return;
+    }
+
+    update_registration(id, entry);
+    wheel_.schedule(entry.timer, now + entry.monitor->get_schedule().timeout);
+}
+
+void EventLoop::suppress_probe(Entry& entry, Clock::time_point now)
+{
+    // Children of a down endpoint are rechecked at their base interval, a reserved slot is given up
+    auto protocol = entry.monitor->get_endpoint().get_protocol();
+    MetricsRegistry::get().record_probe_suppressed(protocol);
+    entry.reserved = false;
+
+    auto when = std::max(entry.due + Clock::duration(entry.monitor->get_interval()), now);
+    wheel_.schedule(entry.timer, when);
+    entry.due = when;
+
+    auto monitor = entry.monitor;
+    monitor->report_unreachable();
+}
+
+void EventLoop::complete_probe(Entry& entry, bool available)
+{
+    auto rtt = Clock::now() - entry.started;
+    unregister(entry);
+    entry.probe.reset();
+
+    // Schedule the next probe before reporting. Observers might remove the entry.
+    // Periods are anchored to avoid drift, overruns skip the missed periods.
+    auto interval = entry.monitor->advance_schedule(available);
+    auto when = std::max(entry.due + interval, Clock::now());
+    wheel_.schedule(entry.timer, when);
+    entry.due = when;
+    watch_connection(entry);
+
+    auto monitor = entry.monitor;
+    monitor->report(available, rtt);
+}
+
+void EventLoop::update_registration(std::uint64_t id, Entry& entry)
+{
+    // Probes on a shared transport have no file descriptor of their own
+    auto fd = entry.probe->get_fd();
+    if (fd < 0)
+    {
+        unregister(entry);
+        return;
+    }
+
+    auto events = entry.probe->get_events();
+    if (fd != entry.registered_fd)
+    {
+        unregister(entry);
+        if (poller_->add(fd, events, id))
+        {
+            entry.registered_fd = fd;
+            entry.registered_events = events;
+        }
+    }
+    else if (events != entry.registered_events)
+    {
+        poller_->modify(fd, events, id);
+        entry.registered_events = events;
+    }
+}
+
+void EventLoop::watch_connection(Entry& entry)
+{
+    // Only persistent connections are expected to stay open. HTTP servers
+    // close idle connections on their own, that is no reason to test early.
+    if ( !entry.connection.is_valid()
+      || entry.monitor->get_endpoint().get_protocol() != Endpoint::Protocol::TCP_PERSISTENT)
+    {
+        return;
+    }
+
+    // Errors and hang-ups are always reported
+    if (poller_->add(entry.connection.get(), EPOLLRDHUP, entry.timer.id))
+    {
+        entry.registered_fd = entry.connection.get();
+        entry.registered_events = EPOLLRDHUP;
+    }
+}
+
+void EventLoop::unregister(Entry& entry)
+{
+    if (entry.registered_fd >= 0)
+    {
+        poller_->remove(entry.registered_fd);
+        entry.registered_fd = -1;
+        entry.registered_events = 0;
+    }
+}
+
+EventLoop::Clock::duration EventLoop::random_offset(Clock::duration range)
+{
+    if (range.count() <= 0)
+    {
+        return Clock::duration(0);
+    }
+
+    auto dist = std::uniform_int_distribution<Clock::rep>(0, range.count());
+    return Clock::duration(dist(rng_));
+}
+
+EventLoop::Clock::duration EventLoop::phase_jitter(Clock::duration interval)
+{
+    // Monitors registered at once spread over a tenth of their interval
+    return random_offset(interval / 10);
+}
+
+void EventLoop::insert(std::shared_ptr<HostMonitor::Impl> monitor)
+{
+    auto id = next_id_++;
+    auto now = Clock::now();
+    auto interval = Clock::duration(monitor->get_interval());
+
+    // The first probe starts immediately or spread over the startup spread,
+    // the following ones are phase shifted
+    auto first = now + random_offset(std::min(limiter_->get_startup_spread(), interval));
+    auto& entry = entries_.try_emplace(id).first->second;
+    entry.due = first + phase_jitter(interval);
+    entry.timer.id = id;
+    wheel_.schedule(entry.timer, first);
+
+    ids_.emplace(monitor.get(), id);
+    entry.monitor = std::move(monitor);
+}
+
+void EventLoop::remove(HostMonitor::Impl const* monitor)
+{
+    auto it = ids_.find(monitor);
+    if (it == ids_.end())
+    {
+        return;
+    }
+
+    // Entries might be in use further up the stack, erase them later
+    auto& entry = entries_.at(it->second);
+    unregister(entry);
+    wheel_.cancel(entry.timer);
+    entry.probe.reset();
+    entry.removed = true;
+
+    removed_.push_back(it->second);
+    ids_.erase(it);
+}
+
+void EventLoop::collect_removed()
+{
+    for (auto id : removed_)
+    {
+        entries_.erase(id);
+    }
+    removed_.clear();
+}
+
+} // namespace host_monitor
@@ -0,0 +1,186 @@
+/**
+ * @file      EventLoop.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef EVENTLOOP_HPP_202610161210
+#define EVENTLOOP_HPP_202610161210
+
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+#include "HostMonitorImpl.hpp"
+#include "IcmpTransport.hpp"
+#include "MonitorEngine.hpp"
+#include "Poller.hpp"
+#include "Probe.hpp"
+#include "RateLimiter.hpp"
+#include "Socket.hpp"
+#include "TimerWheel.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Thread multiplexing the connection tests of many monitors over a Poller.
+ * @note  All monitor related state is owned by the loop thread. Other threads
+ *        interact with the loop by posting commands.
+ */
+class EventLoop
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] backend   Preferred I/O backend. IO_URING falls back to EPOLL if unsupported.
+     * @param[in] limiter   Rate limit of connection tests, shared by all loops of an engine.
+     */
+    EventLoop(MonitorEngine::Backend backend, std::shared_ptr<RateLimiter> limiter);
+
+    ~EventLoop();
+
+    /**
+     * @brief Get I/O backend in use.
+     * @returns backend of the loop, after fallback.
+     */
+    MonitorEngine::Backend get_backend() const;
+
+    /**
+     * @brief Register a monitor. Its first connection test starts immediately,
+     *        or at a random offset within the startup spread of the rate limiter.
+     * @param[in] monitor   The monitor to register.
+     */
+    void add_monitor(std::shared_ptr<HostMonitor::Impl> monitor);
+
+    /**
+     * @brief Unregister a monitor. Doesn't wait for the loop, the monitor is dropped later on.
+     * @note  The monitor must be retired, results of probes still in flight are discarded.
+     *        Can be called from within an observer running on the loop thread.
+     * @param[in] monitor   The monitor to unregister.
+     */
+    void del_monitor(HostMonitor::Impl const* monitor);
+
+    /**
+     * @brief Register monitors with a single command, see add_monitor().
+     * @param[in] monitors   The monitors to register.
+     */
+    void add_monitors(std::vector<std::shared_ptr<HostMonitor::Impl>> monitors);
+
+    /**
+     * @brief Unregister monitors with a single command, see del_monitor().
+     * @param[in] monitors   The monitors to unregister.
+     */
+    void del_monitors(std::vector<HostMonitor::Impl const*> monitors);
+
+    /* Disable copying and moving */
+    EventLoop(EventLoop const& other) = delete;
+    EventLoop(EventLoop&& other) = delete;
+    EventLoop& operator = (EventLoop const& other) = delete;
+    EventLoop&& operator = (EventLoop&& other) = delete;
+
+private:
+    using Clock = TimerWheel::Clock;
+
+    // Per monitor state, owned by the loop thread
+    struct Entry
+    {
+        std::shared_ptr<HostMonitor::Impl> monitor;                // Monitor the results are reported to
+        std::unique_ptr<Probe>             probe;                  // In-flight probe, if any
+        Socket                             connection;             // Idle connection kept alive between probes
+        TimerWheel::Node                   timer;                  // Next probe start or probe deadline
+        int                                registered_fd = -1;     // File descriptor registered on the poller
+        std::uint32_t                      registered_events = 0;  // Events registered on the poller
+        Clock::time_point                  started;                // Start of the last probe
+        Clock::time_point                  due;                    // Start of the current probe period
+        bool                               reserved = false;       // Probe start is delayed to a slot of the rate limiter
+        bool                               removed = false;        // Entry is erased at the end of the iteration
+    };
+
+    // ICMP transport shared by all probes of one address family
+    struct SharedIcmp
+    {
+        explicit SharedIcmp(int family);
+
+        IcmpTransport transport;         // Batching transport
+        std::uint32_t registered_events; // Events registered on the poller
+    };
+
+    using EntryMap = std::unordered_map<std::uint64_t, Entry>;
+    using IdMap = std::unordered_map<HostMonitor::Impl const*, std::uint64_t>;
+    using CommandVector = std::vector<std::function<void()>>;
+
+    void run();
+
+    void post(std::function<void()> command);
+
+    void process_commands();
+
+    void process_event(std::uint64_t id, std::uint32_t events);
+
+    void process_timer(std::uint64_t id, Clock::time_point now);
+
+    void process_icmp(SharedIcmp& icmp, std::uint64_t id, std::uint32_t events);
+
+    void flush_icmp(SharedIcmp& icmp, std::uint64_t id);
+
+    void update_registration(SharedIcmp& icmp, std::uint64_t id);
+
+    void complete_tokens(std::vector<std::uint64_t> const& tokens, bool available);
+
+    bool admit(Entry& entry, Clock::time_point now);
+
+    void start_probe(std::uint64_t id, Entry& entry, Clock::time_point now);
+
+    void suppress_probe(Entry& entry, Clock::time_point now);
+
+    void complete_probe(Entry& entry, bool available);
+
+    void update_registration(std::uint64_t id, Entry& entry);
+
+    void watch_connection(Entry& entry);
+
+    void unregister(Entry& entry);
+
+    Clock::duration random_offset(Clock::duration range);
+
+    Clock::duration phase_jitter(Clock::duration interval);
+
+    void insert(std::shared_ptr<HostMonitor::Impl> monitor);
+
+    void remove(HostMonitor::Impl const* monitor);
+
+    void collect_removed();
+
+    std::unique_ptr<Poller>      poller_;       // Readiness notification
+    std::shared_ptr<RateLimiter> limiter_;      // Rate limit of probe starts
+    Socket                       wakeup_;       // eventfd signaling posted commands
+    std::mutex                   commands_mtx_; // Lock for synchronizing access to commands_
+    CommandVector                commands_;     // Commands to execute on the loop thread
+    SharedIcmp                   icmpv4_;       // Shared ICMPv4 transport. Outlives the probes using it.
+    SharedIcmp                   icmpv6_;       // Shared ICMPv6 transport. Outlives the probes using it.
+    EntryMap                     entries_;      // Registered monitors by id
+    IdMap                        ids_;          // Id lookup by monitor
+    std::vector<std::uint64_t>   removed_;      // Ids of entries to erase
+    TimerWheel                   wheel_;        // Probe schedule. Destroyed before the entries it links.
+    std::minstd_rand             rng_;          // Source of per monitor phase jitter and startup offsets
+    std::uint64_t                next_id_;      // Id of the next registered monitor
+    bool                         shutdown_;     // Thread life-time management Flag
+    std::thread                  thread_;       // Thread running the loop
+};
+
+} // namespace host_monitor
+
+#endif // EVENTLOOP_HPP_202610161210
@@ -0,0 +1,159 @@
+/**
+ * @file      FlapDamper.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "FlapDamper.hpp"
+
+namespace host_monitor
+{
+
+FlapDamper::FlapDamper(HostMonitor::Damping const& damping)
+    : damping_(damping)
+    , history_(0)
+    , recorded_(0)
+    , in_a_row_(0)
+    , last_(false)
+    , damped_(false)
+    , published_(false)
+    , suppressed_(false)
+    , penalty_(0.0)
+    , updated_()
+{
+    auto const& d = damping_;
+    auto window_ok = d.window == 0 || (d.window <= 64 && d.failures <= d.window && d.successes <= d.window);
+    auto penalty_ok = d.penalty == 0.0 || ( d.penalty > 0.0 && d.half_life.count() > 0
+                                         && d.reuse_limit >= 0.0 && d.reuse_limit < d.suppress_limit);
+    if (d.failures == 0 || d.successes == 0 || !window_ok || !penalty_ok)
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": invalid damping");
+    }
+}
+
+bool FlapDamper::update(bool available, Clock::time_point now)
+{
+    if (damping_.penalty > 0.0)
+    {
+        decay(now);
+    }
+    updated_ = now;
+
+    auto changed = apply_thresholds(available) != damped_;
+    if (changed)
+    {
+        damped_ = !damped_;
+        penalty_ += damping_.penalty;
+    }
+
+    // Suppression starts above the suppress limit and ends below the reuse limit
+    if (damping_.penalty > 0.0)
+    {
+        if (!suppressed_ && penalty_ > damping_.suppress_limit)
+        {
+            suppressed_ = true;
+        }
+        else if (suppressed_ && penalty_ < damping_.reuse_limit)
+        {
+            suppressed_ = false;
+        }
+    }
+
+    if (!suppressed_)
+    {
+        published_ = damped_;
+    }
+    return published_;
+}
+
+void FlapDamper::seed(bool available)
+{
+    last_ = available;
+    damped_ = available;
+    published_ = available;
+}
+
+void FlapDamper::force(bool available)
+{
+    history_ = 0;
+    recorded_ = 0;
+    in_a_row_ = 0;
+    seed(available);
+}
+
+bool FlapDamper::is_suppressed() const
+{
+    return suppressed_;
+}
+
+double FlapDamper::get_penalty() const
+{
+    return penalty_;
+}
+
+bool FlapDamper::apply_thresholds(bool available)
+{
+    in_a_row_ = (recorded_ != 0 && last_ == available) ? in_a_row_ + 1 : 1;
+    last_ = available;
+    history_ = (history_ << 1) | (available ? 0u : 1u);
+    recorded_ = std::min(recorded_ + 1, std::uint32_t(64));
+
+    auto damped = damped_;
+    if (damping_.window == 0)
+    {
+        if (damped_ != available && in_a_row_ >= (available ? damping_.successes : damping_.failures))
+        {
+            damped = available;
+        }
+    }
+    else
+    {
+        // Count results within the window, never before the last state change
+        auto count = std::min(recorded_, damping_.window);
+        auto mask = count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+        auto failed = static_cast<std::uint32_t>(std::bitset<64>(history_ & mask).count());
+        if (damped_ && failed >= damping_.failures)
+        {
+            damped = false;
+        }
+        else if (!damped_ && count - failed >= damping_.successes)
+        {
+            damped = true;
+        }
+    }
+
+    // Start counting afresh, old results must not cause an immediate change back
+    if (damped != damped_)
+    {
+        history_ = history_ & 1;
+        recorded_ = 1;
+    }
+    return damped;
+}
+
+void FlapDamper::decay(Clock::time_point now)
+{
+    if (penalty_ == 0.0 || now <= updated_)
+    {
+        return;
+    }
+
+    auto elapsed = std::chrono::duration<double>(now - updated_);
+    auto half_life = std::chrono::duration<double>(damping_.half_life);
+    penalty_ *= std::exp2(-elapsed.count() / half_life.count());
+}
+
+} // namespace host_monitor
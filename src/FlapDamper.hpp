@@ -0,0 +1,97 @@
+/**
+ * @file      FlapDamper.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef FLAPDAMPER_HPP_202610161900
+#define FLAPDAMPER_HPP_202610161900
+
+#include <chrono>
+#include <cstdint>
+
+#include "HostMonitor.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Filters connection test results into a damped availability.
+ * @note  Keeps constant state per monitor: counters of tests in a row, a bitmask
+ *        of the last 64 results and a decaying penalty. Not thread-safe.
+ */
+class FlapDamper
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructor. Starts unavailable.
+     * @throws std::runtime_error in case @p damping is invalid.
+     * @param[in] damping   The thresholds to apply.
+     */
+    explicit FlapDamper(HostMonitor::Damping const& damping);
+
+    /**
+     * @brief Feed the result of a connection test.
+     * @param[in] available   true if the endpoint was reachable.
+     * @param[in] now         Time of the connection test.
+     * @returns availability to publish. Changes only if the thresholds are met
+     *          and changes aren't suppressed.
+     */
+    bool update(bool available, Clock::time_point now);
+
+    /**
+     * @brief Restart from a known availability, e.g. one recorded before a restart.
+     * @note  Must be called before the first update().
+     * @param[in] available   The availability to start with.
+     */
+    void seed(bool available);
+
+    /**
+     * @brief Force an availability determined otherwise, e.g. unreachable behind a down parent.
+     * @note  Results fed so far are dropped, the thresholds apply afresh. The penalty is kept.
+     * @param[in] available   The availability to continue with.
+     */
+    void force(bool available);
+
+    /**
+     * @brief Check if state changes are currently suppressed.
+     * @returns true if the flap penalty exceeded the suppress limit and didn't decay yet.
+     */
+    bool is_suppressed() const;
+
+    /**
+     * @brief Get the current flap penalty, decayed until the last update().
+     * @returns the penalty.
+     */
+    double get_penalty() const;
+
+private:
+    // Apply thresholds to the new result, returns the damped availability
+    bool apply_thresholds(bool available);
+
+    // Decay penalty_ until @p now
+    void decay(Clock::time_point now);
+
+    HostMonitor::Damping damping_;    // Thresholds
+    std::uint64_t        history_;    // Last results, bit set on failure. Newest in bit 0
+    std::uint32_t        recorded_;   // Results in history_ since the last state change, at most 64
+    std::uint32_t        in_a_row_;   // Results equal to the newest one in a row
+    bool                 last_;       // Newest result
+    bool                 damped_;     // Availability after thresholds
+    bool                 published_;  // Availability after suppression
+    bool                 suppressed_; // State changes are withheld
+    double               penalty_;    // Flap penalty, decayed until updated_
+    Clock::time_point    updated_;    // Time of the last update()
+};
+
+} // namespace host_monitor
+
+#endif // FLAPDAMPER_HPP_202610161900
@@ -10,156 +10,389 @@
  * directory for more details.
  */
 
-#include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 #include <cstdint>
 
-#include "HostMonitor.hpp"
-#include "TestConnection.hpp"
+#include "HostMonitorImpl.hpp"
+#include "MonitorEngineImpl.hpp"
+#include "MetricsRegistry.hpp"
 
 namespace host_monitor
 {
 
-class HostMonitor::Impl
+// Schedule related implementation
+HostMonitor::Schedule HostMonitor::Schedule::fixed(std::chrono::milliseconds interval)
 {
-public:
-    Impl(Endpoint endpoint, std::chrono::seconds interval);
+    return Schedule{interval, interval, interval, interval, 0, 0, 1.0};
+}
 
-    ~Impl();
+HostMonitor::Schedule HostMonitor::Schedule::adaptive(std::chrono::milliseconds interval)
+{
+    auto retry = std::max(interval / 4, std::chrono::milliseconds(1));
+    return Schedule{interval, retry, interval * 8, retry, 2, 10, 2.0};
+}
 
-    void add_observer(std::shared_ptr<HostMonitorObserver> observer);
+HostMonitor::Impl::Impl(Endpoint endpoint, Schedule schedule, Damping damping)
+    : endpoint_(std::move(endpoint))
+    , schedule_(std::move(schedule))
+    , stretched_(schedule_.interval)
+    , successes_(0)
+    , failures_(0)
+    , damper_(damping)
+    , state_()
+    , snapshot_()
+    , latency_()
+    , observers_(std::make_shared<ObserverVector const>())
+    , observers_mtx_()
+    , observers_version_(0)
+    , reported_(observers_)
+    , reported_version_(0)
+    , report_mtx_()
+    , retired_(false)
+    , journal_(nullptr)
+    , node_()
+    , counted_down_(false)
+{
+    auto const& s = schedule_;
+    if ( s.interval.count() <= 0 || s.min_interval.count() <= 0 || s.retry_interval.count() <= 0
+      || s.min_interval > s.max_interval || s.backoff < 1.0 || s.timeout.count() <= 0)
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": invalid schedule");
+    }
+}
 
-    void del_observer(std::shared_ptr<HostMonitorObserver> observer);
+template <typename Modifier>
+void HostMonitor::Impl::update_observers(Modifier&& modify)
+{
+    // Published snapshots are never modified, the reporter might iterate them
+    auto lock = std::lock_guard<std::mutex>(observers_mtx_);
+    auto observers = std::make_shared<ObserverVector>(*observers_);
+    modify(*observers);
+    observers_ = std::move(observers);
+    observers_version_.fetch_add(1, std::memory_order_release);
+}
 
-    bool is_available() const;
+void HostMonitor::Impl::add_observer(std::shared_ptr<HostMonitorObserver> observer, Notifier::Impl* notifier)
+{
+    auto counters = notifier ? notifier->subscribe(observer) : nullptr;
 
-    Endpoint const& get_endpoint() const;
+    update_observers([&] (ObserverVector& observers)
+    {
+        observers.push_back(Registration{std::move(observer), notifier, std::move(counters)});
+    });
+}
 
-    std::vector<uint8_t> const& get_metadata() const;
+void HostMonitor::Impl::del_observer(std::shared_ptr<HostMonitorObserver> observer)
+{
+    update_observers([&observer] (ObserverVector& observers)
+    {
+        auto pos = std::remove_if(observers.begin(), observers.end(), [&observer] (Registration const& r)
+        {
+            return r.observer == observer;
+        });
+        observers.erase(pos, observers.end());
+    });
+}
 
-    std::chrono::seconds const&get_interval() const;
+bool HostMonitor::Impl::is_available() const
+{
+    return snapshot_.load().available;
+}
 
-private:
-    void monitor_target();
+HostMonitor::State HostMonitor::Impl::get_state() const
+{
+    return snapshot_.load();
+}
 
-    using ObserverVector = std::vector<std::shared_ptr<HostMonitorObserver>>;
+LatencyHistogram HostMonitor::Impl::get_latency() const
+{
+    return latency_;
+}
 
-    Endpoint                endpoint_;      // Endpoint: @See Endpoint.
-    std::chrono::seconds    interval_;      // Interval between Connection Tests
-    std::thread             thread_;        // Thread performing periodic tests
-    std::mutex              mtx_;           // Mutex to use with condition variables
-    std::condition_variable cv_;            // Thread sleeping condition
-    bool                    shutdown_;      // Thread life-time management Flag
-    bool                    available_;     // Holds result from last connection test
-    ObserverVector          observers_;     // Vector holding registered observers
-    std::mutex              observers_mtx_; // Lock for synchronizing access to observers_
-};
+Endpoint const& HostMonitor::Impl::get_endpoint() const
+{
+    return endpoint_;
+}
 
-HostMonitor::Impl::Impl(Endpoint endpoint, std::chrono::seconds interval)
-    : endpoint_(std::move(endpoint))
-    , interval_(std::move(interval))
-    , thread_()
-    , mtx_()
-    , cv_()
-    , shutdown_(false)
-    , available_(false)
-    , observers_()
-    , observers_mtx_()
+std::chrono::milliseconds const& HostMonitor::Impl::get_interval() const
+{
+    return schedule_.interval;
+}
+
+HostMonitor::Schedule const& HostMonitor::Impl::get_schedule() const
 {
-    // Start Monitor thread in case given endpoints protocol is supported
-    thread_ = std::thread(&HostMonitor::Impl::monitor_target, this);
+    return schedule_;
 }
 
-HostMonitor::Impl::~Impl()
+void HostMonitor::Impl::attach_journal( StateJournal::Impl::Record*          record
+                                      , std::optional<StateJournal::Entry> const& seed)
 {
+    // Unknown endpoints start unavailable, as without journal
+    journal_ = record;
+    if (!seed)
     {
-        auto lock = std::unique_lock<std::mutex>(mtx_);
-        shutdown_ = true;
-        cv_.notify_one();
+        return;
     }
-    thread_.join();
+
+    damper_.seed(seed->available);
+    state_.available = seed->available;
+    state_.consecutive_failures = seed->consecutive_failures;
+    state_.last_probe = seed->last_probe;
+    state_.last_change = seed->last_change;
+    snapshot_.store(state_);
 }
 
-void HostMonitor::Impl::add_observer(std::shared_ptr<HostMonitorObserver> observer)
+StateJournal::Impl::Record* HostMonitor::Impl::detach_journal()
 {
-    auto lock = std::lock_guard<std::mutex>(observers_mtx_);
-    observers_.push_back(observer);
+    auto* record = journal_;
+    journal_ = nullptr;
+    return record;
 }
 
-void HostMonitor::Impl::del_observer(std::shared_ptr<HostMonitorObserver> observer)
+std::chrono::milliseconds HostMonitor::Impl::advance_schedule(bool available)
 {
-    auto lock = std::lock_guard<std::mutex>(observers_mtx_);
-    auto pos = std::remove(observers_.begin(), observers_.end(), observer);
-    observers_.erase(pos, observers_.end());
+    auto next = stretched_;
+    if (available)
+    {
+        // Stable hosts are tested less often
+        failures_ = 0;
+        successes_ += 1;
+        if (schedule_.stable_tests != 0 && successes_ % schedule_.stable_tests == 0)
+        {
+            auto stretched = std::chrono::duration<double, std::milli>(stretched_) * schedule_.backoff;
+            stretched_ = std::min( std::chrono::duration_cast<std::chrono::milliseconds>(stretched)
+                                 , schedule_.max_interval);
+        }
+        next = stretched_;
+    }
+    else
+    {
+        // Confirm failures quickly, then fall back to the base interval
+        successes_ = 0;
+        failures_ += 1;
+        stretched_ = schedule_.interval;
+        next = (failures_ <= schedule_.retries) ? schedule_.retry_interval : schedule_.interval;
+    }
+    return std::clamp(next, schedule_.min_interval, schedule_.max_interval);
 }
 
-bool HostMonitor::Impl::is_available() const
+void HostMonitor::Impl::attach_node(std::shared_ptr<Node> node)
 {
-    return available_;
+    node_ = std::move(node);
+
+    // Only a state seeded by the journal is known, otherwise the first test tells
+    if (node_ && state_.last_probe != std::chrono::system_clock::time_point())
+    {
+        publish();
+    }
 }
 
-Endpoint const& HostMonitor::Impl::get_endpoint() const
+void HostMonitor::Impl::retire()
 {
-    return endpoint_;
+    auto lock = std::lock_guard<std::recursive_mutex>(report_mtx_);
+    retired_ = true;
+
+    // The last state of a removed monitor must not keep suppressing the children.
+    // node_ stays set, the engine might still check the parent before dropping the monitor.
+    if (node_ && counted_down_)
+    {
+        node_->down.fetch_sub(1, std::memory_order_relaxed);
+    }
+    counted_down_ = false;
 }
 
-std::chrono::seconds const& HostMonitor::Impl::get_interval() const
+bool HostMonitor::Impl::is_parent_down() const
 {
-    return interval_;
+    // The loaded reference keeps the parent alive, even if the dependency is dropped meanwhile
+    auto parent = node_ ? std::atomic_load(&node_->parent) : nullptr;
+    return parent && parent->down.load(std::memory_order_relaxed) != 0;
 }
 
-void HostMonitor::Impl::monitor_target()
+void HostMonitor::Impl::report( bool available_n, std::chrono::nanoseconds rtt
+                              , FlapDamper::Clock::time_point now)
 {
-    while (shutdown_ == false)
+    auto lock = std::lock_guard<std::recursive_mutex>(report_mtx_);
+    if (retired_)
     {
-        // Perform connection test
-        auto available_n1 = available_;
-        auto available_n = test_connection(endpoint_);
+        return;
+    }
 
-        // Update State and inform observers
-        if (available_n1 != available_n)
-        {
-            available_ = available_n;
+    auto& metrics = MetricsRegistry::get();
+    metrics.record_probe(endpoint_.get_protocol(), available_n, rtt);
+
+    // The parent went down during the test, the failure is attributed to it
+    if (!available_n && is_parent_down())
+    {
+        report_unreachable();
+        return;
+    }
+
+    // Availability changes only once the damping thresholds are met.
+    // Leaving the unreachable state is a change as well.
+    auto available = damper_.update(available_n, now);
+    auto flipped = state_.available != available;
+    auto changed = flipped || state_.unreachable;
+
+    // Publish State before observers are informed
+    auto wall = std::chrono::system_clock::now();
+    state_.available = available;
+    state_.unreachable = false;
+    state_.consecutive_failures = available_n ? 0 : state_.consecutive_failures + 1;
+    state_.last_probe = wall;
+    state_.suppressed = damper_.is_suppressed();
+    if (changed)
+    {
+        state_.last_change = wall;
+    }
+    if (available_n)
+    {
+        state_.rtt = rtt;
+        latency_.record(rtt);
+    }
+    publish();
+
+    if (journal_)
+    {
+        auto entry = StateJournal::Entry();
+        entry.available = state_.available;
+        entry.consecutive_failures = state_.consecutive_failures;
+        entry.last_probe = state_.last_probe;
+        entry.last_change = state_.last_change;
+        StateJournal::Impl::store(*journal_, entry, !available_n, flipped);
+    }
+
+    if (changed)
+    {
+        metrics.record_state_change(available);
+        inform_observers();
+    }
+}
+
+void HostMonitor::Impl::report_unreachable()
+{
+    auto lock = std::lock_guard<std::recursive_mutex>(report_mtx_);
+    if (retired_ || state_.unreachable)
+    {
+        return;
+    }
 
-            // Construct Data Object
-            auto const data = HostMonitorObserver::Data{endpoint_, interval_, available_};
+    // Unreachable counts as down, coming back takes the successful tests of the damping.
+    // The journal keeps the last tested state.
+    damper_.force(false);
+    state_.available = false;
+    state_.unreachable = true;
+    state_.last_change = std::chrono::system_clock::now();
+    publish();
 
-            // Update Observers on state change
-            auto lock = std::lock_guard<std::mutex>(observers_mtx_);
-            for (auto obs : observers_)
-            {
-                obs->state_change(data);
-            }
+    MetricsRegistry::get().record_unreachable();
+    inform_observers();
+}
 
-            // Update old state
-            available_n1 = available_n;
+void HostMonitor::Impl::publish()
+{
+    snapshot_.store(state_);
+
+    // Children of this endpoint check its state before each test. The endpoint
+    // is down as long as any of its monitors sees it down.
+    auto down = !state_.available || state_.unreachable;
+    if (node_ && down != counted_down_)
+    {
+        if (down)
+        {
+            node_->down.fetch_add(1, std::memory_order_relaxed);
         }
+        else
+        {
+            node_->down.fetch_sub(1, std::memory_order_relaxed);
+        }
+        counted_down_ = down;
+    }
+}
 
-        // Sleep until duration expired or a shutdown is initiated
-        auto lock = std::unique_lock<std::mutex>(mtx_);
-        auto pred = [this] ()
+void HostMonitor::Impl::inform_observers()
+{
+    auto& metrics = MetricsRegistry::get();
+
+    // Construct Data Object
+    auto const data = HostMonitorObserver::Data{endpoint_, schedule_.interval, state_.available, state_.unreachable};
+
+    // Pick up a changed observer set. Otherwise no lock is taken and no
+    // reference count is touched. Observers may change the set meanwhile.
+    auto version = observers_version_.load(std::memory_order_acquire);
+    if (version != reported_version_)
+    {
+        auto lock = std::lock_guard<std::mutex>(observers_mtx_);
+        reported_ = observers_;
+        reported_version_ = version;
+    }
+
+    // Update Observers on state change
+    auto const& observers = *reported_;
+    for (auto const& reg : observers)
+    {
+        // Asynchronous observers are informed from the notifiers thread
+        if (reg.notifier)
         {
-            return shutdown_;
-        };
-        cv_.wait_for(lock, interval_, pred);
+            reg.notifier->post(shared_from_this(), reg.observer, reg.counters, state_.available, state_.unreachable);
+            continue;
+        }
+        auto started = std::chrono::steady_clock::now();
+        reg.observer->state_change(data);
+        metrics.record_observer_call(std::chrono::steady_clock::now() - started);
     }
 }
 
 // Interface Implementation
-HostMonitor::HostMonitor(Endpoint endpoint, std::chrono::seconds interval)
+HostMonitor::HostMonitor(Endpoint endpoint, std::chrono::milliseconds interval)
+    : HostMonitor(std::move(endpoint), Schedule::fixed(interval), MonitorEngine::get_default())
+{
+}
+
+HostMonitor::HostMonitor(Endpoint endpoint, std::chrono::milliseconds interval, MonitorEngine& engine)
+    : HostMonitor(std::move(endpoint), Schedule::fixed(interval), engine)
+{
+}
+
+HostMonitor::HostMonitor(Endpoint endpoint, Schedule schedule)
+    : HostMonitor(std::move(endpoint), std::move(schedule), MonitorEngine::get_default())
+{
+}
+
+HostMonitor::HostMonitor(Endpoint endpoint, Schedule schedule, MonitorEngine& engine)
+    : HostMonitor(std::move(endpoint), std::move(schedule), Damping(), engine)
+{
+}
+
+HostMonitor::HostMonitor(Endpoint endpoint, Schedule schedule, Damping damping)
+    : HostMonitor(std::move(endpoint), std::move(schedule), std::move(damping), MonitorEngine::get_default())
+{
+}
+
+HostMonitor::HostMonitor(Endpoint endpoint, Schedule schedule, Damping damping, MonitorEngine& engine)
+    : pimpl_(std::make_shared<Impl>(std::move(endpoint), std::move(schedule), std::move(damping)))
+    , engine_(engine)
 {
-    pimpl_ = std::make_unique<Impl>(std::move(endpoint), std::move(interval));
+    engine_.pimpl_->add_monitor(pimpl_);
 }
 
-HostMonitor::~HostMonitor() = default;
+HostMonitor::~HostMonitor()
+{
+    engine_.pimpl_->del_monitor(pimpl_.get());
+}
 
 void HostMonitor::add_observer(std::shared_ptr<HostMonitorObserver> observer)
 {
     pimpl_->add_observer(observer);
 }
 
+void HostMonitor::add_observer(std::shared_ptr<HostMonitorObserver> observer, Notifier& notifier)
+{
+    pimpl_->add_observer(observer, notifier.pimpl_.get());
+}
+
 void HostMonitor::del_observer(std::shared_ptr<HostMonitorObserver> observer)
 {
     pimpl_->del_observer(observer);
@@ -170,14 +403,29 @@ bool HostMonitor::is_available() const
     return pimpl_->is_available();
 }
 
+HostMonitor::State HostMonitor::get_state() const
+{
+    return pimpl_->get_state();
+}
+
+LatencyHistogram HostMonitor::get_latency() const
+{
+    return pimpl_->get_latency();
+}
+
 Endpoint const& HostMonitor::get_endpoint() const
 {
     return pimpl_->get_endpoint();
 }
 
-std::chrono::seconds const& HostMonitor::get_interval() const
+std::chrono::milliseconds const& HostMonitor::get_interval() const
 {
     return pimpl_->get_interval();
 }
 
+HostMonitor::Schedule const& HostMonitor::get_schedule() const
+{
+    return pimpl_->get_schedule();
+}
+
 } // namespace host_monitor
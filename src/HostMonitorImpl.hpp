@@ -0,0 +1,182 @@
+/**
+ * @file      HostMonitorImpl.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef HOSTMONITORIMPL_HPP_202610161200
+#define HOSTMONITORIMPL_HPP_202610161200
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+#include "HostMonitor.hpp"
+#include "SeqLock.hpp"
+#include "FlapDamper.hpp"
+#include "NotifierImpl.hpp"
+#include "StateJournalImpl.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief State of a HostMonitor.
+ * @note  Connection tests are executed by the MonitorEngine the monitor is
+ *        registered on. The engine reports each result via report().
+ */
+class HostMonitor::Impl : public std::enable_shared_from_this<HostMonitor::Impl>
+{
+public:
+    /**
+     * @brief Position of an endpoint in the dependency topology. Shared by the MonitorEngine
+     *        and the monitors of the endpoint, a node outlives all monitors reading it.
+     * @note  Monitors of the endpoint publish whether it is down, monitors of its children read it.
+     */
+    struct Node
+    {
+        std::atomic<std::size_t>    down = 0;  // Monitors of the endpoint seeing it down or unreachable
+        std::shared_ptr<Node const> parent;    // Node of the endpoint this one depends on, if any. Atomic access only.
+        std::size_t                 users = 0; // Monitors and dependencies referring to the node, guarded by the engine
+    };
+
+    Impl(Endpoint endpoint, Schedule schedule, Damping damping = Damping());
+
+    /**
+     * @brief Add an Observer to the monitor.
+     * @param[in] observer   The observer that should be added.
+     * @param[in] notifier   Notifier delivering state changes. nullptr to inform
+     *                       @p observer from the reporting context.
+     */
+    void add_observer(std::shared_ptr<HostMonitorObserver> observer, Notifier::Impl* notifier = nullptr);
+
+    void del_observer(std::shared_ptr<HostMonitorObserver> observer);
+
+    bool is_available() const;
+
+    State get_state() const;
+
+    LatencyHistogram get_latency() const;
+
+    Endpoint const& get_endpoint() const;
+
+    std::chrono::milliseconds const& get_interval() const;
+
+    Schedule const& get_schedule() const;
+
+    /**
+     * @brief Record state into a journal, start with the state recorded there.
+     * @note  Must be called before the first report(). Observers are not informed
+     *        about the recorded state, only about changes of it.
+     * @param[in] record   Journal record owned by the monitor. nullptr to record nothing.
+     * @param[in] seed     Recorded state of the endpoint, if any.
+     */
+    void attach_journal(StateJournal::Impl::Record* record, std::optional<StateJournal::Entry> const& seed);
+
+    /**
+     * @brief Stop recording state into the journal.
+     * @note  Must be called after retire().
+     * @returns record to hand back to the journal, nullptr if there is none.
+     */
+    StateJournal::Impl::Record* detach_journal();
+
+    /**
+     * @brief Publish availability to the dependency node of the endpoint, check the parent there.
+     * @note  Must be called before the first report(), after attach_journal().
+     * @param[in] node   Node of the endpoint. nullptr to ignore dependencies.
+     */
+    void attach_node(std::shared_ptr<Node> node);
+
+    /**
+     * @brief Stop processing results. Withdraws availability from the dependency node,
+     *        other monitors of the endpoint stay counted.
+     * @note  Waits for a report() running on another thread. Results reported afterwards
+     *        are dropped, the engine may still hold on to the monitor for a while.
+     *        Can be called from within an observer of the monitor.
+     */
+    void retire();
+
+    /**
+     * @brief Check if the endpoint this one depends on is down.
+     * @note  Doesn't wait for the engine. Called by the engine before each connection test.
+     * @returns true if tests are to be suppressed.
+     */
+    bool is_parent_down() const;
+
+    /**
+     * @brief Advance the schedule by the result of a connection test.
+     * @note  Must be called by the reporting thread, before report().
+     * @param[in] available   true if the endpoint was reachable.
+     * @returns duration until the next connection test.
+     */
+    std::chrono::milliseconds advance_schedule(bool available);
+
+    /**
+     * @brief Process the result of a connection test.
+     * @note  Observers are informed from the calling context on state changes.
+     *        Results of a monitor must be reported by one thread at a time.
+     * @param[in] available   true if the endpoint was reachable.
+     * @param[in] rtt         Duration of the connection test.
+     * @param[in] now         Time of the connection test, drives decay of the flap penalty.
+     */
+    void report( bool available, std::chrono::nanoseconds rtt
+               , FlapDamper::Clock::time_point now = FlapDamper::Clock::now());
+
+    /**
+     * @brief Process a connection test suppressed because the parent is down.
+     * @note  Observers are informed once on becoming unreachable. Same threading as report().
+     */
+    void report_unreachable();
+
+private:
+    // Registered observer
+    struct Registration
+    {
+        std::shared_ptr<HostMonitorObserver>       observer; // The observer
+        Notifier::Impl*                            notifier; // Notifier delivering state changes, if any
+        std::shared_ptr<Notifier::Impl::Counters>  counters; // Delivery counters, if delivered by a notifier
+    };
+
+    using ObserverVector = std::vector<Registration>;
+    using ObserverSnapshot = std::shared_ptr<ObserverVector const>;
+
+    // Replace observers_ by a modified copy
+    template <typename Modifier>
+    void update_observers(Modifier&& modify);
+
+    // Publish state_ to readers and the dependency node
+    void publish();
+
+    // Inform observers about a changed state_
+    void inform_observers();
+
+    Endpoint                    endpoint_;          // Endpoint: @See Endpoint.
+    Schedule                    schedule_;          // Timing of Connection Tests
+    std::chrono::milliseconds   stretched_;         // Current interval of a stable host, owned by the reporter
+    std::uint32_t               successes_;         // Successful tests in a row, owned by the reporter
+    std::uint32_t               failures_;          // Failed tests in a row, owned by the reporter
+    FlapDamper                  damper_;            // Hysteresis of the availability, owned by the reporter
+    State                       state_;             // State after the last connection test, owned by the reporter
+    SeqLock<State>              snapshot_;          // Copy of state_ published to readers
+    LatencyHistogram            latency_;           // Round-trip times of successful connection tests
+    ObserverSnapshot            observers_;         // Registered observers, immutable once published
+    std::mutex                  observers_mtx_;     // Lock for synchronizing access to observers_
+    std::atomic<std::uint64_t>  observers_version_; // Incremented on each change of observers_
+    ObserverSnapshot            reported_;          // Snapshot the reporter informs, owned by the reporter
+    std::uint64_t               reported_version_;  // Version of reported_
+    std::recursive_mutex        report_mtx_;        // Held while reporting. Observers may retire the monitor.
+    bool                        retired_;           // Results are dropped, guarded by report_mtx_
+    StateJournal::Impl::Record* journal_;           // Journal record of the endpoint, if any. Written by the reporter
+    std::shared_ptr<Node>       node_;              // Dependency node of the endpoint, if any. Written by the reporter
+    bool                        counted_down_;      // This monitor is counted as down by node_, owned by the reporter
+};
+
+} // namespace host_monitor
+
+#endif // HOSTMONITORIMPL_HPP_202610161200
@@ -0,0 +1,506 @@
+/**
+ * @file      HttpProbe.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <cerrno>
+#include <cctype>
+#include <charconv>
+#include <algorithm>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "HttpProbe.hpp"
+#include "TcpProbe.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Bytes received per read
+constexpr auto RECV_BUFFER = std::size_t(4096);
+
+std::string_view trim(std::string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+    {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t'))
+    {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+std::string to_lower(std::string_view s)
+{
+    auto lower = std::string(s);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [] (unsigned char c)
+    {
+        return static_cast<char>(std::tolower(c));
+    });
+    return lower;
+}
+
+// Check if an idle connection is still open: no data nor FIN must be pending
+bool is_usable(Socket const& sock)
+{
+    auto c = char();
+    return ::recv(sock.get(), &c, 1, MSG_PEEK | MSG_DONTWAIT) < 0
+        && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+} // anon namespace
+
+HttpResponseParser::HttpResponseParser(std::optional<std::string_view> body)
+    : search_(body)
+    , line_()
+    , tail_()
+    , state_(State::STATUS_LINE)
+    , header_bytes_(0)
+    , body_bytes_(0)
+    , remaining_(0)
+    , status_(0)
+    , matched_(!body || body->empty())
+    , keep_alive_(false)
+    , chunked_(false)
+    , length_()
+{
+}
+
+HttpResponseParser::Result HttpResponseParser::feed(std::string_view data)
+{
+    while (!data.empty())
+    {
+        switch (state_)
+        {
+            case State::STATUS_LINE:
+            case State::HEADERS:
+            case State::CHUNK_SIZE:
+            case State::CHUNK_END:
+            case State::TRAILERS:
+            {
+                auto nl = data.find('\n');
+                auto part = data.substr(0, nl);
+                if (state_ == State::STATUS_LINE || state_ == State::HEADERS)
+                {
+                    header_bytes_ += part.size() + 1;
+                }
+                if (MAX_HEADER < header_bytes_ || MAX_HEADER < line_.size() + part.size())
+                {
+                    return Result::INVALID;
+                }
+
+                line_.append(part);
+                if (nl == std::string_view::npos)
+                {
+                    return Result::INCOMPLETE;
+                }
+                data.remove_prefix(nl + 1);
+
+                auto line = std::string_view(line_);
+                if (!line.empty() && line.back() == '\r')
+                {
+                    line.remove_suffix(1);
+                }
+                auto valid = on_line(line);
+                line_.clear();
+                if (!valid)
+                {
+                    return Result::INVALID;
+                }
+                break;
+            }
+
+            case State::BODY:
+            case State::CHUNK_DATA:
+            case State::UNTIL_CLOSE:
+            {
+                auto n = data.size();
+                if (state_ != State::UNTIL_CLOSE)
+                {
+                    n = static_cast<std::size_t>(std::min<std::uint64_t>(n, remaining_));
+                    remaining_ -= n;
+                }
+                on_body(data.substr(0, n));
+                data.remove_prefix(n);
+
+                if (state_ != State::UNTIL_CLOSE && remaining_ == 0)
+                {
+                    state_ = (state_ == State::BODY) ? State::DONE : State::CHUNK_END;
+                }
+
+                // Don't read huge bodies, the connection is dropped instead
+                if (MAX_BODY <= body_bytes_ && state_ != State::DONE)
+                {
+                    keep_alive_ = false;
+                    state_ = State::DONE;
+                }
+                break;
+            }
+
+            case State::DONE:
+                // Unexpected data, the state of the connection is unknown
+                keep_alive_ = false;
+                return Result::COMPLETE;
+        }
+    }
+    return (state_ == State::DONE) ? Result::COMPLETE : Result::INCOMPLETE;
+}
+
+HttpResponseParser::Result HttpResponseParser::finish()
+{
+    keep_alive_ = false;
+    if (state_ == State::UNTIL_CLOSE)
+    {
+        state_ = State::DONE;
+    }
+    return (state_ == State::DONE) ? Result::COMPLETE : Result::INVALID;
+}
+
+std::uint16_t HttpResponseParser::get_status() const
+{
+    return status_;
+}
+
+bool HttpResponseParser::is_body_matched() const
+{
+    return matched_;
+}
+
+bool HttpResponseParser::is_keep_alive() const
+{
+    return state_ == State::DONE && keep_alive_;
+}
+
+bool HttpResponseParser::on_line(std::string_view line)
+{
+    switch (state_)
+    {
+        case State::STATUS_LINE:
+        {
+            // "HTTP/1.x SSS reason"
+            if (line.size() < 12 || line.substr(0, 7) != "HTTP/1." || line[8] != ' ')
+            {
+                return false;
+            }
+
+            auto status = 0;
+            auto const* end = line.data() + 12;
+            auto [ptr, ec] = std::from_chars(line.data() + 9, end, status);
+            if (ec != std::errc() || ptr != end || status < 100)
+            {
+                return false;
+            }
+
+            // HTTP/1.1 connections persist by default, HTTP/1.0 ones don't
+            status_ = static_cast<std::uint16_t>(status);
+            keep_alive_ = (line[7] == '1');
+            state_ = State::HEADERS;
+            return true;
+        }
+
+        case State::HEADERS:
+        {
+            if (line.empty())
+            {
+                on_headers_end();
+                return true;
+            }
+
+            auto colon = line.find(':');
+            if (colon == std::string_view::npos)
+            {
+                return false;
+            }
+            return on_header(trim(line.substr(0, colon)), trim(line.substr(colon + 1)));
+        }
+
+        case State::CHUNK_SIZE:
+        {
+            // Chunk extensions after ';' are ignored
+            auto size_str = trim(line.substr(0, line.find(';')));
+            auto size = std::uint64_t(0);
+            auto const* end = size_str.data() + size_str.size();
+            auto [ptr, ec] = std::from_chars(size_str.data(), end, size, 16);
+            if (size_str.empty() || ec != std::errc() || ptr != end)
+            {
+                return false;
+            }
+
+            remaining_ = size;
+            state_ = (size == 0) ? State::TRAILERS : State::CHUNK_DATA;
+            return true;
+        }
+
+        case State::CHUNK_END:
+            state_ = State::CHUNK_SIZE;
+            return line.empty();
+
+        case State::TRAILERS:
+            if (line.empty())
+            {
+                state_ = State::DONE;
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool HttpResponseParser::on_header(std::string_view name, std::string_view value)
+{
+    auto lower_name = to_lower(name);
+    if (lower_name == "content-length")
+    {
+        auto length = std::uint64_t(0);
+        auto const* end = value.data() + value.size();
+        auto [ptr, ec] = std::from_chars(value.data(), end, length);
+        if (value.empty() || ec != std::errc() || ptr != end)
+        {
+            return false;
+        }
+        length_ = length;
+    }
+    else if (lower_name == "transfer-encoding")
+    {
+        // Chunked must be the final encoding
+        auto lower_value = to_lower(value);
+        chunked_ = lower_value.size() >= 7 && lower_value.compare(lower_value.size() - 7, 7, "chunked") == 0;
+    }
+    else if (lower_name == "connection")
+    {
+        auto lower_value = to_lower(value);
+        if (lower_value.find("close") != std::string::npos)
+        {
+            keep_alive_ = false;
+        }
+        else if (lower_value.find("keep-alive") != std::string::npos)
+        {
+            keep_alive_ = true;
+        }
+    }
+    return true;
+}
+
+void HttpResponseParser::on_headers_end()
+{
+    // Interim responses precede the final one
+    if (status_ < 200)
+    {
+        status_ = 0;
+        chunked_ = false;
+        length_.reset();
+        state_ = State::STATUS_LINE;
+        return;
+    }
+
+    if (status_ == 204 || status_ == 304)
+    {
+        state_ = State::DONE;
+    }
+    else if (chunked_)
+    {
+        state_ = State::CHUNK_SIZE;
+    }
+    else if (length_)
+    {
+        remaining_ = *length_;
+        state_ = (remaining_ == 0) ? State::DONE : State::BODY;
+    }
+    else
+    {
+        keep_alive_ = false;
+        state_ = State::UNTIL_CLOSE;
+    }
+}
+
+void HttpResponseParser::on_body(std::string_view data)
+{
+    body_bytes_ += data.size();
+    if (matched_ || data.empty())
+    {
+        return;
+    }
+
+    // Keep the last bytes, the searched text might continue in the next chunk
+    tail_.append(data);
+    if (tail_.find(*search_) != std::string::npos)
+    {
+        matched_ = true;
+        tail_.clear();
+        return;
+    }
+
+    auto keep = search_->size() - 1;
+    if (keep < tail_.size())
+    {
+        tail_.erase(0, tail_.size() - keep);
+    }
+}
+
+HttpProbe::HttpProbe( Address                         address
+                    , std::string_view                host
+                    , std::string_view                path
+                    , std::uint16_t                   status
+                    , std::optional<std::string_view> body
+                    , Socket*                         idle)
+    : address_(std::move(address))
+    , request_()
+    , sent_(0)
+    , status_(status)
+    , parser_(body)
+    , idle_(idle)
+    , sock_()
+    , state_(State::CONNECTING)
+    , reused_(false)
+    , received_(false)
+{
+    request_.append("GET ").append(path).append(" HTTP/1.1\r\n");
+    request_.append("Host: ").append(host).append("\r\n");
+    request_.append("User-Agent: host_monitor\r\n");
+    request_.append("Accept: */*\r\n");
+    request_.append(idle_ ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
+    request_.append("\r\n");
+}
+
+Probe::Status HttpProbe::start()
+{
+    if (idle_ && idle_->is_valid())
+    {
+        auto idle = std::move(*idle_);
+        if (is_usable(idle))
+        {
+            sock_ = std::move(idle);
+            reused_ = true;
+            state_ = State::SENDING;
+            return send();
+        }
+    }
+    return connect();
+}
+
+int HttpProbe::get_fd() const
+{
+    return sock_.get();
+}
+
+std::uint32_t HttpProbe::get_events() const
+{
+    return (state_ == State::RECEIVING) ? POLLIN : POLLOUT;
+}
+
+Probe::Status HttpProbe::on_event(std::uint32_t)
+{
+    switch (state_)
+    {
+        case State::CONNECTING:
+            if (!tcp_connect_finish(sock_))
+            {
+                return Status::DOWN;
+            }
+            state_ = State::SENDING;
+            return send();
+
+        case State::SENDING:
+            return send();
+
+        case State::RECEIVING:
+            return receive();
+    }
+    return Status::DOWN;
+}
+
+Probe::Status HttpProbe::connect()
+{
+    // The new socket is created before the old one is closed. Its descriptor
+    // number must differ, the old one might still be registered for polling.
+    auto sock = tcp_connect_start(address_);
+    sock_ = std::move(sock);
+    sent_ = 0;
+    state_ = State::CONNECTING;
+    return sock_.is_valid() ? Status::PENDING : Status::DOWN;
+}
+
+Probe::Status HttpProbe::send()
+{
+    while (sent_ < request_.size())
+    {
+        auto n = ::send(sock_.get(), request_.data() + sent_, request_.size() - sent_, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? Status::PENDING : retry_or_fail();
+        }
+        sent_ += static_cast<std::size_t>(n);
+    }
+
+    state_ = State::RECEIVING;
+    return Status::PENDING;
+}
+
+Probe::Status HttpProbe::receive()
+{
+    auto buffer = std::array<char, RECV_BUFFER>();
+    auto n = ::recv(sock_.get(), buffer.data(), buffer.size(), 0);
+    if (n < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? Status::PENDING : retry_or_fail();
+    }
+
+    auto result = HttpResponseParser::Result::INCOMPLETE;
+    if (n == 0)
+    {
+        if (!received_)
+        {
+            return retry_or_fail();
+        }
+        result = parser_.finish();
+    }
+    else
+    {
+        received_ = true;
+        result = parser_.feed(std::string_view(buffer.data(), static_cast<std::size_t>(n)));
+    }
+
+    switch (result)
+    {
+        case HttpResponseParser::Result::INCOMPLETE:
+            return Status::PENDING;
+
+        case HttpResponseParser::Result::INVALID:
+            return Status::DOWN;
+
+        case HttpResponseParser::Result::COMPLETE:
+            break;
+    }
+
+    // Park the connection for the next probe
+    if (idle_ && parser_.is_keep_alive())
+    {
+        *idle_ = std::move(sock_);
+    }
+    return (parser_.get_status() == status_ && parser_.is_body_matched()) ? Status::UP : Status::DOWN;
+}
+
+Probe::Status HttpProbe::retry_or_fail()
+{
+    // A reused connection might have been closed by the server while idle
+    if (reused_ && !received_)
+    {
+        reused_ = false;
+        return connect();
+    }
+    return Status::DOWN;
+}
+
+} // namespace host_monitor
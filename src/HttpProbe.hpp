@@ -0,0 +1,189 @@
+/**
+ * @file      HttpProbe.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef HTTPPROBE_HPP_202610162300
+#define HTTPPROBE_HPP_202610162300
+
+#include <string>
+#include <optional>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+#include "Probe.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Incremental parser of a single HTTP/1.x response.
+ * @note  Data can be fed in chunks of any size. Only the current header line
+ *        and a tail of the body as long as the searched text are buffered.
+ *        Bodies are delimited by Content-Length, chunked transfer encoding or
+ *        the end of the connection. Interim (1xx) responses are skipped.
+ */
+class HttpResponseParser
+{
+public:
+    /// @brief Maximum size of the status line and all header lines.
+    static constexpr std::size_t MAX_HEADER = 8192;
+
+    /// @brief Body bytes parsed at most. Larger responses complete early and can't be reused.
+    static constexpr std::size_t MAX_BODY = 1024 * 1024;
+
+    /// @brief Parser state after feeding data.
+    enum class Result
+    {
+        INCOMPLETE = 0, ///< More data is needed.
+        COMPLETE,       ///< The response was parsed.
+        INVALID,        ///< The response is malformed or exceeds MAX_HEADER.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] body   Text the body is searched for. Must outlive the parser. None to skip the search.
+     */
+    explicit HttpResponseParser(std::optional<std::string_view> body = std::nullopt);
+
+    /**
+     * @brief Parse the next chunk of the response.
+     * @param[in] data   Received data.
+     * @returns COMPLETE once the response ended. Data beyond its end disables keep-alive.
+     */
+    Result feed(std::string_view data);
+
+    /**
+     * @brief Signal the end of the connection.
+     * @returns COMPLETE if the response was delimited by the connection end, INVALID otherwise.
+     */
+    Result finish();
+
+    /**
+     * @brief Get status code.
+     * @returns status code of the final response. 0 until its status line was parsed.
+     */
+    std::uint16_t get_status() const;
+
+    /**
+     * @brief Check if the body contains the searched text.
+     * @returns true if the text was found or no text is searched for.
+     */
+    bool is_body_matched() const;
+
+    /**
+     * @brief Check if the connection can carry another request after the response.
+     * @returns true for complete HTTP/1.1 responses, not asking to close the connection.
+     */
+    bool is_keep_alive() const;
+
+private:
+    enum class State
+    {
+        STATUS_LINE = 0, // Waiting for the status line
+        HEADERS,         // Waiting for header lines
+        BODY,            // Body of known length
+        CHUNK_SIZE,      // Chunk size line of a chunked body
+        CHUNK_DATA,      // Chunk data
+        CHUNK_END,       // CRLF after chunk data
+        TRAILERS,        // Trailer lines after the last chunk
+        UNTIL_CLOSE,     // Body delimited by the end of the connection
+        DONE,            // Response complete
+    };
+
+    bool on_line(std::string_view line);
+
+    bool on_header(std::string_view name, std::string_view value);
+
+    void on_headers_end();
+
+    void on_body(std::string_view data);
+
+    std::optional<std::string_view> search_;        // Text searched in the body
+    std::string                     line_;          // Incomplete line
+    std::string                     tail_;          // Body tail, a match may span chunks
+    State                           state_;         // Parser state
+    std::size_t                     header_bytes_;  // Bytes of status and header lines
+    std::size_t                     body_bytes_;    // Body bytes parsed
+    std::uint64_t                   remaining_;     // Bytes left of the body or the current chunk
+    std::uint16_t                   status_;        // Status code
+    bool                            matched_;       // Searched text was found
+    bool                            keep_alive_;    // Connection can be reused
+    bool                            chunked_;       // Chunked transfer encoding
+    std::optional<std::uint64_t>    length_;        // Content-Length
+};
+
+/**
+ * @brief Probe sending an HTTP GET request and checking the response.
+ * @note  Connections are kept alive: a connection left over by the previous
+ *        probe of the same monitor is reused, a check costs a single round trip.
+ *        Stale connections closed by the server are replaced by a new one.
+ */
+class HttpProbe : public Probe
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] address   Resolved address of the target, including the port.
+     * @param[in] host      Value of the Host header.
+     * @param[in] path      Request path.
+     * @param[in] status    Expected status code.
+     * @param[in] body      Text the body must contain. Must outlive the probe.
+     * @param[in] idle      Slot holding the idle connection between probes. nullptr
+     *                      to close the connection after the response.
+     */
+    HttpProbe( Address                         address
+             , std::string_view                host
+             , std::string_view                path
+             , std::uint16_t                   status
+             , std::optional<std::string_view> body
+             , Socket*                         idle);
+
+    Status start() override;
+
+    int get_fd() const override;
+
+    std::uint32_t get_events() const override;
+
+    Status on_event(std::uint32_t events) override;
+
+private:
+    enum class State
+    {
+        CONNECTING = 0, // Waiting for the connection
+        SENDING,        // Sending the request
+        RECEIVING,      // Receiving the response
+    };
+
+    Status connect();
+
+    Status send();
+
+    Status receive();
+
+    Status retry_or_fail();
+
+    Address            address_;  // Target address
+    std::string        request_;  // Serialized request
+    std::size_t        sent_;     // Request bytes sent
+    std::uint16_t      status_;   // Expected status code
+    HttpResponseParser parser_;   // Response parser
+    Socket*            idle_;     // Slot of the idle connection
+    Socket             sock_;     // Connection
+    State              state_;    // Probe state
+    bool               reused_;   // Connection was taken from the slot
+    bool               received_; // Response data was received
+};
+
+} // namespace host_monitor
+
+#endif // HTTPPROBE_HPP_202610162300
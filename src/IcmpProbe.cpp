@@ -0,0 +1,270 @@
+/**
+ * @file      IcmpProbe.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <atomic>
+#include <array>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+
+#include <netinet/in.h>
+#include <netinet/icmp6.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "IcmpProbe.hpp"
+#include "IcmpTransport.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// ICMP message types used for echo requests and replies
+std::uint8_t const ICMPV4_ECHO_REQUEST = 8;
+std::uint8_t const ICMPV4_ECHO_REPLY   = 0;
+std::uint8_t const ICMPV6_ECHO_REQUEST = 128;
+std::uint8_t const ICMPV6_ECHO_REPLY   = 129;
+
+// Header shared by ICMPv4 and ICMPv6 echo messages
+struct EchoHeader
+{
+    std::uint8_t  type;
+    std::uint8_t  code;
+    std::uint16_t checksum;
+    std::uint16_t identifier;
+    std::uint16_t sequence;
+};
+
+// Sequence numbers are process wide, that keeps concurrent probes apart
+std::atomic<std::uint16_t> next_sequence(0);
+
+std::uint16_t checksum(std::uint8_t const* data, std::size_t len)
+{
+    auto sum = std::uint32_t(0);
+    for (auto i = std::size_t(0); i + 1 < len; i += 2)
+    {
+        auto word = std::uint16_t();
+        std::memcpy(&word, data + i, sizeof(word));
+        sum += word;
+    }
+
+    if (len % 2)
+    {
+        sum += data[len - 1];
+    }
+
+    while (sum >> 16)
+    {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return static_cast<std::uint16_t>(~sum);
+}
+} // anon namespace
+
+bool is_raw_socket(int fd)
+{
+    auto type = 0;
+    auto len = socklen_t(sizeof(type));
+    getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len);
+    return type == SOCK_RAW;
+}
+
+void build_echo_request( std::uint8_t* buffer, int family
+                       , std::uint16_t identifier, std::uint16_t sequence)
+{
+    auto v6 = (family == AF_INET6);
+
+    auto hdr = EchoHeader();
+    hdr.type = v6 ? ICMPV6_ECHO_REQUEST : ICMPV4_ECHO_REQUEST;
+    hdr.code = 0;
+    hdr.checksum = 0;
+    hdr.identifier = htons(identifier);
+    hdr.sequence = htons(sequence);
+
+    std::memcpy(buffer, &hdr, sizeof(hdr));
+    for (auto i = sizeof(hdr); i < ICMP_ECHO_SIZE; ++i)
+    {
+        buffer[i] = static_cast<std::uint8_t>(i);
+    }
+
+    // ICMPv6 checksums are computed by the kernel
+    if (!v6)
+    {
+        hdr.checksum = checksum(buffer, ICMP_ECHO_SIZE);
+        std::memcpy(buffer, &hdr, sizeof(hdr));
+    }
+}
+
+std::optional<EchoReply> parse_echo_reply( std::uint8_t const* buffer, std::size_t len
+                                         , int family, bool raw)
+{
+    auto v6 = (family == AF_INET6);
+
+    // Raw ICMPv4 sockets deliver the IP header as well
+    auto offset = std::size_t(0);
+    if (raw && !v6 && len > 0)
+    {
+        offset = static_cast<std::size_t>(buffer[0] & 0x0F) * 4;
+    }
+
+    if (len < offset + sizeof(EchoHeader))
+    {
+        return std::nullopt;
+    }
+
+    auto hdr = EchoHeader();
+    std::memcpy(&hdr, buffer + offset, sizeof(hdr));
+    if (hdr.type != (v6 ? ICMPV6_ECHO_REPLY : ICMPV4_ECHO_REPLY))
+    {
+        return std::nullopt;
+    }
+
+    auto reply = EchoReply();
+    reply.identifier = ntohs(hdr.identifier);
+    reply.sequence = ntohs(hdr.sequence);
+    return reply;
+}
+
+Socket open_icmp_socket(int family)
+{
+    auto proto = (family == AF_INET6) ? int(IPPROTO_ICMPV6) : int(IPPROTO_ICMP);
+    auto flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+
+    // Prefer unprivileged ping sockets, fall back to raw sockets
+    auto sock = Socket(::socket(family, SOCK_DGRAM | flags, proto));
+    if (sock.is_valid())
+    {
+        return sock;
+    }
+
+    sock = Socket(::socket(family, SOCK_RAW | flags, proto));
+    if (sock.is_valid() && family == AF_INET6)
+    {
+        // Raw ICMPv6 sockets receive every ICMPv6 message. Pass echo replies only.
+        auto filter = icmp6_filter();
+        ICMP6_FILTER_SETBLOCKALL(&filter);
+        ICMP6_FILTER_SETPASS(ICMPV6_ECHO_REPLY, &filter);
+        setsockopt(sock.get(), IPPROTO_ICMPV6, ICMP6_FILTER, &filter, sizeof(filter));
+    }
+    return sock;
+}
+
+IcmpProbe::IcmpProbe(Address address)
+    : address_(std::move(address))
+    , sock_()
+    , raw_(false)
+    , identifier_(static_cast<std::uint16_t>(::getpid()))
+    , sequence_(next_sequence++)
+    , transport_(nullptr)
+    , token_(0)
+    , key_()
+{
+}
+
+IcmpProbe::IcmpProbe(Address address, IcmpTransport& transport, std::uint64_t token)
+    : address_(std::move(address))
+    , sock_()
+    , raw_(false)
+    , identifier_(0)
+    , sequence_(0)
+    , transport_(&transport)
+    , token_(token)
+    , key_()
+{
+}
+
+IcmpProbe::~IcmpProbe()
+{
+    // Unanswered requests must not be reported later on
+    if (transport_ && key_)
+    {
+        transport_->cancel(*key_);
+    }
+}
+
+Probe::Status IcmpProbe::start()
+{
+    // Shared transport: the request is sent with the next batch
+    if (transport_)
+    {
+        key_ = transport_->submit(address_, token_);
+        return key_ ? Status::PENDING : Status::DOWN;
+    }
+
+    sock_ = open_icmp_socket(address_.family());
+    if (!sock_.is_valid())
+    {
+        return Status::DOWN;
+    }
+
+    // Datagram sockets get their identifier assigned by the kernel.
+    // Raw sockets see all replies and must filter by identifier.
+    raw_ = is_raw_socket(sock_.get());
+
+    auto packet = std::array<std::uint8_t, ICMP_ECHO_SIZE>();
+    build_echo_request(packet.data(), address_.family(), identifier_, sequence_);
+
+    auto sent = ::sendto( sock_.get(), packet.data(), packet.size(), 0
+                        , address_.get(), address_.length);
+    if (sent < 0)
+    {
+        return Status::DOWN;
+    }
+    return Status::PENDING;
+}
+
+int IcmpProbe::get_fd() const
+{
+    // Replies on the shared transport are dispatched by its owner
+    return transport_ ? -1 : sock_.get();
+}
+
+std::uint32_t IcmpProbe::get_events() const
+{
+    return POLLIN;
+}
+
+Probe::Status IcmpProbe::on_event(std::uint32_t)
+{
+    // Consume everything queued, the matching reply might not be the first message
+    auto buffer = std::array<std::uint8_t, 1500>();
+    while (true)
+    {
+        auto len = ::recv(sock_.get(), buffer.data(), buffer.size(), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // Queue drained, or an ICMP error (e.g. unreachable) was reported
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? Status::PENDING
+                                                             : Status::DOWN;
+        }
+
+        auto reply = parse_echo_reply( buffer.data(), static_cast<std::size_t>(len)
+                                     , address_.family(), raw_);
+        if (!reply || reply->sequence != sequence_)
+        {
+            continue;
+        }
+
+        if (raw_ && reply->identifier != identifier_)
+        {
+            continue;
+        }
+        return Status::UP;
+    }
+}
+
+} // namespace host_monitor
@@ -0,0 +1,118 @@
+/**
+ * @file      IcmpProbe.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef ICMPPROBE_HPP_202610161020
+#define ICMPPROBE_HPP_202610161020
+
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+#include "Probe.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+class IcmpTransport;
+
+/// @brief Size of echo requests in bytes: 8 byte header, 32 byte payload.
+inline constexpr std::size_t ICMP_ECHO_SIZE = 40;
+
+/// @brief Fields identifying the request an echo reply answers.
+struct EchoReply
+{
+    std::uint16_t identifier; ///< Identifier, host byte order.
+    std::uint16_t sequence;   ///< Sequence number, host byte order.
+};
+
+/**
+ * @brief Open a socket suitable to send ICMP echo requests.
+ * @note  Unprivileged datagram sockets (see net.ipv4.ping_group_range) are
+ *        preferred. Raw sockets are used as fallback.
+ * @param[in] family   AF_INET or AF_INET6.
+ * @returns The opened socket. Invalid in case no socket could be opened.
+ */
+Socket open_icmp_socket(int family);
+
+/**
+ * @brief Check if a socket is a raw socket.
+ * @param[in] fd   The socket to check.
+ * @returns true if @p fd is a raw socket, false if not.
+ */
+bool is_raw_socket(int fd);
+
+/**
+ * @brief Build an echo request.
+ * @param[out] buffer       Buffer of at least ICMP_ECHO_SIZE bytes.
+ * @param[in]  family       Address family the request is sent to.
+ * @param[in]  identifier   Identifier, host byte order.
+ * @param[in]  sequence     Sequence number, host byte order.
+ */
+void build_echo_request( std::uint8_t* buffer, int family
+                       , std::uint16_t identifier, std::uint16_t sequence);
+
+/**
+ * @brief Parse a received ICMP message.
+ * @param[in] buffer   The received message.
+ * @param[in] len      Length of @p buffer.
+ * @param[in] family   Address family of the receiving socket.
+ * @param[in] raw      true if the receiving socket is a raw socket.
+ * @returns identifier and sequence number if @p buffer holds an echo reply.
+ */
+std::optional<EchoReply> parse_echo_reply( std::uint8_t const* buffer, std::size_t len
+                                         , int family, bool raw);
+
+/// @brief Probe sending a single ICMP echo request and waiting for the matching reply.
+class IcmpProbe : public Probe
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] address   Resolved address of the target.
+     */
+    explicit IcmpProbe(Address address);
+
+    /**
+     * @brief Constructor for probes sharing a transport.
+     * @note  The owner of @p transport dispatches replies by @p token.
+     *        get_fd() returns -1 and on_event() is not used.
+     * @param[in] address     Resolved address of the target.
+     * @param[in] transport   Transport to send the echo request with.
+     * @param[in] token       Token the reply is reported with.
+     */
+    IcmpProbe(Address address, IcmpTransport& transport, std::uint64_t token);
+
+    ~IcmpProbe() override;
+
+    Status start() override;
+
+    int get_fd() const override;
+
+    std::uint32_t get_events() const override;
+
+    Status on_event(std::uint32_t events) override;
+
+private:
+    Address                      address_;    // Target address
+    Socket                       sock_;       // Socket the echo request was sent on
+    bool                         raw_;        // Raw sockets must filter replies by identifier
+    std::uint16_t                identifier_; // Identifier of the echo request
+    std::uint16_t                sequence_;   // Sequence number of the echo request
+    IcmpTransport*               transport_;  // Shared transport, nullptr if the probe owns its socket
+    std::uint64_t                token_;      // Token the shared transport reports the reply with
+    std::optional<std::uint32_t> key_;        // Key of the request submitted to the shared transport
+};
+
+} // namespace host_monitor
+
+#endif // ICMPPROBE_HPP_202610161020
@@ -0,0 +1,266 @@
+/**
+ * @file      IcmpTransport.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "IcmpTransport.hpp"
+#include "IcmpProbe.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Messages per sendmmsg / recvmmsg call
+std::size_t const BATCH_SIZE = 64;
+
+// Receive buffer per message: IPv4 header with options, echo header and payload
+std::size_t const REPLY_SIZE = 60 + ICMP_ECHO_SIZE;
+
+// Requests are told apart by their 16 bit sequence number. Datagram sockets get
+// their identifier assigned by the kernel, raw sockets use the process identifier.
+std::size_t const KEYS = std::size_t(1) << 16;
+
+// Socket buffer size. Replies to a burst of requests arrive at once.
+int const BUFFER_SIZE = 4 * 1024 * 1024;
+
+void set_buffer_size(int fd, int force_option, int option)
+{
+    // Exceeding net.core.[rw]mem_max requires CAP_NET_ADMIN
+    if (setsockopt(fd, SOL_SOCKET, force_option, &BUFFER_SIZE, sizeof(BUFFER_SIZE)) != 0)
+    {
+        setsockopt(fd, SOL_SOCKET, option, &BUFFER_SIZE, sizeof(BUFFER_SIZE));
+    }
+}
+
+// Check if a reply from @p source answers a request to @p target. Ports don't matter.
+bool is_same_host(Address const& target, sockaddr_storage const& source)
+{
+    if (target.storage.ss_family != source.ss_family)
+    {
+        return false;
+    }
+
+    if (source.ss_family == AF_INET)
+    {
+        auto const& a = reinterpret_cast<sockaddr_in const&>(target.storage);
+        auto const& b = reinterpret_cast<sockaddr_in const&>(source);
+        return a.sin_addr.s_addr == b.sin_addr.s_addr;
+    }
+
+    auto const& a = reinterpret_cast<sockaddr_in6 const&>(target.storage);
+    auto const& b = reinterpret_cast<sockaddr_in6 const&>(source);
+    return std::memcmp(&a.sin6_addr, &b.sin6_addr, sizeof(a.sin6_addr)) == 0;
+}
+} // anon namespace
+
+IcmpTransport::IcmpTransport(int family)
+    : family_(family)
+    , sock_(open_icmp_socket(family))
+    , raw_(sock_.is_valid() && is_raw_socket(sock_.get()))
+    , base_(static_cast<std::uint16_t>(::getpid()))
+    , next_key_(0)
+    , pending_()
+    , queued_()
+{
+    if (sock_.is_valid())
+    {
+        set_buffer_size(sock_.get(), SO_RCVBUFFORCE, SO_RCVBUF);
+        set_buffer_size(sock_.get(), SO_SNDBUFFORCE, SO_SNDBUF);
+    }
+}
+
+bool IcmpTransport::is_valid() const
+{
+    return sock_.is_valid();
+}
+
+int IcmpTransport::get_fd() const
+{
+    return sock_.get();
+}
+
+std::uint32_t IcmpTransport::get_events() const
+{
+    return queued_.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+}
+
+std::optional<std::uint32_t> IcmpTransport::submit(Address const& address, std::uint64_t token)
+{
+    if (!is_valid() || pending_.size() >= KEYS)
+    {
+        return std::nullopt;
+    }
+
+    // Skip keys still in use by long running requests. The identifier
+    // of raw sockets never changes, sequences wrap around.
+    auto key = std::uint32_t();
+    do
+    {
+        key = raw_ ? (std::uint32_t(base_) << 16) | (next_key_ & 0xFFFF)
+                   : (next_key_ & 0xFFFF);
+        next_key_ += 1;
+    }
+    while (pending_.count(key) != 0);
+
+    pending_.emplace(key, Pending{token, address});
+    queued_.push_back(Request{address, key});
+    return key;
+}
+
+void IcmpTransport::cancel(std::uint32_t key)
+{
+    // Queued requests of cancelled keys are skipped on flush
+    pending_.erase(key);
+}
+
+void IcmpTransport::flush(std::vector<std::uint64_t>& failed)
+{
+    auto packets = std::array<std::array<std::uint8_t, ICMP_ECHO_SIZE>, BATCH_SIZE>();
+    auto iovs = std::array<iovec, BATCH_SIZE>();
+    auto msgs = std::array<mmsghdr, BATCH_SIZE>();
+
+    auto done = std::size_t(0);
+    while (done < queued_.size())
+    {
+        // Assemble the next batch. Cancelled requests are dropped.
+        auto count = std::size_t(0);
+        auto batch = std::array<Request*, BATCH_SIZE>();
+        for (; done < queued_.size() && count < BATCH_SIZE; ++done)
+        {
+            auto& request = queued_[done];
+            if (pending_.count(request.key) == 0)
+            {
+                continue;
+            }
+
+            auto identifier = static_cast<std::uint16_t>(request.key >> 16);
+            auto sequence = static_cast<std::uint16_t>(request.key & 0xFFFF);
+            build_echo_request(packets[count].data(), family_, identifier, sequence);
+
+            iovs[count].iov_base = packets[count].data();
+            iovs[count].iov_len = ICMP_ECHO_SIZE;
+            msgs[count] = mmsghdr();
+            msgs[count].msg_hdr.msg_name = &request.address.storage;
+            msgs[count].msg_hdr.msg_namelen = request.address.length;
+            msgs[count].msg_hdr.msg_iov = &iovs[count];
+            msgs[count].msg_hdr.msg_iovlen = 1;
+            batch[count] = &request;
+            count += 1;
+        }
+
+        // Send the batch. A failed message ends the call, report and skip it.
+        auto sent = std::size_t(0);
+        while (sent < count)
+        {
+            auto ret = ::sendmmsg( sock_.get(), msgs.data() + sent
+                                 , static_cast<unsigned>(count - sent), 0);
+            if (ret >= 0)
+            {
+                sent += static_cast<std::size_t>(ret);
+                continue;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+            {
+                // Socket buffer is full, retry the remaining requests later
+                queued_.erase(queued_.begin(), queued_.begin() + (batch[sent] - queued_.data()));
+                return;
+            }
+
+            auto key = batch[sent]->key;
+            failed.push_back(pending_.at(key).token);
+            pending_.erase(key);
+            sent += 1;
+        }
+    }
+    queued_.clear();
+}
+
+void IcmpTransport::receive(std::vector<std::uint64_t>& replied)
+{
+    auto buffers = std::array<std::array<std::uint8_t, REPLY_SIZE>, BATCH_SIZE>();
+    auto sources = std::array<sockaddr_storage, BATCH_SIZE>();
+    auto iovs = std::array<iovec, BATCH_SIZE>();
+    auto msgs = std::array<mmsghdr, BATCH_SIZE>();
+
+    while (true)
+    {
+        for (auto i = std::size_t(0); i < BATCH_SIZE; ++i)
+        {
+            iovs[i].iov_base = buffers[i].data();
+            iovs[i].iov_len = buffers[i].size();
+            msgs[i] = mmsghdr();
+            msgs[i].msg_hdr.msg_name = &sources[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sources[i]);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        auto ret = ::recvmmsg( sock_.get(), msgs.data(), static_cast<unsigned>(BATCH_SIZE)
+                             , MSG_DONTWAIT, nullptr);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // Drained. Errors on a shared socket can't be assigned to a
+            // request, affected requests run into their deadline.
+            return;
+        }
+
+        for (auto i = std::size_t(0); i < static_cast<std::size_t>(ret); ++i)
+        {
+            auto reply = parse_echo_reply(buffers[i].data(), msgs[i].msg_len, family_, raw_);
+            if (!reply)
+            {
+                continue;
+            }
+
+            // Replies to other processes and to cancelled requests are unknown.
+            // Replies from other hosts don't answer a request, even with a matching key.
+            auto key = raw_ ? (std::uint32_t(reply->identifier) << 16) | reply->sequence
+                            : std::uint32_t(reply->sequence);
+            auto it = pending_.find(key);
+            if (it != pending_.end() && is_same_host(it->second.address, sources[i]))
+            {
+                replied.push_back(it->second.token);
+                pending_.erase(it);
+            }
+        }
+
+        if (static_cast<std::size_t>(ret) < BATCH_SIZE)
+        {
+            return;
+        }
+    }
+}
+
+std::size_t IcmpTransport::get_pending_count() const
+{
+    return pending_.size();
+}
+
+} // namespace host_monitor
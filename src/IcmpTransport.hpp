@@ -0,0 +1,127 @@
+/**
+ * @file      IcmpTransport.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef ICMPTRANSPORT_HPP_202610161420
+#define ICMPTRANSPORT_HPP_202610161420
+
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Single ICMP socket shared by many echo requests of one address family.
+ * @note  Requests are queued and sent in batches with sendmmsg(2), replies are
+ *        received in batches with recvmmsg(2). Replies are matched to their
+ *        request by (identifier, sequence) in constant time and must originate
+ *        from the requested address. Not thread-safe.
+ */
+class IcmpTransport
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] family   Address family, AF_INET or AF_INET6.
+     */
+    explicit IcmpTransport(int family);
+
+    /**
+     * @brief Check if the socket could be opened.
+     * @returns true if the transport is usable.
+     */
+    bool is_valid() const;
+
+    /**
+     * @brief Get the shared socket.
+     * @returns file descriptor to wait on.
+     */
+    int get_fd() const;
+
+    /**
+     * @brief Get events to wait for.
+     * @returns EPOLLIN, plus EPOLLOUT while requests wait for socket buffer space.
+     */
+    std::uint32_t get_events() const;
+
+    /**
+     * @brief Queue an echo request. It is sent on the next flush().
+     * @param[in] address   Target address. Must match the transports family.
+     * @param[in] token     Token identifying the request towards the caller.
+     * @returns key of the request, std::nullopt if no key is available.
+     */
+    std::optional<std::uint32_t> submit(Address const& address, std::uint64_t token);
+
+    /**
+     * @brief Cancel a request. Its reply is dropped. Unknown keys are ignored.
+     * @param[in] key   Key returned by submit().
+     */
+    void cancel(std::uint32_t key);
+
+    /**
+     * @brief Send queued requests.
+     * @param[out] failed   Tokens of requests that could not be sent.
+     */
+    void flush(std::vector<std::uint64_t>& failed);
+
+    /**
+     * @brief Receive all queued replies.
+     * @param[out] replied   Tokens of answered requests.
+     */
+    void receive(std::vector<std::uint64_t>& replied);
+
+    /**
+     * @brief Get number of requests waiting for a reply.
+     * @returns number of submitted, not yet answered or cancelled requests.
+     */
+    std::size_t get_pending_count() const;
+
+    /* Disable copying and moving */
+    IcmpTransport(IcmpTransport const& other) = delete;
+    IcmpTransport(IcmpTransport&& other) = delete;
+    IcmpTransport& operator = (IcmpTransport const& other) = delete;
+    IcmpTransport&& operator = (IcmpTransport&& other) = delete;
+
+private:
+    // Request waiting for socket buffer space
+    struct Request
+    {
+        Address       address;
+        std::uint32_t key;
+    };
+
+    // Request waiting for its reply
+    struct Pending
+    {
+        std::uint64_t token;   // Token identifying the request towards the caller
+        Address       address; // Target address, replies must originate from it
+    };
+
+    using PendingMap = std::unordered_map<std::uint32_t, Pending>;
+
+    int                  family_;   // Address family of the socket
+    Socket               sock_;     // Shared socket
+    bool                 raw_;      // Raw sockets use the identifier as part of the key
+    std::uint16_t        base_;     // Identifier offset, keeps parallel processes apart
+    std::uint32_t        next_key_; // Next key to hand out
+    PendingMap           pending_;  // Unanswered requests by key
+    std::vector<Request> queued_;   // Requests not sent yet
+};
+
+} // namespace host_monitor
+
+#endif // ICMPTRANSPORT_HPP_202610161420
@@ -0,0 +1,134 @@
+/**
+ * @file      LatencyHistogram.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+
+#include "LatencyHistogram.hpp"
+
+namespace host_monitor
+{
+
+LatencyHistogram::LatencyHistogram()
+    : counts_()
+{
+    reset();
+}
+
+LatencyHistogram::LatencyHistogram(LatencyHistogram const& other)
+    : counts_()
+{
+    *this = other;
+}
+
+LatencyHistogram& LatencyHistogram::operator = (LatencyHistogram const& other)
+{
+    for (auto i = std::size_t(0); i < BUCKETS; ++i)
+    {
+        counts_[i].store(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds rtt)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(rtt).count();
+    auto value = static_cast<std::uint64_t>(std::max<decltype(us)>(us, 0));
+    counts_[to_index(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::merge(LatencyHistogram const& other)
+{
+    for (auto i = std::size_t(0); i < BUCKETS; ++i)
+    {
+        counts_[i].fetch_add(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& count : counts_)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t LatencyHistogram::get_count() const
+{
+    auto total = std::uint64_t(0);
+    for (auto const& count : counts_)
+    {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::chrono::microseconds LatencyHistogram::get_percentile(double percentile) const
+{
+    // Work on a snapshot, concurrent recording must not shift the result
+    auto counts = std::array<std::uint64_t, BUCKETS>();
+    auto total = std::uint64_t(0);
+    for (auto i = std::size_t(0); i < BUCKETS; ++i)
+    {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    if (total == 0)
+    {
+        return std::chrono::microseconds(0);
+    }
+
+    auto fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    // Rounded like HdrHistogram, 99.9% of 1000 values must not become 1000 values
+    auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(total) + 0.5);
+    rank = std::clamp<std::uint64_t>(rank, 1, total);
+
+    auto seen = std::uint64_t(0);
+    for (auto i = std::size_t(0); i < BUCKETS; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return std::chrono::microseconds(highest_value(i));
+        }
+    }
+    return std::chrono::microseconds(highest_value(BUCKETS - 1));
+}
+
+std::size_t LatencyHistogram::to_index(std::uint64_t value)
+{
+    // Values below SUB_BUCKETS are exact. Above, the value is shifted until
+    // it fits in [SUB_BUCKETS, 2 * SUB_BUCKETS), each shift adds a row.
+    if (value < SUB_BUCKETS)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    auto msb = std::size_t(63 - __builtin_clzll(value));
+    auto shift = msb - SUB_BUCKET_BITS;
+    auto index = shift * SUB_BUCKETS + static_cast<std::size_t>(value >> shift);
+    return std::min(index, BUCKETS - 1);
+}
+
+std::uint64_t LatencyHistogram::highest_value(std::size_t index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    auto shift = index / SUB_BUCKETS - 1;
+    auto sub = static_cast<std::uint64_t>(index - shift * SUB_BUCKETS);
+    return ((sub + 1) << shift) - 1;
+}
+
+} // namespace host_monitor
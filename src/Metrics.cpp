@@ -0,0 +1,199 @@
+/**
+ * @file      Metrics.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <cerrno>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Metrics.hpp"
+#include "MetricsRegistry.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+constexpr auto REQUEST_TIMEOUT = std::chrono::seconds(2);
+constexpr auto MAX_REQUEST_SIZE = std::size_t(8192);
+
+// Send @p data on a non-blocking socket, gives up at @p deadline or once @p cancel_fd is readable
+void send_all(int fd, std::string const& data, int cancel_fd, std::chrono::steady_clock::time_point deadline)
+{
+    auto sent = std::size_t(0);
+    while (sent < data.size())
+    {
+        auto n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            sent += static_cast<std::size_t>(n);
+            continue;
+        }
+
+        if ((errno != EAGAIN && errno != EWOULDBLOCK) || !(wait_for(fd, POLLOUT, cancel_fd, deadline) & POLLOUT))
+        {
+            return;
+        }
+    }
+}
+} // anon namespace
+
+void render_metrics(std::string& out)
+{
+    MetricsRegistry::get().render(out);
+}
+
+class MetricsServer::Impl
+{
+public:
+    Impl(std::string const& address, std::uint16_t port)
+        : listener_()
+        , stop_(::eventfd(0, EFD_CLOEXEC))
+        , port_(0)
+        , thread_()
+    {
+        auto addr = parse_address(address, AF_UNSPEC);
+        if (!addr || !stop_.is_valid())
+        {
+            throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                     ": invalid address " + address);
+        }
+        addr->set_port(port);
+
+        listener_ = Socket(::socket(addr->family(), SOCK_STREAM | SOCK_CLOEXEC, 0));
+        auto on = 1;
+        ::setsockopt(listener_.get(), SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if ( !listener_.is_valid()
+          || ::bind(listener_.get(), addr->get(), addr->length) != 0
+          || ::listen(listener_.get(), SOMAXCONN) != 0)
+        {
+            throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                     ": failed to listen on " + address + ":" + std::to_string(port));
+        }
+
+        auto bound = Address();
+        bound.length = sizeof(bound.storage);
+        ::getsockname(listener_.get(), reinterpret_cast<sockaddr*>(&bound.storage), &bound.length);
+        port_ = (bound.family() == AF_INET)
+              ? ntohs(reinterpret_cast<sockaddr_in const*>(bound.get())->sin_port)
+              : ntohs(reinterpret_cast<sockaddr_in6 const*>(bound.get())->sin6_port);
+
+        thread_ = std::thread(&Impl::run, this);
+    }
+
+    ~Impl()
+    {
+        auto one = std::uint64_t(1);
+        [[maybe_unused]] auto n = ::write(stop_.get(), &one, sizeof(one));
+        thread_.join();
+    }
+
+    std::uint16_t get_port() const
+    {
+        return port_;
+    }
+
+private:
+    void run()
+    {
+        while (true)
+        {
+            auto fds = std::array<pollfd, 2>{ pollfd{listener_.get(), POLLIN, 0}
+                                            , pollfd{stop_.get(), POLLIN, 0}};
+            if (::poll(fds.data(), fds.size(), -1) < 0 || (fds[1].revents & POLLIN))
+            {
+                return;
+            }
+
+            if (fds[0].revents & POLLIN)
+            {
+                auto client = Socket(::accept4(listener_.get(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+                if (client.is_valid())
+                {
+                    serve(client.get());
+                }
+            }
+        }
+    }
+
+    void serve(int fd)
+    {
+        // Read the request head, the body of a GET request is ignored.
+        // Shutdown doesn't wait for slow clients.
+        auto request = std::string();
+        auto buffer = std::array<char, 1024>();
+        auto deadline = std::chrono::steady_clock::now() + REQUEST_TIMEOUT;
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+        {
+            if (!(wait_for(fd, POLLIN, stop_.get(), deadline) & POLLIN))
+            {
+                return;
+            }
+
+            auto n = ::recv(fd, buffer.data(), buffer.size(), 0);
+            if (n <= 0)
+            {
+                return;
+            }
+            request.append(buffer.data(), static_cast<std::size_t>(n));
+        }
+
+        auto line = std::string_view(request).substr(0, request.find("\r\n"));
+        auto status = std::string("404 Not Found");
+        auto body = std::string();
+        if (line.substr(0, 4) != "GET ")
+        {
+            status = "405 Method Not Allowed";
+        }
+        else if (line.substr(4, 9) == "/metrics " || line.substr(4, 9) == "/metrics?")
+        {
+            status = "200 OK";
+            render_metrics(body);
+        }
+
+        auto response = "HTTP/1.1 " + status + "\r\n"
+                        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                        "Connection: close\r\n"
+                        "\r\n" + body;
+
+        send_all(fd, response, stop_.get(), deadline);
+    }
+
+    Socket        listener_; // Listening socket
+    Socket        stop_;     // eventfd signaling shutdown
+    std::uint16_t port_;     // Port the listener is bound to
+    std::thread   thread_;   // Thread serving requests
+};
+
+// Interface Implementation
+MetricsServer::MetricsServer(std::string const& address, std::uint16_t port)
+    : pimpl_(std::make_unique<Impl>(address, port))
+{
+}
+
+MetricsServer::~MetricsServer() = default;
+
+std::uint16_t MetricsServer::get_port() const
+{
+    return pimpl_->get_port();
+}
+
+} // namespace host_monitor
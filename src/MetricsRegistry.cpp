@@ -0,0 +1,263 @@
+/**
+ * @file      MetricsRegistry.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "MetricsRegistry.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+using namespace std::chrono_literals;
+
+// Upper bounds of histogram buckets
+constexpr auto BOUNDS = std::array<std::chrono::nanoseconds, 16>
+{
+    100us, 250us, 500us, 1ms, 2500us, 5ms, 10ms, 25ms, 50ms, 100ms, 250ms, 500ms, 1s, 2500ms, 5s, 10s
+};
+
+constexpr auto PROTOCOL_LABELS = std::array
+{
+    "protocol=\"ICMPV4\"", "protocol=\"ICMPV6\"", "protocol=\"TCP\"", "protocol=\"UDP\"", "protocol=\"HTTP\""
+  , "protocol=\"TCP_PERSISTENT\""
+};
+static_assert(PROTOCOL_LABELS.size() == Endpoint::PROTOCOL_COUNT, "PROTOCOL_LABELS requires a label per protocol");
+
+void append_header(std::string& out, char const* name, char const* help, char const* type)
+{
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void append_sample(std::string& out, char const* name, std::string const& labels, std::string const& value)
+{
+    out.append(name);
+    if (!labels.empty())
+    {
+        out.append("{").append(labels).append("}");
+    }
+    out.append(" ").append(value).append("\n");
+}
+
+std::string format_seconds(std::chrono::nanoseconds duration)
+{
+    auto buffer = std::array<char, 32>();
+    std::snprintf(buffer.data(), buffer.size(), "%.9g", std::chrono::duration<double>(duration).count());
+    return buffer.data();
+}
+} // anon namespace
+
+// Owns the shard of a thread, retires it on thread exit
+class MetricsRegistry::ShardOwner
+{
+public:
+    explicit ShardOwner(MetricsRegistry& registry)
+        : registry_(registry)
+        , shard_()
+    {
+        registry_.attach(&shard_);
+    }
+
+    ~ShardOwner()
+    {
+        registry_.detach(&shard_);
+    }
+
+    Shard& get()
+    {
+        return shard_;
+    }
+
+private:
+    MetricsRegistry& registry_; // Registry the shard is attached to
+    Shard            shard_;    // Metrics of the owning thread
+};
+
+void MetricsRegistry::Histogram::record(std::chrono::nanoseconds duration)
+{
+    auto bucket = std::lower_bound(BOUNDS.begin(), BOUNDS.end(), duration) - BOUNDS.begin();
+    buckets[static_cast<std::size_t>(bucket)].add(1);
+    sum_ns.add(static_cast<std::uint64_t>(std::max(duration.count(), std::int64_t(0))));
+}
+
+void MetricsRegistry::Histogram::add_to(Histogram& total) const
+{
+    for (auto i = std::size_t(0); i < buckets.size(); ++i)
+    {
+        total.buckets[i].add(buckets[i].get());
+    }
+    total.sum_ns.add(sum_ns.get());
+}
+
+void MetricsRegistry::Shard::add_to(Shard& total) const
+{
+    for (auto i = std::size_t(0); i < PROTOCOLS; ++i)
+    {
+        total.probes[i].add(probes[i].get());
+        total.failures[i].add(failures[i].get());
+        probe_duration[i].add_to(total.probe_duration[i]);
+        total.delayed[i].add(delayed[i].get());
+        total.suppressed[i].add(suppressed[i].get());
+    }
+    total.state_changes[0].add(state_changes[0].get());
+    total.state_changes[1].add(state_changes[1].get());
+    total.state_changes[2].add(state_changes[2].get());
+    scheduler_lag.add_to(total.scheduler_lag);
+    observer_calls.add_to(total.observer_calls);
+}
+
+MetricsRegistry::MetricsRegistry()
+    : mtx_()
+    , shards_()
+    , retired_()
+{
+}
+
+MetricsRegistry& MetricsRegistry::get()
+{
+    // Intentionally leaked: threads may record metrics during static destruction.
+    static auto* registry = new MetricsRegistry();
+    return *registry;
+}
+
+MetricsRegistry::Shard& MetricsRegistry::local()
+{
+    thread_local auto owner = ShardOwner(get());
+    return owner.get();
+}
+
+void MetricsRegistry::attach(Shard* shard)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    shards_.push_back(shard);
+}
+
+void MetricsRegistry::detach(Shard* shard)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    shard->add_to(retired_);
+    shards_.erase(std::remove(shards_.begin(), shards_.end(), shard), shards_.end());
+}
+
+void MetricsRegistry::record_probe(Endpoint::Protocol protocol, bool available, std::chrono::nanoseconds duration)
+{
+    auto& shard = local();
+    auto index = static_cast<std::size_t>(protocol);
+    shard.probes[index].add(1);
+    shard.failures[index].add(available ? 0 : 1);
+    shard.probe_duration[index].record(duration);
+}
+
+void MetricsRegistry::record_state_change(bool available)
+{
+    local().state_changes[available ? 1 : 0].add(1);
+}
+
+void MetricsRegistry::record_unreachable()
+{
+    local().state_changes[2].add(1);
+}
+
+void MetricsRegistry::record_probe_suppressed(Endpoint::Protocol protocol)
+{
+    local().suppressed[static_cast<std::size_t>(protocol)].add(1);
+}
+
+void MetricsRegistry::record_rate_limited(Endpoint::Protocol protocol)
+{
+    local().delayed[static_cast<std::size_t>(protocol)].add(1);
+}
+
+void MetricsRegistry::record_scheduler_lag(std::chrono::nanoseconds lag)
+{
+    local().scheduler_lag.record(lag);
+}
+
+void MetricsRegistry::record_observer_call(std::chrono::nanoseconds duration)
+{
+    local().observer_calls.record(duration);
+}
+
+void MetricsRegistry::render(std::string& out) const
+{
+    // Sum all shards. Shards are written concurrently, each value is read atomically.
+    auto total = Shard();
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        retired_.add_to(total);
+        for (auto const* shard : shards_)
+        {
+            shard->add_to(total);
+        }
+    }
+
+    auto append_histogram = [&out] (char const* name, std::string const& labels, Histogram const& histogram)
+    {
+        auto bucket_name = std::string(name) + "_bucket";
+        auto prefix = labels.empty() ? std::string() : labels + ",";
+        auto count = std::uint64_t(0);
+        for (auto i = std::size_t(0); i < histogram.buckets.size(); ++i)
+        {
+            count += histogram.buckets[i].get();
+            auto le = (i < BOUNDS.size()) ? format_seconds(BOUNDS[i]) : std::string("+Inf");
+            append_sample(out, bucket_name.c_str(), prefix + "le=\"" + le + "\"", std::to_string(count));
+        }
+        auto sum = std::chrono::nanoseconds(static_cast<std::int64_t>(histogram.sum_ns.get()));
+        append_sample(out, (std::string(name) + "_sum").c_str(), labels, format_seconds(sum));
+        append_sample(out, (std::string(name) + "_count").c_str(), labels, std::to_string(count));
+    };
+
+    append_header(out, "host_monitor_probes_total", "Connection tests executed.", "counter");
+    for (auto i = std::size_t(0); i < PROTOCOLS; ++i)
+    {
+        append_sample(out, "host_monitor_probes_total", PROTOCOL_LABELS[i], std::to_string(total.probes[i].get()));
+    }
+
+    append_header(out, "host_monitor_probe_failures_total", "Connection tests failed.", "counter");
+    for (auto i = std::size_t(0); i < PROTOCOLS; ++i)
+    {
+        append_sample(out, "host_monitor_probe_failures_total", PROTOCOL_LABELS[i], std::to_string(total.failures[i].get()));
+    }
+
+    append_header(out, "host_monitor_probe_duration_seconds", "Duration of connection tests.", "histogram");
+    for (auto i = std::size_t(0); i < PROTOCOLS; ++i)
+    {
+        append_histogram("host_monitor_probe_duration_seconds", PROTOCOL_LABELS[i], total.probe_duration[i]);
+    }
+
+    append_header(out, "host_monitor_probes_delayed_total", "Connection tests delayed by the probe rate limit.", "counter");
+    for (auto i = std::size_t(0); i < PROTOCOLS; ++i)
+    {
+        append_sample(out, "host_monitor_probes_delayed_total", PROTOCOL_LABELS[i], std::to_string(total.delayed[i].get()));
+    }
+
+    append_header(out, "host_monitor_probes_suppressed_total", "Connection tests suppressed because a parent endpoint is down.", "counter");
+    for (auto i = std::size_t(0); i < PROTOCOLS; ++i)
+    {
+        append_sample(out, "host_monitor_probes_suppressed_total", PROTOCOL_LABELS[i], std::to_string(total.suppressed[i].get()));
+    }
+
+    append_header(out, "host_monitor_state_changes_total", "Changes of monitor availability.", "counter");
+    append_sample(out, "host_monitor_state_changes_total", "state=\"down\"", std::to_string(total.state_changes[0].get()));
+    append_sample(out, "host_monitor_state_changes_total", "state=\"up\"", std::to_string(total.state_changes[1].get()));
+    append_sample(out, "host_monitor_state_changes_total", "state=\"unreachable\"", std::to_string(total.state_changes[2].get()));
+
+    append_header(out, "host_monitor_scheduler_lag_seconds", "Delay of connection tests behind their schedule.", "histogram");
+    append_histogram("host_monitor_scheduler_lag_seconds", std::string(), total.scheduler_lag);
+
+    append_header(out, "host_monitor_observer_callback_seconds", "Duration of observer callbacks.", "histogram");
+    append_histogram("host_monitor_observer_callback_seconds", std::string(), total.observer_calls);
+}
+
+} // namespace host_monitor
@@ -0,0 +1,163 @@
+/**
+ * @file      MetricsRegistry.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef METRICSREGISTRY_HPP_202610162100
+#define METRICSREGISTRY_HPP_202610162100
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Endpoint.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Process wide registry of internal metrics.
+ * @note  Each thread records into a shard of its own, using relaxed loads and
+ *        stores only: recording never contends. Shards are summed on render().
+ *        Counts of exited threads are retained.
+ */
+class MetricsRegistry
+{
+public:
+    /**
+     * @brief Get the registry.
+     * @returns Process wide registry. Lives until the process exits.
+     */
+    static MetricsRegistry& get();
+
+    /**
+     * @brief Record a completed connection test.
+     * @param[in] protocol    Protocol of the tested endpoint.
+     * @param[in] available   true if the endpoint was reachable.
+     * @param[in] duration    Duration of the test.
+     */
+    void record_probe(Endpoint::Protocol protocol, bool available, std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Record a change of a monitors availability.
+     * @param[in] available   The new availability.
+     */
+    void record_state_change(bool available);
+
+    /**
+     * @brief Record a monitor becoming unreachable because the endpoint it depends on is down.
+     */
+    void record_unreachable();
+
+    /**
+     * @brief Record a connection test suppressed because the endpoint it depends on is down.
+     * @param[in] protocol   Protocol of the suppressed endpoint.
+     */
+    void record_probe_suppressed(Endpoint::Protocol protocol);
+
+    /**
+     * @brief Record a connection test delayed by the probe rate limit.
+     * @param[in] protocol   Protocol of the delayed endpoint.
+     */
+    void record_rate_limited(Endpoint::Protocol protocol);
+
+    /**
+     * @brief Record the delay of a connection test behind its schedule.
+     * @param[in] lag   Time between the scheduled and the actual start.
+     */
+    void record_scheduler_lag(std::chrono::nanoseconds lag);
+
+    /**
+     * @brief Record an observer callback.
+     * @param[in] duration   Duration of HostMonitorObserver::state_change().
+     */
+    void record_observer_call(std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Render all metrics in Prometheus text format.
+     * @param[in,out] out   String the metrics are appended to.
+     */
+    void render(std::string& out) const;
+
+    /* Disable copying and moving */
+    MetricsRegistry(MetricsRegistry const& other) = delete;
+    MetricsRegistry(MetricsRegistry&& other) = delete;
+    MetricsRegistry& operator = (MetricsRegistry const& other) = delete;
+    MetricsRegistry&& operator = (MetricsRegistry&& other) = delete;
+
+private:
+    static constexpr std::size_t PROTOCOLS = Endpoint::PROTOCOL_COUNT;
+    static constexpr std::size_t BUCKETS = 16;
+
+    // Counter written by a single thread
+    struct Counter
+    {
+        void add(std::uint64_t n)
+        {
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        std::uint64_t get() const
+        {
+            return value.load(std::memory_order_relaxed);
+        }
+
+        std::atomic<std::uint64_t> value = 0;
+    };
+
+    // Histogram of durations with Prometheus style upper bounds
+    struct Histogram
+    {
+        void record(std::chrono::nanoseconds duration);
+
+        void add_to(Histogram& total) const;
+
+        std::array<Counter, BUCKETS + 1> buckets; // Non-cumulative counts, last one is +Inf
+        Counter                          sum_ns;  // Sum of all durations in nanoseconds
+    };
+
+    // Metrics recorded by one thread
+    struct alignas(64) Shard
+    {
+        void add_to(Shard& total) const;
+
+        std::array<Counter, PROTOCOLS>   probes;         // Connection tests by protocol
+        std::array<Counter, PROTOCOLS>   failures;       // Failed connection tests by protocol
+        std::array<Histogram, PROTOCOLS> probe_duration; // Duration of connection tests by protocol
+        std::array<Counter, PROTOCOLS>   delayed;        // Connection tests delayed by the rate limit by protocol
+        std::array<Counter, PROTOCOLS>   suppressed;     // Connection tests suppressed by a down parent by protocol
+        std::array<Counter, 3>           state_changes;  // State changes to down, up and unreachable
+        Histogram                        scheduler_lag;  // Delay of tests behind their schedule
+        Histogram                        observer_calls; // Duration of observer callbacks
+    };
+
+    class ShardOwner;
+
+    MetricsRegistry();
+
+    // Shard of the calling thread
+    Shard& local();
+
+    void attach(Shard* shard);
+
+    void detach(Shard* shard);
+
+    mutable std::mutex  mtx_;     // Lock for synchronizing access to shards_ and retired_
+    std::vector<Shard*> shards_;  // Shards of running threads
+    Shard               retired_; // Sum of shards of exited threads
+};
+
+} // namespace host_monitor
+
+#endif // METRICSREGISTRY_HPP_202610162100
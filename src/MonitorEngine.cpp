@@ -0,0 +1,344 @@
+/**
+ * @file      MonitorEngine.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "MonitorEngineImpl.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Event-loop threads of the default engine
+std::size_t default_thread_count()
+{
+    auto hw = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    return std::clamp(hw, std::size_t(1), std::size_t(4));
+}
+
+// Innermost batch of the calling thread, batches of other engines included
+thread_local MonitorEngine::Impl::Batch* active_batch = nullptr;
+} // anon namespace
+
+MonitorEngine::Impl::Batch::Batch(MonitorEngine::Impl& engine)
+    : engine_(engine)
+    , outer_(active_batch)
+    , pending_()
+{
+    active_batch = this;
+}
+
+MonitorEngine::Impl::Batch::~Batch()
+{
+    active_batch = outer_;
+
+    // Registrations go first, a monitor might be added and removed within the batch
+    for (auto& [loop, pending] : pending_)
+    {
+        if (!pending.added.empty())
+        {
+            loop->add_monitors(std::move(pending.added));
+        }
+        if (!pending.removed.empty())
+        {
+            loop->del_monitors(std::move(pending.removed));
+        }
+    }
+}
+
+MonitorEngine::Impl::Impl(MonitorEngine::Mode mode, std::size_t threads, MonitorEngine::Backend backend)
+    : mode_(mode)
+    , limiter_(std::make_shared<RateLimiter>())
+    , loops_()
+    , next_loop_(0)
+    , assigned_()
+    , threads_()
+    , journal_(nullptr)
+    , nodes_()
+    , parents_()
+    , mtx_()
+{
+    if (mode_ == MonitorEngine::Mode::EVENT_LOOP)
+    {
+        if (threads == 0)
+        {
+            throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                     ": at least one event-loop thread is required");
+        }
+
+        for (auto i = std::size_t(0); i < threads; ++i)
+        {
+            loops_.push_back(std::make_unique<EventLoop>(backend, limiter_));
+        }
+    }
+}
+
+MonitorEngine::Impl::~Impl() = default;
+
+MonitorEngine::Mode MonitorEngine::Impl::get_mode() const
+{
+    return mode_;
+}
+
+MonitorEngine::Backend MonitorEngine::Impl::get_backend() const
+{
+    // All loops fall back alike
+    return loops_.empty() ? MonitorEngine::Backend::EPOLL : loops_.front()->get_backend();
+}
+
+std::size_t MonitorEngine::Impl::get_thread_count() const
+{
+    return loops_.size();
+}
+
+void MonitorEngine::Impl::attach_journal(StateJournal::Impl* journal)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    journal_ = journal;
+}
+
+RateLimiter& MonitorEngine::Impl::get_limiter()
+{
+    return *limiter_;
+}
+
+void MonitorEngine::Impl::add_monitor(std::shared_ptr<HostMonitor::Impl> monitor)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    auto key = monitor.get();
+
+    // Seed before the first test can report. Further monitors of an
+    // endpoint are seeded as well, but only the first one records.
+    if (journal_)
+    {
+        auto const& endpoint = monitor->get_endpoint();
+        auto* record = journal_->acquire(endpoint);
+        monitor->attach_journal(record, journal_->find(endpoint));
+    }
+    monitor->attach_node(acquire_node(monitor->get_endpoint()));
+
+    if (mode_ == MonitorEngine::Mode::THREAD_PER_MONITOR)
+    {
+        threads_.emplace(key, std::make_unique<MonitorThread>(std::move(monitor), limiter_));
+        return;
+    }
+
+    // Distribute monitors round robin over all loops
+    auto* loop = loops_[next_loop_].get();
+    next_loop_ = (next_loop_ + 1) % loops_.size();
+
+    assigned_.emplace(key, loop);
+    if (auto* batch = find_batch())
+    {
+        batch->pending_[loop].added.push_back(std::move(monitor));
+        return;
+    }
+    loop->add_monitor(std::move(monitor));
+}
+
+void MonitorEngine::Impl::del_monitor(HostMonitor::Impl* monitor)
+{
+    auto loop = static_cast<EventLoop*>(nullptr);
+    auto thread = std::unique_ptr<MonitorThread>();
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        if (auto it = assigned_.find(monitor); it != assigned_.end())
+        {
+            loop = it->second;
+            assigned_.erase(it);
+        }
+
+        if (auto it = threads_.find(monitor); it != threads_.end())
+        {
+            thread = std::move(it->second);
+            threads_.erase(it);
+        }
+    }
+
+    // Retire outside of the lock, this waits for a running report to finish.
+    // Loops drop the monitor later on, threads are joined right away.
+    monitor->retire();
+    if (auto* batch = loop ? find_batch() : nullptr)
+    {
+        batch->pending_[loop].removed.push_back(monitor);
+    }
+    else if (loop)
+    {
+        loop->del_monitor(monitor);
+    }
+    thread.reset();
+
+    // Nothing reports anymore, the record can be handed to another monitor
+    auto* record = monitor->detach_journal();
+
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    if (journal_ && record)
+    {
+        journal_->release(record);
+    }
+    release_node(monitor->get_endpoint());
+}
+
+void MonitorEngine::Impl::add_dependency(Endpoint const& parent, Endpoint const& child)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+
+    // Topologies are trees, walk up from the parent
+    for (auto const* ep = &parent; ep; )
+    {
+        if (*ep == child)
+        {
+            throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                     ": dependency forms a cycle");
+        }
+        auto it = parents_.find(*ep);
+        ep = (it != parents_.end()) ? &it->second : nullptr;
+    }
+
+    // The dependency holds a reference to both nodes, the old parent is released.
+    // Children share ownership of their parent, readers of the old parent keep it alive.
+    auto parent_node = acquire_node(parent);
+    auto child_node = acquire_node(child);
+    std::atomic_store(&child_node->parent, std::shared_ptr<HostMonitor::Impl::Node const>(parent_node));
+
+    auto [it, inserted] = parents_.try_emplace(child, parent);
+    if (!inserted)
+    {
+        release_node(it->second);
+        release_node(child);
+        it->second = parent;
+    }
+}
+
+void MonitorEngine::Impl::del_dependency(Endpoint const& child)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    auto it = parents_.find(child);
+    if (it == parents_.end())
+    {
+        return;
+    }
+
+    std::atomic_store(&nodes_.at(child)->parent, std::shared_ptr<HostMonitor::Impl::Node const>());
+    release_node(it->second);
+    release_node(child);
+    parents_.erase(it);
+}
+
+MonitorEngine::Impl::Batch* MonitorEngine::Impl::find_batch()
+{
+    for (auto* batch = active_batch; batch; batch = batch->outer_)
+    {
+        if (&batch->engine_ == this)
+        {
+            return batch;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<HostMonitor::Impl::Node> MonitorEngine::Impl::acquire_node(Endpoint const& endpoint)
+{
+    auto& node = nodes_[endpoint];
+    if (!node)
+    {
+        node = std::make_shared<HostMonitor::Impl::Node>();
+    }
+    node->users += 1;
+    return node;
+}
+
+void MonitorEngine::Impl::release_node(Endpoint const& endpoint)
+{
+    // Nodes are dropped once neither a monitor nor a dependency refers to them.
+    // Monitors and children still reading a node share its ownership.
+    auto it = nodes_.find(endpoint);
+    if (it != nodes_.end() && --it->second->users == 0)
+    {
+        nodes_.erase(it);
+    }
+}
+
+// Interface Implementation
+MonitorEngine::MonitorEngine(std::size_t threads)
+    : MonitorEngine(Mode::EVENT_LOOP, threads)
+{
+}
+
+MonitorEngine::MonitorEngine(Mode mode, std::size_t threads)
+    : pimpl_(std::make_unique<Impl>(mode, threads, Backend::EPOLL))
+{
+}
+
+MonitorEngine::MonitorEngine(std::size_t threads, Backend backend)
+    : pimpl_(std::make_unique<Impl>(Mode::EVENT_LOOP, threads, backend))
+{
+}
+
+MonitorEngine::~MonitorEngine() = default;
+
+MonitorEngine& MonitorEngine::get_default()
+{
+    // Intentionally leaked: monitors with static storage duration may outlive any other object.
+    static auto* engine = new MonitorEngine(default_thread_count());
+    return *engine;
+}
+
+void MonitorEngine::attach_journal(StateJournal& journal)
+{
+    pimpl_->attach_journal(journal.pimpl_.get());
+}
+
+void MonitorEngine::set_rate_limit(RateLimit limit)
+{
+    pimpl_->get_limiter().set_limit(limit);
+}
+
+void MonitorEngine::set_rate_limit(Endpoint::Protocol protocol, RateLimit limit)
+{
+    pimpl_->get_limiter().set_limit(protocol, limit);
+}
+
+void MonitorEngine::set_startup_spread(std::chrono::milliseconds spread)
+{
+    pimpl_->get_limiter().set_startup_spread(spread);
+}
+
+void MonitorEngine::add_dependency(Endpoint const& parent, Endpoint const& child)
+{
+    pimpl_->add_dependency(parent, child);
+}
+
+void MonitorEngine::del_dependency(Endpoint const& child)
+{
+    pimpl_->del_dependency(child);
+}
+
+MonitorEngine::Mode MonitorEngine::get_mode() const
+{
+    return pimpl_->get_mode();
+}
+
+MonitorEngine::Backend MonitorEngine::get_backend() const
+{
+    return pimpl_->get_backend();
+}
+
+std::size_t MonitorEngine::get_thread_count() const
+{
+    return pimpl_->get_thread_count();
+}
+
+} // namespace host_monitor
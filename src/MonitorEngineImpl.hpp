@@ -0,0 +1,131 @@
+/**
+ * @file      MonitorEngineImpl.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef MONITORENGINEIMPL_HPP_202610161240
+#define MONITORENGINEIMPL_HPP_202610161240
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstddef>
+
+#include "MonitorEngine.hpp"
+#include "HostMonitorImpl.hpp"
+#include "EventLoop.hpp"
+#include "MonitorThread.hpp"
+#include "RateLimiter.hpp"
+#include "StateJournalImpl.hpp"
+
+namespace host_monitor
+{
+
+class MonitorEngine::Impl
+{
+public:
+    /**
+     * @brief Defers the loop commands of monitors added to and removed from the engine
+     *        by the calling thread. Each loop receives its deferred monitors at once when
+     *        the batch ends.
+     * @note  Monitors are registered and retired right away, connection tests of added
+     *        monitors start once the batch ends. Batches are scoped to the creating thread.
+     */
+    class Batch
+    {
+    public:
+        explicit Batch(MonitorEngine::Impl& engine);
+
+        ~Batch();
+
+        /* Disable copying and moving */
+        Batch(Batch const& other) = delete;
+        Batch(Batch&& other) = delete;
+        Batch& operator = (Batch const& other) = delete;
+        Batch&& operator = (Batch&& other) = delete;
+
+    private:
+        friend class MonitorEngine::Impl;
+
+        // Monitors deferred for one loop
+        struct Pending
+        {
+            std::vector<std::shared_ptr<HostMonitor::Impl>> added;   // Monitors to register
+            std::vector<HostMonitor::Impl const*>          removed; // Monitors to unregister
+        };
+
+        MonitorEngine::Impl&                    engine_;  // Engine the batch defers commands of
+        Batch*                                  outer_;   // Batch of this thread active before, if any
+        std::unordered_map<EventLoop*, Pending> pending_; // Deferred monitors by loop
+    };
+
+    Impl(MonitorEngine::Mode mode, std::size_t threads, MonitorEngine::Backend backend);
+
+    ~Impl();
+
+    MonitorEngine::Mode get_mode() const;
+
+    MonitorEngine::Backend get_backend() const;
+
+    std::size_t get_thread_count() const;
+
+    void attach_journal(StateJournal::Impl* journal);
+
+    RateLimiter& get_limiter();
+
+    void add_dependency(Endpoint const& parent, Endpoint const& child);
+
+    void del_dependency(Endpoint const& child);
+
+    /**
+     * @brief Register a monitor on the engine.
+     * @param[in] monitor   The monitor to register.
+     */
+    void add_monitor(std::shared_ptr<HostMonitor::Impl> monitor);
+
+    /**
+     * @brief Unregister a monitor from the engine.
+     * @note  After this call returns, the monitor is not reported to anymore.
+     *        Event-loops are not waited for, they drop the monitor later on.
+     * @param[in] monitor   The monitor to unregister.
+     */
+    void del_monitor(HostMonitor::Impl* monitor);
+
+private:
+    using LoopMap = std::unordered_map<HostMonitor::Impl const*, EventLoop*>;
+    using ThreadMap = std::unordered_map<HostMonitor::Impl const*, std::unique_ptr<MonitorThread>>;
+    using NodeMap = std::unordered_map<Endpoint, std::shared_ptr<HostMonitor::Impl::Node>>;
+    using ParentMap = std::unordered_map<Endpoint, Endpoint>;
+
+    // Get the innermost batch of this engine on the calling thread, if any
+    Batch* find_batch();
+
+    // Get dependency node of an endpoint, create it if there is none. Called with mtx_ held.
+    std::shared_ptr<HostMonitor::Impl::Node> acquire_node(Endpoint const& endpoint);
+
+    // Drop a reference acquired by acquire_node(). Called with mtx_ held.
+    void release_node(Endpoint const& endpoint);
+
+    MonitorEngine::Mode                     mode_;      // Execution model
+    std::shared_ptr<RateLimiter>            limiter_;   // Rate limit of connection tests, shared with loops and threads
+    std::vector<std::unique_ptr<EventLoop>> loops_;     // Event loops, EVENT_LOOP mode only
+    std::size_t                             next_loop_; // Loop the next monitor is assigned to
+    LoopMap                                 assigned_;  // Loop each monitor is assigned to
+    ThreadMap                               threads_;   // Threads, THREAD_PER_MONITOR mode only
+    StateJournal::Impl*                     journal_;   // Journal seeding and recording monitor state, if any
+    NodeMap                                 nodes_;     // Dependency node of each endpoint with a monitor or dependency
+    ParentMap                               parents_;   // Parent of each endpoint with a declared dependency
+    std::mutex                              mtx_;       // Lock for synchronizing access to the maps and nodes_ reference counts
+};
+
+} // namespace host_monitor
+
+#endif // MONITORENGINEIMPL_HPP_202610161240
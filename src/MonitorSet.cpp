@@ -0,0 +1,470 @@
+/**
+ * @file      MonitorSet.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "MonitorSet.hpp"
+#include "MonitorEngineImpl.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Split the next whitespace separated token off @p line
+std::string_view next_token(std::string_view& line)
+{
+    auto begin = line.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos)
+    {
+        line = std::string_view();
+        return std::string_view();
+    }
+
+    line.remove_prefix(begin);
+    auto end = std::min(line.find_first_of(" \t\r"), line.size());
+    auto token = line.substr(0, end);
+    line.remove_prefix(end);
+    return token;
+}
+
+// Decode a string of hex digits, e.g. "0a1B". Empty strings decode to empty strings.
+std::optional<std::string> decode_hex(std::string_view hex)
+{
+    // Unsigned math throughout: the range checks become single comparisons
+    auto nibble = [] (char c) -> unsigned
+    {
+        auto u = unsigned(static_cast<unsigned char>(c));
+        if (u - '0' < 10u)
+        {
+            return u - '0';
+        }
+
+        auto lower = u | 0x20u;
+        if (lower - 'a' < 6u)
+        {
+            return lower - 'a' + 10u;
+        }
+        return 16u;
+    };
+
+    if (hex.size() % 2 != 0)
+    {
+        return std::nullopt;
+    }
+
+    auto bytes = std::string();
+    bytes.reserve(hex.size() / 2);
+    for (auto i = std::size_t(0); i < hex.size(); i += 2)
+    {
+        auto high = nibble(hex[i]);
+        auto low = nibble(hex[i + 1]);
+        if (high > 15u || low > 15u)
+        {
+            return std::nullopt;
+        }
+        bytes.push_back(static_cast<char>((high << 4) | low));
+    }
+    return bytes;
+}
+
+std::optional<std::chrono::milliseconds> parse_interval(std::string_view s)
+{
+    auto value = std::int64_t(0);
+    auto const* end = s.data() + s.size();
+    auto [ptr, ec] = std::from_chars(s.data(), end, value);
+    if (ptr == s.data() || ec != std::errc() || value <= 0)
+    {
+        return {};
+    }
+
+    auto unit = std::string_view(ptr, static_cast<std::size_t>(end - ptr));
+    if (unit.empty() || unit == "ms")
+    {
+        return std::chrono::milliseconds(value);
+    }
+    if (unit == "s")
+    {
+        return std::chrono::seconds(value);
+    }
+    if (unit == "m")
+    {
+        return std::chrono::minutes(value);
+    }
+    return {};
+}
+} // anon namespace
+
+class MonitorSet::Impl
+{
+public:
+    explicit Impl(MonitorEngine& engine)
+        : engine_(engine)
+        , parsed_()
+        , running_()
+        , observers_()
+        , generation_(0)
+    {
+    }
+
+    ~Impl()
+    {
+        // All monitors leave their loops with one command per loop
+        auto batch = MonitorEngine::Impl::Batch(*engine_.pimpl_);
+        running_.clear();
+    }
+
+    Changes load(std::string_view list)
+    {
+        // Parse everything first, an invalid line leaves the running set untouched
+        parsed_.clear();
+        auto number = std::size_t(0);
+        while (!list.empty())
+        {
+            auto end = std::min(list.find('\n'), list.size());
+            auto line = list.substr(0, end);
+            list.remove_prefix(std::min(end + 1, list.size()));
+            number += 1;
+
+            line = line.substr(0, line.find('#'));
+            parse_line(line, number);
+        }
+        return apply();
+    }
+
+    void add_observer(std::shared_ptr<HostMonitorObserver> observer, Notifier* notifier)
+    {
+        for (auto& [endpoint, entry] : running_)
+        {
+            attach(*entry.monitor, observer, notifier);
+        }
+        observers_.emplace_back(std::move(observer), notifier);
+    }
+
+    void del_observer(std::shared_ptr<HostMonitorObserver> const& observer)
+    {
+        for (auto& [endpoint, entry] : running_)
+        {
+            entry.monitor->del_observer(observer);
+        }
+
+        auto pos = std::remove_if(observers_.begin(), observers_.end(), [&observer] (Observer const& o)
+        {
+            return o.first == observer;
+        });
+        observers_.erase(pos, observers_.end());
+    }
+
+    HostMonitor const* find(Endpoint const& endpoint) const
+    {
+        auto it = running_.find(endpoint);
+        return (it != running_.end()) ? it->second.monitor.get() : nullptr;
+    }
+
+    std::size_t size() const
+    {
+        return running_.size();
+    }
+
+private:
+    // Endpoint listed in a file
+    struct Parsed
+    {
+        Endpoint                  endpoint; // The endpoint
+        std::chrono::milliseconds interval; // Its interval
+    };
+
+    // Running monitor
+    struct Running
+    {
+        std::chrono::milliseconds    interval;   // Interval of the monitor
+        std::uint64_t                generation; // Last load listing the endpoint
+        std::unique_ptr<HostMonitor> monitor;    // The monitor
+    };
+
+    using Observer = std::pair<std::shared_ptr<HostMonitorObserver>, Notifier*>;
+
+    void parse_line(std::string_view line, std::size_t number)
+    {
+        auto protocol_str = next_token(line);
+        if (protocol_str.empty())
+        {
+            return;
+        }
+
+        // Errors name this function, not the lambda. The prefix is built on failure only.
+        auto const* function = __PRETTY_FUNCTION__;
+        auto fail = [function, number] (char const* reason)
+        {
+            throw std::runtime_error(std::string(function) +
+                                     ": line " + std::to_string(number) + ": " + reason);
+        };
+
+        auto protocol = string_to_protocol(protocol_str);
+        if (!protocol)
+        {
+            fail("unknown protocol");
+        }
+
+        auto has_port = *protocol == Endpoint::Protocol::TCP || *protocol == Endpoint::Protocol::UDP
+                     || *protocol == Endpoint::Protocol::HTTP || *protocol == Endpoint::Protocol::TCP_PERSISTENT;
+        auto host = next_token(line);
+        auto port = has_port ? next_token(line) : std::string_view();
+        auto interval = parse_interval(next_token(line));
+        if (host.empty() || !interval)
+        {
+            fail("expected 'PROTOCOL host [port] interval'");
+        }
+
+        // UDP requests: optional hex encoded payload and expected response
+        auto payload = std::optional<std::string>(std::string());
+        auto expected = std::optional<std::string>();
+        if (*protocol == Endpoint::Protocol::UDP)
+        {
+            auto payload_hex = next_token(line);
+            auto expected_hex = next_token(line);
+            payload = decode_hex(payload_hex);
+            expected = expected_hex.empty() ? std::nullopt : decode_hex(expected_hex);
+            if (!payload || (!expected_hex.empty() && !expected))
+            {
+                fail("invalid hex string");
+            }
+        }
+
+        // HTTP requests: optional path, expected status and body text
+        auto status = std::uint16_t(200);
+        if (*protocol == Endpoint::Protocol::HTTP)
+        {
+            auto path = next_token(line);
+            auto status_str = next_token(line);
+            auto body = next_token(line);
+            payload = path.empty() ? std::string("/") : std::string(path);
+            expected = body.empty() ? std::nullopt : std::optional<std::string>(body);
+
+            auto const* end = status_str.data() + status_str.size();
+            auto [ptr, ec] = std::from_chars(status_str.data(), end, status);
+            if (!status_str.empty() && (ec != std::errc() || ptr != end))
+            {
+                fail("invalid status code");
+            }
+        }
+        if (!next_token(line).empty())
+        {
+            fail("unexpected trailing text");
+        }
+
+        switch (*protocol)
+        {
+            case Endpoint::Protocol::ICMPV4:
+                parsed_.push_back(Parsed{Endpoint::make_icmpv4_endpoint(host), *interval});
+                break;
+
+            case Endpoint::Protocol::ICMPV6:
+                parsed_.push_back(Parsed{Endpoint::make_icmpv6_endpoint(host), *interval});
+                break;
+
+            case Endpoint::Protocol::TCP:
+            case Endpoint::Protocol::TCP_PERSISTENT:
+                try
+                {
+                    auto endpoint = (*protocol == Endpoint::Protocol::TCP)
+                                  ? Endpoint::make_tcp_endpoint(host, port)
+                                  : Endpoint::make_tcp_persistent_endpoint(host, port);
+                    parsed_.push_back(Parsed{std::move(endpoint), *interval});
+                }
+                catch (std::runtime_error const&)
+                {
+                    fail("invalid port");
+                }
+                break;
+
+            case Endpoint::Protocol::UDP:
+                try
+                {
+                    auto endpoint = Endpoint::make_udp_endpoint(host, port, std::move(*payload), std::move(expected));
+                    parsed_.push_back(Parsed{std::move(endpoint), *interval});
+                }
+                catch (std::runtime_error const&)
+                {
+                    fail("invalid port");
+                }
+                break;
+
+            case Endpoint::Protocol::HTTP:
+                try
+                {
+                    auto endpoint = Endpoint::make_http_endpoint( host, port, std::move(*payload), status
+                                                                , std::move(expected));
+                    parsed_.push_back(Parsed{std::move(endpoint), *interval});
+                }
+                catch (std::runtime_error const&)
+                {
+                    fail("invalid port, path or status code");
+                }
+                break;
+        }
+    }
+
+    Changes apply()
+    {
+        // Mark listed monitors with the current generation, sweep all others.
+        // Walk backwards: for endpoints listed more than once the last line wins.
+        // Started and stopped monitors reach their loops with one command per loop.
+        auto batch = MonitorEngine::Impl::Batch(*engine_.pimpl_);
+        generation_ += 1;
+        auto changes = Changes();
+        for (auto parsed = parsed_.rbegin(); parsed != parsed_.rend(); ++parsed)
+        {
+            auto it = running_.find(parsed->endpoint);
+            if (it != running_.end() && it->second.generation == generation_)
+            {
+                continue;
+            }
+
+            if (it != running_.end() && it->second.interval == parsed->interval)
+            {
+                it->second.generation = generation_;
+                changes.unchanged += 1;
+                continue;
+            }
+
+            if (it == running_.end())
+            {
+                it = running_.emplace(parsed->endpoint, Running{parsed->interval, generation_, nullptr}).first;
+            }
+            else
+            {
+                // Changed interval: stop the old monitor before starting a new one
+                it->second.monitor.reset();
+                it->second.interval = parsed->interval;
+                it->second.generation = generation_;
+                changes.stopped += 1;
+            }
+
+            it->second.monitor = std::make_unique<HostMonitor>(parsed->endpoint, parsed->interval, engine_);
+            for (auto const& [observer, notifier] : observers_)
+            {
+                attach(*it->second.monitor, observer, notifier);
+            }
+            changes.started += 1;
+        }
+
+        for (auto it = running_.begin(); it != running_.end();)
+        {
+            if (it->second.generation != generation_)
+            {
+                it = running_.erase(it);
+                changes.stopped += 1;
+                continue;
+            }
+            ++it;
+        }
+        return changes;
+    }
+
+    static void attach( HostMonitor& monitor
+                      , std::shared_ptr<HostMonitorObserver> const& observer
+                      , Notifier* notifier)
+    {
+        if (notifier)
+        {
+            monitor.add_observer(observer, *notifier);
+            return;
+        }
+        monitor.add_observer(observer);
+    }
+
+    MonitorEngine&                         engine_;     // Engine executing the connection tests
+    std::vector<Parsed>                    parsed_;     // Endpoints of the last load, capacity is reused
+    std::unordered_map<Endpoint, Running>  running_;    // Running monitors
+    std::vector<Observer>                  observers_;  // Observers added to every monitor
+    std::uint64_t                          generation_; // Number of loads
+};
+
+// Interface Implementation
+MonitorSet::MonitorSet()
+    : MonitorSet(MonitorEngine::get_default())
+{
+}
+
+MonitorSet::MonitorSet(MonitorEngine& engine)
+    : pimpl_(std::make_unique<Impl>(engine))
+{
+}
+
+MonitorSet::~MonitorSet() = default;
+
+MonitorSet::Changes MonitorSet::load_file(std::string const& path)
+{
+    auto file = std::ifstream(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": failed to open " + path);
+    }
+
+    // Read the whole file, the parser only views into the buffer. Sizes aren't
+    // known up front for FIFOs and /proc files, read in chunks until the end.
+    auto buffer = std::string();
+    auto chunk = std::array<char, 65536>();
+    while (file.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || file.gcount() > 0)
+    {
+        buffer.append(chunk.data(), static_cast<std::size_t>(file.gcount()));
+    }
+    if (file.bad())
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": failed to read " + path);
+    }
+    return pimpl_->load(buffer);
+}
+
+MonitorSet::Changes MonitorSet::load(std::string_view list)
+{
+    return pimpl_->load(list);
+}
+
+void MonitorSet::add_observer(std::shared_ptr<HostMonitorObserver> observer)
+{
+    pimpl_->add_observer(std::move(observer), nullptr);
+}
+
+void MonitorSet::add_observer(std::shared_ptr<HostMonitorObserver> observer, Notifier& notifier)
+{
+    pimpl_->add_observer(std::move(observer), &notifier);
+}
+
+void MonitorSet::del_observer(std::shared_ptr<HostMonitorObserver> observer)
+{
+    pimpl_->del_observer(observer);
+}
+
+HostMonitor const* MonitorSet::find(Endpoint const& endpoint) const
+{
+    return pimpl_->find(endpoint);
+}
+
+std::size_t MonitorSet::size() const
+{
+    return pimpl_->size();
+}
+
+} // namespace host_monitor
@@ -0,0 +1,159 @@
+/**
+ * @file      MonitorThread.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <random>
+#include <cstdint>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "MonitorThread.hpp"
+#include "TestConnection.hpp"
+#include "MetricsRegistry.hpp"
+
+namespace host_monitor
+{
+
+MonitorThread::MonitorThread(std::shared_ptr<HostMonitor::Impl> monitor, std::shared_ptr<RateLimiter> limiter)
+    : control_(std::make_shared<Control>())
+    , thread_()
+{
+    control_->shutdown = false;
+    control_->cancel = Socket(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    thread_ = std::thread(&MonitorThread::monitor_target, std::move(monitor), std::move(limiter), control_);
+}
+
+MonitorThread::~MonitorThread()
+{
+    {
+        auto lock = std::unique_lock<std::mutex>(control_->mtx);
+        control_->shutdown = true;
+        control_->cv.notify_one();
+    }
+
+    // Abort an in-flight connection test
+    auto one = std::uint64_t(1);
+    [[maybe_unused]] auto n = ::write(control_->cancel.get(), &one, sizeof(one));
+
+    if (std::this_thread::get_id() == thread_.get_id())
+    {
+        thread_.detach();
+    }
+    else
+    {
+        thread_.join();
+    }
+}
+
+void MonitorThread::monitor_target( std::shared_ptr<HostMonitor::Impl> monitor
+                                  , std::shared_ptr<RateLimiter>       limiter
+                                  , std::shared_ptr<Control>           control)
+{
+    auto is_shutdown = [&control] ()
+    {
+        auto lock = std::lock_guard<std::mutex>(control->mtx);
+        return control->shutdown;
+    };
+
+    // Sleep until the given time or a shutdown is initiated. Returns false on shutdown.
+    auto sleep_until = [&control] (std::chrono::steady_clock::time_point when)
+    {
+        auto lock = std::unique_lock<std::mutex>(control->mtx);
+        return !control->cv.wait_until(lock, when, [&control] () { return control->shutdown; });
+    };
+
+    // Connection kept alive between connection tests
+    auto connection = Socket();
+    auto context = ProbeContext();
+    context.connection = &connection;
+    context.keepalive = monitor->get_schedule().interval;
+    auto protocol = monitor->get_endpoint().get_protocol();
+    auto priority = monitor->get_schedule().priority;
+    auto watch = protocol == Endpoint::Protocol::TCP_PERSISTENT;
+
+    // Spread the first tests of monitors registered at once
+    auto spread = std::min(limiter->get_startup_spread(), RateLimiter::Clock::duration(monitor->get_interval()));
+    if (spread.count() > 0)
+    {
+        auto rng = std::minstd_rand(std::random_device()());
+        auto dist = std::uniform_int_distribution<RateLimiter::Clock::rep>(0, spread.count());
+        sleep_until(std::chrono::steady_clock::now() + RateLimiter::Clock::duration(dist(rng)));
+    }
+
+    while (!is_shutdown())
+    {
+        // Children of a down endpoint are rechecked at their base interval
+        if (monitor->is_parent_down())
+        {
+            MetricsRegistry::get().record_probe_suppressed(protocol);
+            monitor->report_unreachable();
+            if (!sleep_until(std::chrono::steady_clock::now() + monitor->get_interval()))
+            {
+                break;
+            }
+            continue;
+        }
+
+        // Wait for the slot reserved at the rate limiter
+        auto now = std::chrono::steady_clock::now();
+        auto slot = limiter->reserve(protocol, priority, now);
+        if (slot > now)
+        {
+            MetricsRegistry::get().record_rate_limited(protocol);
+            if (!sleep_until(slot))
+            {
+                break;
+            }
+        }
+
+        // Perform connection test
+        auto started = std::chrono::steady_clock::now();
+        auto probe = make_probe(monitor->get_endpoint(), context);
+        auto available = probe && run_probe( *probe, started + monitor->get_schedule().timeout
+                                           , control->cancel.get()) == Probe::Status::UP;
+        probe.reset();
+        auto rtt = std::chrono::steady_clock::now() - started;
+
+        // Discard the result if the monitor was removed meanwhile
+        if (is_shutdown())
+        {
+            break;
+        }
+        auto interval = monitor->advance_schedule(available);
+        monitor->report(available, rtt);
+
+        // Watch the persistent connection while idle, a hang-up or error tests right away.
+        // The cancel descriptor stays readable once a shutdown is initiated.
+        if (watch && connection.is_valid())
+        {
+            wait_for( connection.get(), POLLRDHUP, control->cancel.get()
+                    , std::chrono::steady_clock::now() + interval);
+            continue;
+        }
+
+        // Sleep until duration expired or a shutdown is initiated
+        auto lock = std::unique_lock<std::mutex>(control->mtx);
+        auto pred = [&control] ()
+        {
+            return control->shutdown;
+        };
+        auto wait_start = std::chrono::steady_clock::now();
+        if (!control->cv.wait_for(lock, interval, pred))
+        {
+            MetricsRegistry::get().record_scheduler_lag(std::chrono::steady_clock::now() - (wait_start + interval));
+        }
+    }
+}
+
+} // namespace host_monitor
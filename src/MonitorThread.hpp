@@ -0,0 +1,77 @@
+/**
+ * @file      MonitorThread.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef MONITORTHREAD_HPP_202610161230
+#define MONITORTHREAD_HPP_202610161230
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+#include "HostMonitorImpl.hpp"
+#include "RateLimiter.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Dedicated thread performing the connection tests of a single monitor.
+ * @note  Used by MonitorEngine in THREAD_PER_MONITOR mode.
+ */
+class MonitorThread
+{
+public:
+    /**
+     * @brief Constructor. Starts the thread, the first test is performed immediately
+     *        or at a random offset within the startup spread of @p limiter.
+     * @param[in] monitor   The monitor the results are reported to.
+     * @param[in] limiter   Rate limit of connection tests, shared by all threads of an engine.
+     */
+    MonitorThread(std::shared_ptr<HostMonitor::Impl> monitor, std::shared_ptr<RateLimiter> limiter);
+
+    /**
+     * @brief Destructor. Stops the thread and waits for it to finish.
+     * @note  An in-flight connection test is cancelled, the destructor doesn't wait for
+     *        its deadline. If called from within an observer on this thread, the thread
+     *        is detached instead.
+     */
+    ~MonitorThread();
+
+    /* Disable copying and moving */
+    MonitorThread(MonitorThread const& other) = delete;
+    MonitorThread(MonitorThread&& other) = delete;
+    MonitorThread& operator = (MonitorThread const& other) = delete;
+    MonitorThread&& operator = (MonitorThread&& other) = delete;
+
+private:
+    // State shared with the thread, survives a detached thread
+    struct Control
+    {
+        std::mutex              mtx;      // Mutex to use with condition variables
+        std::condition_variable cv;       // Thread sleeping condition
+        bool                    shutdown; // Thread life-time management Flag
+        Socket                  cancel;   // eventfd cancelling an in-flight connection test
+    };
+
+    static void monitor_target( std::shared_ptr<HostMonitor::Impl> monitor
+                              , std::shared_ptr<RateLimiter>       limiter
+                              , std::shared_ptr<Control>           control);
+
+    std::shared_ptr<Control> control_; // State shared with the thread
+    std::thread              thread_;  // Thread performing periodic tests
+};
+
+} // namespace host_monitor
+
+#endif // MONITORTHREAD_HPP_202610161230
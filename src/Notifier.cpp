@@ -0,0 +1,191 @@
+/**
+ * @file      Notifier.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include "NotifierImpl.hpp"
+#include "HostMonitorImpl.hpp"
+#include "MetricsRegistry.hpp"
+
+namespace host_monitor
+{
+
+Notifier::Impl::Impl(std::size_t capacity, OverflowPolicy policy)
+    : queue_(capacity)
+    , policy_(policy)
+    , mtx_()
+    , counters_()
+    , sweep_size_(64)
+    , cv_()
+    , waiting_(false)
+    , shutdown_(false)
+    , thread_()
+{
+    thread_ = std::thread(&Impl::run, this);
+}
+
+Notifier::Impl::~Impl()
+{
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        shutdown_ = true;
+        cv_.notify_one();
+    }
+    thread_.join();
+}
+
+std::shared_ptr<Notifier::Impl::Counters>
+Notifier::Impl::subscribe(std::shared_ptr<HostMonitorObserver> const& observer)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+
+    // Evict counters of destroyed observers once the map doubled in size
+    if (counters_.size() >= sweep_size_)
+    {
+        for (auto it = counters_.begin(); it != counters_.end();)
+        {
+            it = it->first.expired() ? counters_.erase(it) : std::next(it);
+        }
+        sweep_size_ = std::max<std::size_t>(64, counters_.size() * 2);
+    }
+
+    auto& counters = counters_[observer];
+    if (!counters)
+    {
+        counters = std::make_shared<Counters>();
+    }
+    return counters;
+}
+
+void Notifier::Impl::post( std::shared_ptr<HostMonitor::Impl const> monitor
+                         , std::shared_ptr<HostMonitorObserver>     observer
+                         , std::shared_ptr<Counters>                counters
+                         , bool                                     available
+                         , bool                                     unreachable)
+{
+    // Counters outlive the notification, the caller holds a reference
+    auto* stats = counters.get();
+    auto notification = Notification{ std::move(monitor), std::move(observer)
+                                    , std::move(counters), available, unreachable};
+
+    stats->queued += 1;
+    while (!queue_.try_push(notification))
+    {
+        if (policy_ == OverflowPolicy::DROP_NEWEST)
+        {
+            stats->queued -= 1;
+            stats->dropped += 1;
+            return;
+        }
+
+        if (policy_ == OverflowPolicy::DROP_OLDEST)
+        {
+            auto oldest = Notification();
+            if (queue_.try_pop(oldest))
+            {
+                oldest.counters->queued -= 1;
+                oldest.counters->dropped += 1;
+            }
+            continue;
+        }
+        std::this_thread::yield();
+    }
+
+    // Pairs with the fence in run(): either the notifier thread sees the
+    // notification or this thread sees the notifier waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.exchange(false))
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        cv_.notify_one();
+    }
+}
+
+Notifier::Statistics
+Notifier::Impl::get_statistics(std::shared_ptr<HostMonitorObserver> const& observer) const
+{
+    auto stats = Statistics();
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    auto it = counters_.find(observer);
+    if (it != counters_.end())
+    {
+        stats.queued = it->second->queued;
+        stats.delivered = it->second->delivered;
+        stats.dropped = it->second->dropped;
+    }
+    return stats;
+}
+
+void Notifier::Impl::run()
+{
+    while (true)
+    {
+        auto notification = Notification();
+        if (queue_.try_pop(notification))
+        {
+            deliver(notification);
+            continue;
+        }
+
+        // Queue drained, wait for new notifications or the shutdown
+        auto lock = std::unique_lock<std::mutex>(mtx_);
+        if (shutdown_)
+        {
+            break;
+        }
+
+        waiting_ = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (queue_.try_pop(notification))
+        {
+            waiting_ = false;
+            lock.unlock();
+            deliver(notification);
+            continue;
+        }
+
+        cv_.wait(lock, [this] ()
+        {
+            return !waiting_ || shutdown_;
+        });
+        waiting_ = false;
+    }
+}
+
+void Notifier::Impl::deliver(Notification& notification)
+{
+    auto const& monitor = *notification.monitor;
+    auto const data = HostMonitorObserver::Data{ monitor.get_endpoint(), monitor.get_interval()
+                                               , notification.available, notification.unreachable};
+    auto started = std::chrono::steady_clock::now();
+    notification.observer->state_change(data);
+    MetricsRegistry::get().record_observer_call(std::chrono::steady_clock::now() - started);
+
+    notification.counters->queued -= 1;
+    notification.counters->delivered += 1;
+}
+
+// Interface Implementation
+Notifier::Notifier(std::size_t capacity, OverflowPolicy policy)
+    : pimpl_(std::make_unique<Impl>(capacity, policy))
+{
+}
+
+Notifier::~Notifier() = default;
+
+Notifier::Statistics Notifier::get_statistics(std::shared_ptr<HostMonitorObserver> const& observer) const
+{
+    return pimpl_->get_statistics(observer);
+}
+
+} // namespace host_monitor
@@ -0,0 +1,99 @@
+/**
+ * @file      NotifierImpl.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef NOTIFIERIMPL_HPP_202610161800
+#define NOTIFIERIMPL_HPP_202610161800
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <condition_variable>
+
+#include "Notifier.hpp"
+#include "HostMonitor.hpp"
+#include "BoundedQueue.hpp"
+
+namespace host_monitor
+{
+
+class Notifier::Impl
+{
+public:
+    /// @brief Delivery counters of a single observer.
+    struct Counters
+    {
+        std::atomic<std::size_t>   queued{0};    ///< State changes waiting for delivery.
+        std::atomic<std::uint64_t> delivered{0}; ///< State changes delivered.
+        std::atomic<std::uint64_t> dropped{0};   ///< State changes discarded on overflow.
+    };
+
+    Impl(std::size_t capacity, OverflowPolicy policy);
+
+    ~Impl();
+
+    /**
+     * @brief Get counters of an observer.
+     * @param[in] observer   The observer state changes are posted for.
+     * @returns counters to pass to post(). Shared by all monitors of @p observer.
+     */
+    std::shared_ptr<Counters> subscribe(std::shared_ptr<HostMonitorObserver> const& observer);
+
+    /**
+     * @brief Queue a state change for delivery.
+     * @param[in] monitor     The monitor that changed its state. Kept alive until delivery.
+     * @param[in] observer    The observer to inform.
+     * @param[in] counters    Counters of @p observer, obtained by subscribe().
+     * @param[in] available     The new availability.
+     * @param[in] unreachable   true if the endpoint it depends on is down.
+     */
+    void post( std::shared_ptr<HostMonitor::Impl const> monitor
+             , std::shared_ptr<HostMonitorObserver>     observer
+             , std::shared_ptr<Counters>                counters
+             , bool                                     available
+             , bool                                     unreachable);
+
+    Statistics get_statistics(std::shared_ptr<HostMonitorObserver> const& observer) const;
+
+private:
+    // Queued state change
+    struct Notification
+    {
+        std::shared_ptr<HostMonitor::Impl const> monitor;
+        std::shared_ptr<HostMonitorObserver>     observer;
+        std::shared_ptr<Counters>                counters;
+        bool                                     available = false;
+        bool                                     unreachable = false;
+    };
+
+    using CounterMap = std::map< std::weak_ptr<HostMonitorObserver>, std::shared_ptr<Counters>
+                               , std::owner_less<std::weak_ptr<HostMonitorObserver>>>;
+
+    void run();
+
+    void deliver(Notification& notification);
+
+    BoundedQueue<Notification> queue_;      // Queued state changes
+    OverflowPolicy             policy_;     // Handling of a full queue
+    mutable std::mutex         mtx_;        // Lock for synchronizing access to counters_, sweep_size_ and shutdown_, used by cv_
+    CounterMap                 counters_;   // Counters by observer
+    std::size_t                sweep_size_; // Size of counters_ that triggers evicting expired observers
+    std::condition_variable    cv_;         // Wakes the notifier thread
+    std::atomic<bool>          waiting_;    // Notifier thread waits for cv_
+    bool                       shutdown_;   // Thread life-time management Flag
+    std::thread                thread_;     // Notifier thread
+};
+
+} // namespace host_monitor
+
+#endif // NOTIFIERIMPL_HPP_202610161800
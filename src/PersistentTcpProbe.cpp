@@ -0,0 +1,171 @@
+/**
+ * @file      PersistentTcpProbe.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <cerrno>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "PersistentTcpProbe.hpp"
+#include "TcpProbe.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Idle time before keepalives if none is given
+constexpr auto DEFAULT_KEEPALIVE = std::chrono::seconds(10);
+
+// Interval of keepalive probes and number of probes before the connection is dropped
+constexpr auto KEEPALIVE_INTERVAL = std::chrono::seconds(1);
+constexpr auto KEEPALIVE_COUNT = 3;
+
+// Unanswered keepalives or retransmissions marking a connection as stalled
+constexpr auto MAX_UNANSWERED = 2;
+
+// Reads discarding data of the peer per check
+constexpr auto MAX_DRAIN_READS = 16;
+
+void enable_keepalive(Socket const& sock, std::chrono::milliseconds keepalive)
+{
+    auto idle_time = std::chrono::ceil<std::chrono::seconds>(keepalive);
+    if (idle_time.count() <= 0)
+    {
+        idle_time = DEFAULT_KEEPALIVE;
+    }
+
+    auto on = 1;
+    auto idle = static_cast<int>(idle_time.count());
+    auto interval = static_cast<int>(KEEPALIVE_INTERVAL.count());
+    auto count = KEEPALIVE_COUNT;
+    ::setsockopt(sock.get(), SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    ::setsockopt(sock.get(), IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    ::setsockopt(sock.get(), IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+    ::setsockopt(sock.get(), IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count));
+
+    // Unacknowledged keepalives drop the connection once the user timeout expired
+    auto user_timeout = static_cast<unsigned>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(idle_time + KEEPALIVE_INTERVAL * count).count());
+    ::setsockopt(sock.get(), IPPROTO_TCP, TCP_USER_TIMEOUT, &user_timeout, sizeof(user_timeout));
+}
+} // anon namespace
+
+ConnectionHealth check_connection(Socket const& sock)
+{
+    auto err = 0;
+    auto len = socklen_t(sizeof(err));
+    if (::getsockopt(sock.get(), SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0)
+    {
+        return ConnectionHealth::DEAD;
+    }
+
+    // Discard data sent by the peer, a pending FIN reads as end of file
+    auto buffer = std::array<char, 512>();
+    for (auto i = 0; i < MAX_DRAIN_READS; ++i)
+    {
+        auto n = ::recv(sock.get(), buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (n == 0)
+        {
+            return ConnectionHealth::DEAD;
+        }
+        if (n < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                return ConnectionHealth::DEAD;
+            }
+            break;
+        }
+    }
+
+    auto info = tcp_info();
+    len = socklen_t(sizeof(info));
+    if (::getsockopt(sock.get(), IPPROTO_TCP, TCP_INFO, &info, &len) < 0 || info.tcpi_state != TCP_ESTABLISHED)
+    {
+        return ConnectionHealth::DEAD;
+    }
+
+    if (MAX_UNANSWERED <= info.tcpi_probes || MAX_UNANSWERED <= info.tcpi_retransmits)
+    {
+        return ConnectionHealth::STALLED;
+    }
+    return ConnectionHealth::ALIVE;
+}
+
+PersistentTcpProbe::PersistentTcpProbe(Address address, std::chrono::milliseconds keepalive, Socket* idle)
+    : address_(std::move(address))
+    , keepalive_(keepalive)
+    , idle_(idle)
+    , sock_()
+{
+}
+
+Probe::Status PersistentTcpProbe::start()
+{
+    if (idle_ && idle_->is_valid())
+    {
+        switch (check_connection(*idle_))
+        {
+            case ConnectionHealth::ALIVE:
+                return Status::UP;
+
+            case ConnectionHealth::STALLED:
+                // Keep the connection, it recovers or is dropped by the kernel
+                return Status::DOWN;
+
+            case ConnectionHealth::DEAD:
+                *idle_ = Socket();
+                break;
+        }
+    }
+
+    sock_ = tcp_connect_start(address_);
+    if (!sock_.is_valid())
+    {
+        return Status::DOWN;
+    }
+
+    if (idle_)
+    {
+        enable_keepalive(sock_, keepalive_);
+    }
+    return Status::PENDING;
+}
+
+int PersistentTcpProbe::get_fd() const
+{
+    return sock_.get();
+}
+
+std::uint32_t PersistentTcpProbe::get_events() const
+{
+    return POLLOUT;
+}
+
+Probe::Status PersistentTcpProbe::on_event(std::uint32_t)
+{
+    if (!tcp_connect_finish(sock_))
+    {
+        return Status::DOWN;
+    }
+
+    if (idle_)
+    {
+        *idle_ = std::move(sock_);
+    }
+    return Status::UP;
+}
+
+} // namespace host_monitor
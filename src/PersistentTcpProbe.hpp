@@ -0,0 +1,78 @@
+/**
+ * @file      PersistentTcpProbe.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef PERSISTENTTCPPROBE_HPP_202610170900
+#define PERSISTENTTCPPROBE_HPP_202610170900
+
+#include <chrono>
+#include <cstdint>
+
+#include "Probe.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+/// @brief Health of an established TCP connection.
+enum class ConnectionHealth
+{
+    ALIVE = 0, ///< Established, the peer acknowledges.
+    STALLED,   ///< Established, but keepalives or data are not acknowledged.
+    DEAD,      ///< Closed, reset or timed out.
+};
+
+/**
+ * @brief Check a connection without sending anything.
+ * @note  Data sent by the peer, e.g. a service banner, is discarded.
+ * @param[in] sock   The connection to check.
+ * @returns health of @p sock, based on SO_ERROR, a pending FIN and TCP_INFO.
+ */
+ConnectionHealth check_connection(Socket const& sock);
+
+/**
+ * @brief Probe keeping a TCP connection open between tests.
+ * @note  An idle connection left by the previous probe is checked locally,
+ *        no packets are sent. Only dead connections are replaced by a new one.
+ *        New connections enable kernel keepalives and TCP_USER_TIMEOUT, a peer
+ *        that vanished silently kills the connection within a few seconds
+ *        after @p keepalive.
+ */
+class PersistentTcpProbe : public Probe
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] address     Resolved address of the target, including the port.
+     * @param[in] keepalive   Idle time before keepalives are sent. 0 for the default.
+     * @param[in] idle        Slot holding the connection between probes. nullptr to
+     *                        close the connection after the test.
+     */
+    PersistentTcpProbe(Address address, std::chrono::milliseconds keepalive, Socket* idle);
+
+    Status start() override;
+
+    int get_fd() const override;
+
+    std::uint32_t get_events() const override;
+
+    Status on_event(std::uint32_t events) override;
+
+private:
+    Address                   address_;   // Target address
+    std::chrono::milliseconds keepalive_; // Idle time before keepalives
+    Socket*                   idle_;      // Slot of the idle connection
+    Socket                    sock_;      // Connecting socket
+};
+
+} // namespace host_monitor
+
+#endif // PERSISTENTTCPPROBE_HPP_202610170900
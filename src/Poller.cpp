@@ -0,0 +1,105 @@
+/**
+ * @file      Poller.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+#include <sys/epoll.h>
+
+#include "Poller.hpp"
+#include "Socket.hpp"
+#include "UringPoller.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Poller based on epoll(7). Each registration change costs a system call.
+class EpollPoller : public Poller
+{
+public:
+    EpollPoller()
+        : epoll_(::epoll_create1(EPOLL_CLOEXEC))
+    {
+        if (!epoll_.is_valid())
+        {
+            throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                     ": failed to create epoll instance");
+        }
+    }
+
+    Backend get_backend() const override
+    {
+        return Backend::EPOLL;
+    }
+
+    bool add(int fd, std::uint32_t events, std::uint64_t id) override
+    {
+        return control(EPOLL_CTL_ADD, fd, events, id);
+    }
+
+    bool modify(int fd, std::uint32_t events, std::uint64_t id) override
+    {
+        return control(EPOLL_CTL_MOD, fd, events, id);
+    }
+
+    void remove(int fd) override
+    {
+        ::epoll_ctl(epoll_.get(), EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    std::size_t wait(PollEvent* events, std::size_t max, int timeout_ms) override
+    {
+        auto ready = std::array<epoll_event, 256>();
+        auto n = ::epoll_wait( epoll_.get(), ready.data()
+                             , static_cast<int>(std::min(max, ready.size())), timeout_ms);
+        if (n <= 0)
+        {
+            return 0;
+        }
+
+        for (auto i = std::size_t(0); i < static_cast<std::size_t>(n); ++i)
+        {
+            events[i] = PollEvent{ready[i].data.u64, ready[i].events};
+        }
+        return static_cast<std::size_t>(n);
+    }
+
+private:
+    bool control(int op, int fd, std::uint32_t events, std::uint64_t id)
+    {
+        auto ev = epoll_event();
+        ev.events = events;
+        ev.data.u64 = id;
+        return ::epoll_ctl(epoll_.get(), op, fd, &ev) == 0;
+    }
+
+    Socket epoll_; // epoll instance
+};
+} // anon namespace
+
+std::unique_ptr<Poller> Poller::create(Backend backend)
+{
+    if (backend == Backend::IO_URING)
+    {
+        auto uring = std::make_unique<UringPoller>();
+        if (uring->is_valid())
+        {
+            return uring;
+        }
+    }
+    return std::make_unique<EpollPoller>();
+}
+
+} // namespace host_monitor
@@ -0,0 +1,94 @@
+/**
+ * @file      Poller.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef POLLER_HPP_202610171100
+#define POLLER_HPP_202610171100
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "MonitorEngine.hpp"
+
+namespace host_monitor
+{
+
+/// @brief Readiness of a registered file descriptor.
+struct PollEvent
+{
+    std::uint64_t id;     ///< Id the file descriptor was registered with.
+    std::uint32_t events; ///< Signaled epoll(7) events.
+};
+
+/**
+ * @brief Level-triggered readiness notification, the I/O backend of an EventLoop.
+ * @note  Events use the epoll(7) bit layout. Errors and hang-ups are always reported.
+ *        A file descriptor must be removed before it is closed.
+ */
+class Poller
+{
+public:
+    using Backend = MonitorEngine::Backend;
+
+    /**
+     * @brief Create a poller.
+     * @param[in] backend   Preferred backend. IO_URING falls back to EPOLL if the kernel doesn't support it.
+     * @returns poller of @p backend or of the fallback.
+     * @throws std::runtime_error in case no poller can be created.
+     */
+    static std::unique_ptr<Poller> create(Backend backend);
+
+    virtual ~Poller() = default;
+
+    /**
+     * @brief Get backend of the poller.
+     * @returns backend in use.
+     */
+    virtual Backend get_backend() const = 0;
+
+    /**
+     * @brief Register a file descriptor.
+     * @param[in] fd       The file descriptor to watch.
+     * @param[in] events   Events to wait for.
+     * @param[in] id       Id reported with the events of @p fd.
+     * @returns true on success.
+     */
+    virtual bool add(int fd, std::uint32_t events, std::uint64_t id) = 0;
+
+    /**
+     * @brief Change events and id of a registered file descriptor.
+     * @param[in] fd       The registered file descriptor.
+     * @param[in] events   Events to wait for.
+     * @param[in] id       Id reported with the events of @p fd.
+     * @returns true on success.
+     */
+    virtual bool modify(int fd, std::uint32_t events, std::uint64_t id) = 0;
+
+    /**
+     * @brief Unregister a file descriptor. Pending events of @p fd are discarded.
+     * @param[in] fd   The registered file descriptor.
+     */
+    virtual void remove(int fd) = 0;
+
+    /**
+     * @brief Wait for events.
+     * @param[out] events       Receives the signaled events.
+     * @param[in]  max          Capacity of @p events.
+     * @param[in]  timeout_ms   Maximum time to wait in milliseconds. -1 waits forever.
+     * @returns number of events stored in @p events. 0 on timeout or interruption.
+     */
+    virtual std::size_t wait(PollEvent* events, std::size_t max, int timeout_ms) = 0;
+};
+
+} // namespace host_monitor
+
+#endif // POLLER_HPP_202610171100
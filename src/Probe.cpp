@@ -0,0 +1,39 @@
+/**
+ * @file      Probe.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "Probe.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+Probe::Status run_probe( Probe&                                probe
+                       , std::chrono::steady_clock::time_point deadline
+                       , int                                   cancel_fd)
+{
+    auto status = probe.start();
+    while (status == Probe::Status::PENDING)
+    {
+        auto events = wait_for( probe.get_fd()
+                              , static_cast<short>(probe.get_events())
+                              , cancel_fd
+                              , deadline);
+        if (events == 0)
+        {
+            return Probe::Status::DOWN;
+        }
+        status = probe.on_event(static_cast<std::uint16_t>(events));
+    }
+    return status;
+}
+
+} // namespace host_monitor
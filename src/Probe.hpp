@@ -0,0 +1,83 @@
+/**
+ * @file      Probe.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef PROBE_HPP_202610161140
+#define PROBE_HPP_202610161140
+
+#include <chrono>
+#include <cstdint>
+
+namespace host_monitor
+{
+
+/// @brief Maximum time a single probe may take before it counts as failed.
+inline constexpr auto DEFAULT_PROBE_TIMEOUT = std::chrono::milliseconds(1000);
+
+/**
+ * @brief Non-blocking connection test.
+ * @note  A probe is a small state machine driven by readiness events of a
+ *        single file descriptor. It can be driven by an event loop or by
+ *        run_probe() in a blocking fashion. Deadlines are enforced by the driver.
+ */
+class Probe
+{
+public:
+    /// @brief Result of a probe step.
+    enum class Status
+    {
+        PENDING = 0, ///< Probe waits for events on its file descriptor.
+        UP,          ///< Target was reachable.
+        DOWN,        ///< Target was not reachable.
+    };
+
+    virtual ~Probe() = default;
+
+    /**
+     * @brief Start the connection test.
+     * @returns PENDING if the probe waits for events, UP or DOWN if it finished.
+     */
+    virtual Status start() = 0;
+
+    /**
+     * @brief Get file descriptor the probe waits on.
+     * @returns file descriptor, valid while the probe is PENDING.
+     */
+    virtual int get_fd() const = 0;
+
+    /**
+     * @brief Get events the probe waits for.
+     * @returns poll(2) / epoll(7) event mask.
+     */
+    virtual std::uint32_t get_events() const = 0;
+
+    /**
+     * @brief Advance the probe after its file descriptor became ready.
+     * @param[in] events   The signaled events.
+     * @returns PENDING if the probe waits for further events, UP or DOWN if it finished.
+     */
+    virtual Status on_event(std::uint32_t events) = 0;
+};
+
+/**
+ * @brief Drive a probe until it finished, blocking the calling thread.
+ * @param[in] probe       The probe to run.
+ * @param[in] deadline    Point in time after that the probe counts as failed.
+ * @param[in] cancel_fd   File descriptor aborting the probe once readable. -1 if not cancellable.
+ * @returns UP or DOWN. DOWN if the probe was cancelled.
+ */
+Probe::Status run_probe( Probe&                                probe
+                       , std::chrono::steady_clock::time_point deadline
+                       , int                                   cancel_fd = -1);
+
+} // namespace host_monitor
+
+#endif // PROBE_HPP_202610161140
@@ -0,0 +1,121 @@
+/**
+ * @file      RateLimiter.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "RateLimiter.hpp"
+
+namespace host_monitor
+{
+
+RateLimiter::RateLimiter()
+    : global_()
+    , protocols_()
+    , limited_(false)
+    , spread_(0)
+    , mtx_()
+{
+}
+
+void RateLimiter::set_limit(MonitorEngine::RateLimit limit)
+{
+    update(global_, limit);
+}
+
+void RateLimiter::set_limit(Endpoint::Protocol protocol, MonitorEngine::RateLimit limit)
+{
+    update(protocols_.at(static_cast<std::size_t>(protocol)), limit);
+}
+
+void RateLimiter::set_startup_spread(Clock::duration spread)
+{
+    if (spread.count() < 0)
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": negative startup spread");
+    }
+    spread_.store(spread.count(), std::memory_order_relaxed);
+}
+
+RateLimiter::Clock::duration RateLimiter::get_startup_spread() const
+{
+    return Clock::duration(spread_.load(std::memory_order_relaxed));
+}
+
+RateLimiter::Clock::time_point RateLimiter::reserve( Endpoint::Protocol    protocol
+                                                   , HostMonitor::Priority priority
+                                                   , Clock::time_point     now)
+{
+    if (!limited_.load(std::memory_order_relaxed))
+    {
+        return now;
+    }
+
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    auto buckets = std::array<Bucket*, 2>{&global_, &protocols_[static_cast<std::size_t>(protocol)]};
+
+    // A test conforms once the arrival time of each bucket lies within its tolerance.
+    // High priority tests conform right away, low priority ones leave half of the burst to others.
+    auto start = now;
+    for (auto const* bucket : buckets)
+    {
+        if (bucket->emission.count() == 0 || priority == HostMonitor::Priority::HIGH)
+        {
+            continue;
+        }
+
+        auto tolerance = (priority == HostMonitor::Priority::LOW) ? bucket->tolerance / 2 : bucket->tolerance;
+        start = std::max(start, bucket->tat - tolerance);
+    }
+
+    // Book the start in all buckets, even if that exceeds the budget
+    for (auto* bucket : buckets)
+    {
+        if (bucket->emission.count() != 0)
+        {
+            bucket->tat = std::max(bucket->tat, start) + bucket->emission;
+        }
+    }
+    return start;
+}
+
+void RateLimiter::update(Bucket& bucket, MonitorEngine::RateLimit limit)
+{
+    if (!std::isfinite(limit.probes_per_second) || limit.probes_per_second < 0.0 || limit.burst == 0)
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": invalid rate limit");
+    }
+
+    auto emission = Clock::duration(0);
+    if (limit.probes_per_second > 0.0)
+    {
+        auto period = std::chrono::duration<double>(1.0 / limit.probes_per_second);
+        emission = std::max(std::chrono::duration_cast<Clock::duration>(period), Clock::duration(1));
+    }
+
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    bucket.emission = emission;
+    bucket.tolerance = emission * (limit.burst - 1);
+
+    auto limited = global_.emission.count() != 0;
+    for (auto const& each : protocols_)
+    {
+        limited = limited || each.emission.count() != 0;
+    }
+    limited_.store(limited, std::memory_order_relaxed);
+}
+
+} // namespace host_monitor
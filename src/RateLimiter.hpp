@@ -0,0 +1,104 @@
+/**
+ * @file      RateLimiter.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef RATELIMITER_HPP_202610171500
+#define RATELIMITER_HPP_202610171500
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <cstddef>
+
+#include "Endpoint.hpp"
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Process wide token buckets limiting the start of connection tests.
+ * @note  Implemented as generic cell rate algorithm: instead of waiting for a token,
+ *        each test reserves the earliest start its buckets allow and books it right
+ *        away. Tests due at once are spread evenly, later tests queue behind them.
+ *        Thread-safe. Without any limit, reserve() doesn't lock.
+ */
+class RateLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RateLimiter();
+
+    /**
+     * @brief Set limit of all connection tests.
+     * @throws std::runtime_error in case @p limit is invalid.
+     * @param[in] limit   The new limit.
+     */
+    void set_limit(MonitorEngine::RateLimit limit);
+
+    /**
+     * @brief Set limit of the connection tests of one protocol.
+     * @throws std::runtime_error in case @p limit is invalid.
+     * @param[in] protocol   Protocol the limit applies to.
+     * @param[in] limit      The new limit.
+     */
+    void set_limit(Endpoint::Protocol protocol, MonitorEngine::RateLimit limit);
+
+    /**
+     * @brief Set duration the first tests of new monitors are spread over.
+     * @throws std::runtime_error in case @p spread is negative.
+     * @param[in] spread   The new spread.
+     */
+    void set_startup_spread(Clock::duration spread);
+
+    Clock::duration get_startup_spread() const;
+
+    /**
+     * @brief Reserve the start of a connection test.
+     * @param[in] protocol   Protocol of the test.
+     * @param[in] priority   Priority of the tested monitor.
+     * @param[in] now        Earliest start of the test.
+     * @returns start of the test, @p now if it must not be delayed.
+     */
+    Clock::time_point reserve(Endpoint::Protocol protocol, HostMonitor::Priority priority, Clock::time_point now);
+
+    /* Disable copying and moving */
+    RateLimiter(RateLimiter const& other) = delete;
+    RateLimiter(RateLimiter&& other) = delete;
+    RateLimiter& operator = (RateLimiter const& other) = delete;
+    RateLimiter&& operator = (RateLimiter&& other) = delete;
+
+private:
+    static constexpr std::size_t PROTOCOLS = Endpoint::PROTOCOL_COUNT;
+
+    // Token bucket in terms of its theoretical arrival time
+    struct Bucket
+    {
+        Clock::duration   emission = Clock::duration(0);  // Time per test. 0 is unlimited.
+        Clock::duration   tolerance = Clock::duration(0); // Emission of the burst beyond the first test
+        Clock::time_point tat;                            // Theoretical arrival time of the next test
+    };
+
+    void update(Bucket& bucket, MonitorEngine::RateLimit limit);
+
+    Bucket                          global_;    // Limit of all tests
+    std::array<Bucket, PROTOCOLS>   protocols_; // Limits by protocol
+    std::atomic<bool>               limited_;   // Any bucket is limited
+    std::atomic<Clock::rep>         spread_;    // Duration first tests are spread over
+    std::mutex                      mtx_;       // Lock for synchronizing access to the buckets
+};
+
+} // namespace host_monitor
+
+#endif // RATELIMITER_HPP_202610171500
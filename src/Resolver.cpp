@@ -0,0 +1,1214 @@
+/**
+ * @file      Resolver.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <cstring>
+#include <cctype>
+#include <charconv>
+#include <cerrno>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "Resolver.hpp"
+#include "TimerWheel.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// DNS protocol constants, see RFC 1035 and RFC 3596
+std::uint16_t const DNS_PORT       = 53;
+std::uint16_t const TYPE_A         = 1;
+std::uint16_t const TYPE_SOA       = 6;
+std::uint16_t const TYPE_AAAA      = 28;
+std::uint16_t const CLASS_IN       = 1;
+std::uint16_t const FLAG_QR        = 0x8000;
+std::uint16_t const FLAG_TC        = 0x0200;
+std::uint16_t const FLAG_RD        = 0x0100;
+int const           RCODE_OK       = 0;
+int const           RCODE_NXDOMAIN = 3;
+std::size_t const   HEADER_SIZE    = 12;
+std::size_t const   MAX_MESSAGE    = 4096;
+
+// Epoll id of the wakeup eventfd, queries start at 1
+std::uint64_t const WAKEUP_ID = 0;
+
+// Parsed response to a single question
+struct Answer
+{
+    std::uint16_t                id = 0;
+    int                          rcode = 0;
+    bool                         truncated = false; // Response didn't fit, records are incomplete
+    std::vector<Address>         addresses;         // Addresses of the requested type
+    std::optional<std::uint32_t> ttl;               // Lowest TTL of the answer records
+    std::optional<std::uint32_t> negative_ttl;      // TTL of the non-existence, derived from SOA
+};
+
+std::string normalize(std::string const& fqhn)
+{
+    // Names are case-insensitive, a trailing dot marks the root
+    auto name = fqhn;
+    std::transform(name.begin(), name.end(), name.begin(), [] (unsigned char c)
+    {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    if (!name.empty() && name.back() == '.')
+    {
+        name.pop_back();
+    }
+    return name;
+}
+
+std::optional<Address> parse_numeric(std::string const& host, int family)
+{
+    // Numeric host names never block, getaddrinfo handles IPv6 scopes as well
+    auto hints = addrinfo();
+    hints.ai_family = family;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = AI_NUMERICHOST;
+
+    auto* res = static_cast<addrinfo*>(nullptr);
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &res) != 0 || res == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    auto addr = Address();
+    std::memset(&addr.storage, 0, sizeof(addr.storage));
+    std::memcpy(&addr.storage, res->ai_addr, res->ai_addrlen);
+    addr.length = res->ai_addrlen;
+
+    freeaddrinfo(res);
+    return addr;
+}
+
+void put_u16(std::vector<std::uint8_t>& buffer, std::uint16_t value)
+{
+    buffer.push_back(static_cast<std::uint8_t>(value >> 8));
+    buffer.push_back(static_cast<std::uint8_t>(value & 0xFF));
+}
+
+std::uint16_t get_u16(std::uint8_t const* data)
+{
+    return static_cast<std::uint16_t>((data[0] << 8) | data[1]);
+}
+
+std::uint32_t get_u32(std::uint8_t const* data)
+{
+    return (std::uint32_t(get_u16(data)) << 16) | get_u16(data + 2);
+}
+
+std::optional<std::vector<std::uint8_t>> build_query( std::uint16_t id
+                                                    , std::string const& name
+                                                    , std::uint16_t type)
+{
+    auto buffer = std::vector<std::uint8_t>();
+    put_u16(buffer, id);
+    put_u16(buffer, FLAG_RD);
+    put_u16(buffer, 1); // Questions
+    put_u16(buffer, 0); // Answers
+    put_u16(buffer, 0); // Authority records
+    put_u16(buffer, 0); // Additional records
+
+    // Encode name as sequence of length prefixed labels
+    auto rest = std::string_view(name);
+    while (!rest.empty())
+    {
+        auto dot = std::min(rest.find('.'), rest.size());
+        auto label = rest.substr(0, dot);
+        if (label.empty() || label.size() > 63)
+        {
+            return std::nullopt;
+        }
+
+        buffer.push_back(static_cast<std::uint8_t>(label.size()));
+        for (auto c : label)
+        {
+            buffer.push_back(static_cast<std::uint8_t>(c));
+        }
+        rest.remove_prefix(std::min(dot + 1, rest.size()));
+    }
+    buffer.push_back(0);
+
+    if (buffer.size() > HEADER_SIZE + 255)
+    {
+        return std::nullopt;
+    }
+
+    put_u16(buffer, type);
+    put_u16(buffer, CLASS_IN);
+    return buffer;
+}
+
+// Skip a possibly compressed name. Returns offset behind the name or 0 on malformed input.
+std::size_t skip_name(std::uint8_t const* data, std::size_t len, std::size_t offset)
+{
+    while (offset < len)
+    {
+        auto label = data[offset];
+        if ((label & 0xC0) == 0xC0)
+        {
+            return (offset + 2 <= len) ? offset + 2 : 0;
+        }
+
+        if (label == 0)
+        {
+            return offset + 1;
+        }
+        offset += std::size_t(label) + 1;
+    }
+    return 0;
+}
+
+std::optional<Answer> parse_response(std::uint8_t const* data, std::size_t len, std::uint16_t type)
+{
+    if (len < HEADER_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    auto answer = Answer();
+    answer.id = get_u16(data);
+    auto flags = get_u16(data + 2);
+    auto questions = get_u16(data + 4);
+    auto answers = std::size_t(get_u16(data + 6));
+    auto records = answers + get_u16(data + 8);
+    answer.rcode = flags & 0x0F;
+    answer.truncated = (flags & FLAG_TC) != 0;
+
+    if (!(flags & FLAG_QR) || questions != 1)
+    {
+        return std::nullopt;
+    }
+
+    // The question must match the one asked
+    auto offset = skip_name(data, len, HEADER_SIZE);
+    if (offset == 0 || offset + 4 > len || get_u16(data + offset) != type)
+    {
+        return std::nullopt;
+    }
+    offset += 4;
+
+    // Records of truncated responses are incomplete, don't bother parsing them
+    if (answer.truncated)
+    {
+        return answer;
+    }
+
+    // Answer and authority records share their layout
+    for (auto i = std::size_t(0); i < records; ++i)
+    {
+        offset = skip_name(data, len, offset);
+        if (offset == 0 || offset + 10 > len)
+        {
+            return std::nullopt;
+        }
+
+        auto rr_type = get_u16(data + offset);
+        auto rr_class = get_u16(data + offset + 2);
+        auto rr_ttl = get_u32(data + offset + 4);
+        auto rr_len = std::size_t(get_u16(data + offset + 8));
+        auto rdata = data + offset + 10;
+        offset += 10 + rr_len;
+        if (offset > len)
+        {
+            return std::nullopt;
+        }
+
+        if (rr_class != CLASS_IN)
+        {
+            continue;
+        }
+
+        if (i < answers)
+        {
+            // CNAME records along the chain limit the TTL as well
+            answer.ttl = std::min(answer.ttl.value_or(rr_ttl), rr_ttl);
+
+            auto addr = Address();
+            std::memset(&addr.storage, 0, sizeof(addr.storage));
+            if (rr_type == TYPE_A && type == TYPE_A && rr_len == 4)
+            {
+                auto* in = reinterpret_cast<sockaddr_in*>(&addr.storage);
+                in->sin_family = AF_INET;
+                std::memcpy(&in->sin_addr, rdata, 4);
+                addr.length = sizeof(sockaddr_in);
+                answer.addresses.push_back(addr);
+            }
+            else if (rr_type == TYPE_AAAA && type == TYPE_AAAA && rr_len == 16)
+            {
+                auto* in6 = reinterpret_cast<sockaddr_in6*>(&addr.storage);
+                in6->sin6_family = AF_INET6;
+                std::memcpy(&in6->sin6_addr, rdata, 16);
+                addr.length = sizeof(sockaddr_in6);
+                answer.addresses.push_back(addr);
+            }
+        }
+        else if (rr_type == TYPE_SOA && rr_len >= 4)
+        {
+            // RFC 2308: negative answers live min(SOA TTL, SOA MINIMUM)
+            answer.negative_ttl = std::min(rr_ttl, get_u32(rdata + rr_len - 4));
+        }
+    }
+    return answer;
+}
+
+// Names to query for the normalized @p name in turn, see resolv.conf(5)
+std::vector<std::string> expand_name( std::string const& name, bool absolute
+                                    , std::vector<std::string> const& search, std::size_t ndots)
+{
+    auto names = std::vector<std::string>();
+    if (absolute || search.empty())
+    {
+        names.push_back(name);
+        return names;
+    }
+
+    // Names with enough dots are tried as given first, others last
+    auto dots = static_cast<std::size_t>(std::count(name.begin(), name.end(), '.'));
+    if (dots >= ndots)
+    {
+        names.push_back(name);
+    }
+    for (auto const& domain : search)
+    {
+        names.push_back(name + "." + domain);
+    }
+    if (dots < ndots)
+    {
+        names.push_back(name);
+    }
+    return names;
+}
+
+using HostTable = std::unordered_map<std::string, std::vector<Address>>;
+
+HostTable load_hosts(std::string const& path)
+{
+    auto table = HostTable();
+    if (path.empty())
+    {
+        return table;
+    }
+
+    // Format: address name [aliases...] [# comment]
+    auto file = std::ifstream(path);
+    auto line = std::string();
+    while (std::getline(file, line))
+    {
+        line = line.substr(0, line.find('#'));
+        auto stream = std::istringstream(line);
+        auto host = std::string();
+        if (!(stream >> host))
+        {
+            continue;
+        }
+
+        auto address = parse_numeric(host, AF_UNSPEC);
+        if (!address)
+        {
+            continue;
+        }
+
+        auto name = std::string();
+        while (stream >> name)
+        {
+            table[normalize(name)].push_back(*address);
+        }
+    }
+    return table;
+}
+} // anon namespace
+
+// Lookup related implementation
+class Resolver::Lookup
+{
+public:
+    Lookup()
+        : event_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , mtx_()
+        , done_(false)
+        , result_()
+    {
+    }
+
+    explicit Lookup(std::optional<Address> result)
+        : event_()
+        , mtx_()
+        , done_(true)
+        , result_(std::move(result))
+    {
+    }
+
+    void complete(std::optional<Address> result)
+    {
+        {
+            auto lock = std::lock_guard<std::mutex>(mtx_);
+            result_ = std::move(result);
+            done_ = true;
+        }
+
+        // Never read back: stays readable for all waiters
+        auto val = std::uint64_t(1);
+        auto ret = ::write(event_.get(), &val, sizeof(val));
+        static_cast<void>(ret);
+    }
+
+    bool is_done() const
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        return done_;
+    }
+
+    std::optional<Address> get_result() const
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        return result_;
+    }
+
+    int get_fd() const
+    {
+        return event_.get();
+    }
+
+private:
+    Socket                 event_;  // eventfd signaling completion
+    mutable std::mutex     mtx_;    // Lock for synchronizing access to done_ and result_
+    bool                   done_;   // Resolution completed
+    std::optional<Address> result_; // Resolved address
+};
+
+// Request related implementation
+Resolver::Request::Request()
+    : lookup_()
+    , fd_()
+{
+}
+
+bool Resolver::Request::is_done() const
+{
+    return lookup_ && lookup_->is_done();
+}
+
+std::optional<Address> Resolver::Request::get_result() const
+{
+    return lookup_ ? lookup_->get_result() : std::nullopt;
+}
+
+int Resolver::Request::get_fd() const
+{
+    return fd_.get();
+}
+
+// Options related implementation
+Resolver::Options Resolver::Options::from_system()
+{
+    auto options = Options();
+    options.hosts_file = "/etc/hosts";
+    options.timeout = std::chrono::milliseconds(1000);
+    options.attempts = 2;
+    options.min_ttl = std::chrono::seconds(5);
+    options.max_ttl = std::chrono::seconds(3600);
+    options.negative_ttl = std::chrono::seconds(30);
+    options.failure_ttl = std::chrono::seconds(5);
+    options.ndots = 1;
+
+    auto file = std::ifstream("/etc/resolv.conf");
+    auto line = std::string();
+    while (std::getline(file, line))
+    {
+        auto stream = std::istringstream(line);
+        auto keyword = std::string();
+        auto value = std::string();
+        if (!(stream >> keyword))
+        {
+            continue;
+        }
+
+        if (keyword == "nameserver" && stream >> value)
+        {
+            auto server = parse_numeric(value, AF_UNSPEC);
+            if (server)
+            {
+                server->set_port(DNS_PORT);
+                options.nameservers.push_back(*server);
+            }
+        }
+        else if (keyword == "search" || keyword == "domain")
+        {
+            // Exclusive, the last line wins. Domain names a single domain.
+            options.search.clear();
+            while (stream >> value && value[0] != '#' && value[0] != ';')
+            {
+                auto domain = normalize(value);
+                if (!domain.empty())
+                {
+                    options.search.push_back(domain);
+                }
+
+                if (keyword == "domain")
+                {
+                    break;
+                }
+            }
+        }
+        else if (keyword == "options")
+        {
+            // The system resolver caps ndots at 15
+            while (stream >> value)
+            {
+                auto ndots = std::size_t(0);
+                auto const* end = value.data() + value.size();
+                if (value.compare(0, 6, "ndots:") == 0 &&
+                    std::from_chars(value.data() + 6, end, ndots).ptr == end)
+                {
+                    options.ndots = std::min<std::size_t>(ndots, 15);
+                }
+            }
+        }
+    }
+
+    // Like the system resolver: without configuration, ask the local host
+    if (options.nameservers.empty())
+    {
+        auto server = parse_numeric("127.0.0.1", AF_INET).value();
+        server.set_port(DNS_PORT);
+        options.nameservers.push_back(server);
+    }
+    return options;
+}
+
+// Implementation details
+class Resolver::Impl
+{
+public:
+    explicit Impl(Options options);
+
+    ~Impl();
+
+    Request resolve(std::string_view fqhn, int family);
+
+    std::size_t get_cache_size() const;
+
+    void clear_cache();
+
+private:
+    // Cached result of a resolution
+    struct CacheEntry
+    {
+        std::optional<Address> address; // Resolved address, none for negative results
+        Clock::time_point      expires; // End of validity
+    };
+
+    // Resolution waiting to be picked up by the resolver thread
+    struct Submission
+    {
+        std::string              key;
+        std::vector<std::string> names;  // Names to query in turn, expanded by the search list
+        int                      family;
+        std::shared_ptr<Lookup>  lookup;
+    };
+
+    // Single DNS question of a query, A or AAAA
+    struct Question
+    {
+        std::uint16_t type;
+        std::uint16_t id = 0;
+        bool          answered = false;
+        Answer        answer;
+    };
+
+    // In-flight DNS query, owned by the resolver thread
+    struct Query
+    {
+        Submission                submission;     // Resolution this query answers
+        std::vector<Question>     questions;      // Questions to ask. AF_UNSPEC asks A and AAAA.
+        Socket                    sock;           // Socket connected to the current nameserver
+        TimerWheel::Node          timer;          // Deadline of the current attempt
+        std::size_t               candidate = 0;  // Index of the queried name
+        std::size_t               attempt = 0;    // Number of the current attempt
+        bool                      tcp = false;    // Truncated response, the attempt uses TCP
+        std::vector<std::uint8_t> outgoing;       // TCP: length prefixed queries not sent yet
+        std::vector<std::uint8_t> incoming;       // TCP: received bytes of incomplete responses
+    };
+
+    using Cache = std::unordered_map<std::string, CacheEntry>;
+    using InflightMap = std::unordered_map<std::string, std::shared_ptr<Lookup>>;
+    using QueryMap = std::unordered_map<std::uint64_t, std::unique_ptr<Query>>;
+
+    static Request make_request(std::shared_ptr<Lookup> lookup);
+
+    void run();
+
+    void wakeup();
+
+    void process_submissions();
+
+    void send_attempt(std::uint64_t id, Query& query);
+
+    void process_response(std::uint64_t id);
+
+    void process_stream(std::uint64_t id, Query& query);
+
+    bool process_message(std::uint64_t id, Query& query, std::uint8_t const* data, std::size_t len);
+
+    bool complete_answered(std::uint64_t id, Query& query);
+
+    void process_timeout(std::uint64_t id);
+
+    void retry(std::uint64_t id, Query& query);
+
+    void finish(std::uint64_t id, Query& query);
+
+    Options                      options_;     // Configuration
+    HostTable                    hosts_;       // Static host table
+    mutable std::mutex           mtx_;         // Lock for synchronizing access to the members below
+    Cache                        cache_;       // Results by key
+    std::size_t                  sweep_size_;  // Cache size that triggers evicting expired results
+    InflightMap                  inflight_;    // Unfinished lookups by key, for coalescing
+    std::vector<Submission>      submitted_;   // Lookups to be started by the resolver thread
+    bool                         shutdown_;    // Thread life-time management Flag
+    Socket                       epoll_;       // epoll instance of the resolver thread
+    Socket                       wakeup_;      // eventfd signaling new submissions
+    QueryMap                     queries_;     // In-flight queries by id
+    TimerWheel                   wheel_;       // Query deadlines. Destroyed before the queries it links.
+    std::mt19937                 rng_;         // Source of DNS message ids
+    std::uint64_t                next_id_;     // Id of the next query
+    std::thread                  thread_;      // Resolver thread
+};
+
+Resolver::Impl::Impl(Options options)
+    : options_(std::move(options))
+    , hosts_(load_hosts(options_.hosts_file))
+    , mtx_()
+    , cache_()
+    , sweep_size_(64)
+    , inflight_()
+    , submitted_()
+    , shutdown_(false)
+    , epoll_(::epoll_create1(EPOLL_CLOEXEC))
+    , wakeup_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    , queries_()
+    , wheel_(Clock::now())
+    , rng_(std::random_device()())
+    , next_id_(WAKEUP_ID + 1)
+    , thread_()
+{
+    if (!epoll_.is_valid() || !wakeup_.is_valid())
+    {
+        throw std::runtime_error(std::string(__PRETTY_FUNCTION__) +
+                                 ": failed to create epoll instance");
+    }
+
+    auto ev = epoll_event();
+    ev.events = EPOLLIN;
+    ev.data.u64 = WAKEUP_ID;
+    ::epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, wakeup_.get(), &ev);
+
+    thread_ = std::thread(&Impl::run, this);
+}
+
+Resolver::Impl::~Impl()
+{
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        shutdown_ = true;
+    }
+    wakeup();
+    thread_.join();
+
+    // Release waiters of unfinished lookups
+    for (auto& [key, lookup] : inflight_)
+    {
+        lookup->complete(std::nullopt);
+    }
+
+    for (auto& [id, query] : queries_)
+    {
+        wheel_.cancel(query->timer);
+    }
+}
+
+Resolver::Request Resolver::Impl::make_request(std::shared_ptr<Lookup> lookup)
+{
+    auto request = Request();
+    if (!lookup->is_done())
+    {
+        // Each waiter needs a descriptor of its own, the same epoll instance
+        // can't register a file descriptor twice.
+        request.fd_ = Socket(::fcntl(lookup->get_fd(), F_DUPFD_CLOEXEC, 0));
+    }
+    request.lookup_ = std::move(lookup);
+    return request;
+}
+
+Resolver::Request Resolver::Impl::resolve(std::string_view fqhn, int family)
+{
+    // Addresses and static host names don't need a query
+    auto target = std::string(fqhn);
+    auto numeric = parse_numeric(target, family);
+    if (numeric)
+    {
+        return make_request(std::make_shared<Lookup>(numeric));
+    }
+
+    auto name = normalize(target);
+    auto host = hosts_.find(name);
+    if (host != hosts_.end())
+    {
+        for (auto const& address : host->second)
+        {
+            if (family == AF_UNSPEC || address.family() == family)
+            {
+                return make_request(std::make_shared<Lookup>(address));
+            }
+        }
+    }
+
+    // Names as given and expanded by the search list share results if they query the same names
+    auto absolute = !target.empty() && target.back() == '.';
+    auto names = expand_name(name, absolute, options_.search, options_.ndots);
+    auto key = std::to_string(family);
+    for (auto const& each : names)
+    {
+        key += "/" + each;
+    }
+
+    auto now = Clock::now();
+    auto lookup = std::shared_ptr<Lookup>();
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+
+        auto cached = cache_.find(key);
+        if (cached != cache_.end())
+        {
+            if (now < cached->second.expires)
+            {
+                return make_request(std::make_shared<Lookup>(cached->second.address));
+            }
+            cache_.erase(cached);
+        }
+
+        // Coalesce with a lookup of the same name
+        auto inflight = inflight_.find(key);
+        if (inflight != inflight_.end())
+        {
+            return make_request(inflight->second);
+        }
+
+        lookup = std::make_shared<Lookup>();
+        inflight_.emplace(key, lookup);
+        submitted_.push_back(Submission{key, std::move(names), family, lookup});
+    }
+
+    wakeup();
+    return make_request(lookup);
+}
+
+std::size_t Resolver::Impl::get_cache_size() const
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    return cache_.size();
+}
+
+void Resolver::Impl::clear_cache()
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    cache_.clear();
+}
+
+void Resolver::Impl::run()
+{
+    auto events = std::array<epoll_event, 64>();
+
+    while (true)
+    {
+        {
+            auto lock = std::lock_guard<std::mutex>(mtx_);
+            if (shutdown_)
+            {
+                break;
+            }
+        }
+
+        auto timeout = wheel_.next_timeout(Clock::now());
+        auto n = ::epoll_wait( epoll_.get(), events.data()
+                             , static_cast<int>(events.size()), timeout);
+
+        for (auto i = 0; i < n; ++i)
+        {
+            auto id = events[static_cast<std::size_t>(i)].data.u64;
+            if (id == WAKEUP_ID)
+            {
+                process_submissions();
+            }
+            else
+            {
+                process_response(id);
+            }
+        }
+
+        wheel_.advance(Clock::now(), [this] (TimerWheel::Node& node)
+        {
+            process_timeout(node.id);
+        });
+    }
+}
+
+void Resolver::Impl::wakeup()
+{
+    auto val = std::uint64_t(1);
+    auto ret = ::write(wakeup_.get(), &val, sizeof(val));
+    static_cast<void>(ret);
+}
+
+void Resolver::Impl::process_submissions()
+{
+    auto val = std::uint64_t();
+    auto ret = ::read(wakeup_.get(), &val, sizeof(val));
+    static_cast<void>(ret);
+
+    auto submissions = std::vector<Submission>();
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        submissions.swap(submitted_);
+    }
+
+    for (auto& submission : submissions)
+    {
+        auto id = next_id_++;
+        auto& query = *queries_.emplace(id, std::make_unique<Query>()).first->second;
+        query.timer.id = id;
+
+        // Prefer IPv4 on AF_UNSPEC, IPv6 is asked for in parallel as fallback
+        if (submission.family != AF_INET6)
+        {
+            query.questions.push_back(Question{TYPE_A, 0, false, Answer()});
+        }
+        if (submission.family != AF_INET)
+        {
+            query.questions.push_back(Question{TYPE_AAAA, 0, false, Answer()});
+        }
+        query.submission = std::move(submission);
+
+        send_attempt(id, query);
+    }
+}
+
+void Resolver::Impl::send_attempt(std::uint64_t id, Query& query)
+{
+    if (options_.nameservers.empty())
+    {
+        finish(id, query);
+        return;
+    }
+
+    // Rotate through the nameservers. A fresh socket gets a fresh source port.
+    auto const& server = options_.nameservers[query.attempt % options_.nameservers.size()];
+    auto type = query.tcp ? SOCK_STREAM : SOCK_DGRAM;
+    query.sock = Socket(::socket(server.family(), type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    query.outgoing.clear();
+    query.incoming.clear();
+    if (!query.sock.is_valid() ||
+        (::connect(query.sock.get(), server.get(), server.length) != 0 && !(query.tcp && errno == EINPROGRESS)))
+    {
+        retry(id, query);
+        return;
+    }
+
+    // Queries over TCP are sent once connected
+    auto ev = epoll_event();
+    ev.events = query.tcp ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    ev.data.u64 = id;
+    ::epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, query.sock.get(), &ev);
+
+    auto ids = std::uniform_int_distribution<std::uint16_t>();
+    for (auto& question : query.questions)
+    {
+        if (question.answered)
+        {
+            continue;
+        }
+
+        question.id = ids(rng_);
+        auto message = build_query(question.id, query.submission.names[query.candidate], question.type);
+        if (!message)
+        {
+            // Not a valid domain name, no server will resolve it
+            question.answered = true;
+            question.answer.rcode = RCODE_NXDOMAIN;
+            continue;
+        }
+
+        if (query.tcp)
+        {
+            // RFC 1035 4.2.2: Messages over TCP are prefixed by their length
+            put_u16(query.outgoing, static_cast<std::uint16_t>(message->size()));
+            query.outgoing.insert(query.outgoing.end(), message->begin(), message->end());
+            continue;
+        }
+        ::send(query.sock.get(), message->data(), message->size(), 0);
+    }
+
+    if (std::all_of(query.questions.begin(), query.questions.end(), [] (Question const& q)
+    {
+        return q.answered;
+    }))
+    {
+        finish(id, query);
+        return;
+    }
+
+    wheel_.schedule(query.timer, Clock::now() + options_.timeout);
+}
+
+void Resolver::Impl::process_response(std::uint64_t id)
+{
+    auto it = queries_.find(id);
+    if (it == queries_.end())
+    {
+        return;
+    }
+
+    auto& query = *it->second;
+    if (query.tcp)
+    {
+        process_stream(id, query);
+        return;
+    }
+
+    auto buffer = std::array<std::uint8_t, MAX_MESSAGE>();
+    while (true)
+    {
+        auto len = ::recv(query.sock.get(), buffer.data(), buffer.size(), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+
+            // Nameserver unreachable, don't wait for the timeout
+            retry(id, query);
+            return;
+        }
+
+        if (!process_message(id, query, buffer.data(), static_cast<std::size_t>(len)))
+        {
+            return;
+        }
+    }
+    complete_answered(id, query);
+}
+
+void Resolver::Impl::process_stream(std::uint64_t id, Query& query)
+{
+    // Send what fits into the socket, afterwards wait for responses only
+    while (!query.outgoing.empty())
+    {
+        auto len = ::send(query.sock.get(), query.outgoing.data(), query.outgoing.size(), MSG_NOSIGNAL);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+
+            // Connection refused or reset
+            retry(id, query);
+            return;
+        }
+
+        query.outgoing.erase(query.outgoing.begin(), query.outgoing.begin() + len);
+        if (query.outgoing.empty())
+        {
+            auto ev = epoll_event();
+            ev.events = EPOLLIN;
+            ev.data.u64 = id;
+            ::epoll_ctl(epoll_.get(), EPOLL_CTL_MOD, query.sock.get(), &ev);
+        }
+    }
+
+    auto closed = false;
+    auto buffer = std::array<std::uint8_t, MAX_MESSAGE>();
+    while (true)
+    {
+        auto len = ::recv(query.sock.get(), buffer.data(), buffer.size(), 0);
+        if (len < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+
+        if (len <= 0)
+        {
+            closed = true;
+            break;
+        }
+        query.incoming.insert(query.incoming.end(), buffer.data(), buffer.data() + len);
+    }
+
+    // Process complete responses, keep the rest for the next read
+    auto offset = std::size_t(0);
+    while (query.incoming.size() - offset >= 2)
+    {
+        auto size = std::size_t(get_u16(query.incoming.data() + offset));
+        if (query.incoming.size() - offset - 2 < size)
+        {
+            break;
+        }
+
+        if (!process_message(id, query, query.incoming.data() + offset + 2, size))
+        {
+            return;
+        }
+        offset += 2 + size;
+    }
+    query.incoming.erase(query.incoming.begin(), query.incoming.begin() + static_cast<std::ptrdiff_t>(offset));
+
+    // Server closed the connection before answering everything
+    if (!complete_answered(id, query) && closed)
+    {
+        retry(id, query);
+    }
+}
+
+bool Resolver::Impl::process_message( std::uint64_t id, Query& query
+                                    , std::uint8_t const* data, std::size_t len)
+{
+    for (auto& question : query.questions)
+    {
+        auto answer = parse_response(data, len, question.type);
+        if (question.answered || !answer || answer->id != question.id)
+        {
+            continue;
+        }
+
+        // Response didn't fit into a datagram, ask the same server over TCP
+        if (answer->truncated && !query.tcp)
+        {
+            wheel_.cancel(query.timer);
+            query.tcp = true;
+            send_attempt(id, query);
+            return false;
+        }
+
+        // Server failures and refusals are worth asking the next server
+        if (answer->rcode != RCODE_OK && answer->rcode != RCODE_NXDOMAIN)
+        {
+            retry(id, query);
+            return false;
+        }
+
+        question.answered = true;
+        question.answer = std::move(*answer);
+    }
+    return true;
+}
+
+bool Resolver::Impl::complete_answered(std::uint64_t id, Query& query)
+{
+    // Done if the preferred family has an address or all questions are answered
+    auto const& first = query.questions.front();
+    auto all = std::all_of(query.questions.begin(), query.questions.end(), [] (Question const& q)
+    {
+        return q.answered;
+    });
+
+    if (all || (first.answered && !first.answer.addresses.empty()))
+    {
+        finish(id, query);
+        return true;
+    }
+    return false;
+}
+
+void Resolver::Impl::process_timeout(std::uint64_t id)
+{
+    auto it = queries_.find(id);
+    if (it != queries_.end())
+    {
+        retry(id, *it->second);
+    }
+}
+
+void Resolver::Impl::retry(std::uint64_t id, Query& query)
+{
+    wheel_.cancel(query.timer);
+    query.sock = Socket();
+    query.tcp = false;
+    query.attempt += 1;
+
+    if (query.attempt < options_.attempts)
+    {
+        send_attempt(id, query);
+        return;
+    }
+    finish(id, query);
+}
+
+void Resolver::Impl::finish(std::uint64_t id, Query& query)
+{
+    using namespace std::chrono;
+
+    auto clamp = [this] (seconds ttl)
+    {
+        return std::clamp(ttl, options_.min_ttl, options_.max_ttl);
+    };
+
+    // Without address, the next name of the search list is queried from scratch
+    auto found = std::any_of(query.questions.begin(), query.questions.end(), [] (Question const& q)
+    {
+        return q.answered && !q.answer.addresses.empty();
+    });
+
+    if (!found && query.candidate + 1 < query.submission.names.size())
+    {
+        wheel_.cancel(query.timer);
+        query.candidate += 1;
+        query.attempt = 0;
+        query.tcp = false;
+        for (auto& question : query.questions)
+        {
+            question.answered = false;
+            question.answer = Answer();
+        }
+        send_attempt(id, query);
+        return;
+    }
+
+    // Positive: first address in order of preference. Negative: all questions
+    // were answered without address. Failure: no answer at all.
+    auto result = std::optional<Address>();
+    auto ttl = options_.failure_ttl;
+    auto answered = std::all_of(query.questions.begin(), query.questions.end(), [] (Question const& q)
+    {
+        return q.answered;
+    });
+
+    for (auto const& question : query.questions)
+    {
+        if (question.answered && !question.answer.addresses.empty())
+        {
+            result = question.answer.addresses.front();
+            ttl = clamp(seconds(question.answer.ttl.value_or(0)));
+            break;
+        }
+    }
+
+    if (!result && answered)
+    {
+        ttl = seconds::max();
+        for (auto const& question : query.questions)
+        {
+            auto negative = question.answer.negative_ttl
+                          ? seconds(*question.answer.negative_ttl)
+                          : options_.negative_ttl;
+            ttl = std::min(ttl, clamp(negative));
+        }
+    }
+
+    auto now = Clock::now();
+    auto lookup = query.submission.lookup;
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+
+        // Evict expired results once the cache doubled in size
+        if (cache_.size() >= sweep_size_)
+        {
+            for (auto it = cache_.begin(); it != cache_.end();)
+            {
+                it = (it->second.expires <= now) ? cache_.erase(it) : std::next(it);
+            }
+            sweep_size_ = std::max<std::size_t>(64, cache_.size() * 2);
+        }
+
+        cache_[query.submission.key] = CacheEntry{result, now + ttl};
+        inflight_.erase(query.submission.key);
+    }
+    lookup->complete(result);
+
+    wheel_.cancel(query.timer);
+    queries_.erase(id);
+}
+
+// Resolver related implementation
+Resolver::Resolver(Options options)
+    : pimpl_(std::make_unique<Impl>(std::move(options)))
+{
+}
+
+Resolver::~Resolver() = default;
+
+Resolver& Resolver::get_default()
+{
+    // Intentionally leaked, monitors might resolve during static destruction
+    static auto* resolver = new Resolver(Options::from_system());
+    return *resolver;
+}
+
+Resolver::Request Resolver::resolve(std::string_view fqhn, int family)
+{
+    return pimpl_->resolve(fqhn, family);
+}
+
+std::optional<Address> Resolver::resolve( std::string_view fqhn, int family
+                                        , Clock::time_point deadline)
+{
+    auto request = resolve(fqhn, family);
+    if (!request.is_done())
+    {
+        wait_for(request.get_fd(), POLLIN, deadline);
+    }
+    return request.get_result();
+}
+
+std::size_t Resolver::get_cache_size() const
+{
+    return pimpl_->get_cache_size();
+}
+
+void Resolver::clear_cache()
+{
+    pimpl_->clear_cache();
+}
+
+} // namespace host_monitor
@@ -0,0 +1,155 @@
+/**
+ * @file      Resolver.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef RESOLVER_HPP_202610161510
+#define RESOLVER_HPP_202610161510
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <chrono>
+#include <cstddef>
+
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Caching, non-blocking host name resolver.
+ * @note  IP-Addresses and names from /etc/hosts resolve immediately. Other
+ *        names are queried by a built-in DNS client on a resolver thread,
+ *        over UDP and over TCP if a response was truncated. Relative names
+ *        are expanded by the search list like the system resolver does.
+ *        Results, including failures, are cached according to their TTL.
+ *        Concurrent lookups of the same name share a single query.
+ *        Other name services configured in nsswitch.conf are not consulted.
+ */
+class Resolver
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Resolver configuration.
+    struct Options
+    {
+        std::vector<Address>      nameservers;  ///< Servers to query, tried in turn.
+        std::vector<std::string>  search;       ///< Domains appended to relative names, tried in turn.
+        std::size_t               ndots;        ///< Names with fewer dots are tried with the search domains first.
+        std::string               hosts_file;   ///< Static host table. Empty to disable.
+        std::chrono::milliseconds timeout;      ///< Time to wait for a response per attempt.
+        std::size_t               attempts;     ///< Number of attempts per query.
+        std::chrono::seconds      min_ttl;      ///< Lower bound of cached TTLs.
+        std::chrono::seconds      max_ttl;      ///< Upper bound of cached TTLs.
+        std::chrono::seconds      negative_ttl; ///< TTL of non-existent names without SOA record.
+        std::chrono::seconds      failure_ttl;  ///< TTL of failed queries (timeouts, server failures).
+
+        /**
+         * @brief Get system configuration.
+         * @returns Options with nameservers, search list and ndots read from
+         *          /etc/resolv.conf and /etc/hosts as static host table.
+         */
+        static Options from_system();
+    };
+
+    class Lookup;
+
+    /// @brief Pending or completed resolution of a single host name.
+    class Request
+    {
+    public:
+        Request();
+
+        /**
+         * @brief Check if the resolution completed.
+         * @returns true if get_result() is final.
+         */
+        bool is_done() const;
+
+        /**
+         * @brief Get resolution result.
+         * @returns resolved address. std::nullopt if the name can't be
+         *          resolved or the resolution is still pending.
+         */
+        std::optional<Address> get_result() const;
+
+        /**
+         * @brief Get file descriptor signaling completion.
+         * @returns file descriptor getting readable once is_done() is true.
+         *          -1 if the request completed on creation.
+         */
+        int get_fd() const;
+
+    private:
+        friend class Resolver;
+        std::shared_ptr<Lookup> lookup_; // Shared state of the resolution
+        Socket                  fd_;     // Own descriptor of the lookups eventfd
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] options   Resolver configuration.
+     */
+    explicit Resolver(Options options);
+
+    ~Resolver();
+
+    /**
+     * @brief Get process wide resolver, configured with Options::from_system().
+     * @returns the default resolver.
+     */
+    static Resolver& get_default();
+
+    /**
+     * @brief Start resolving a host name. Never blocks.
+     * @param[in] fqhn     FQDN or IP-Address that should be resolved.
+     * @param[in] family   Requested address family: AF_INET, AF_INET6 or AF_UNSPEC.
+     *                     AF_UNSPEC prefers IPv4 addresses.
+     * @returns request, completed already if the result was cached.
+     */
+    Request resolve(std::string_view fqhn, int family);
+
+    /**
+     * @brief Resolve a host name, blocking until it is resolved or @p deadline expired.
+     * @param[in] fqhn       FQDN or IP-Address that should be resolved.
+     * @param[in] family     Requested address family: AF_INET, AF_INET6 or AF_UNSPEC.
+     * @param[in] deadline   Point in time after that waiting is aborted.
+     * @returns resolved address. In case @p fqhn can't be resolved in time, the optional is none.
+     */
+    std::optional<Address> resolve(std::string_view fqhn, int family, Clock::time_point deadline);
+
+    /**
+     * @brief Get number of cached results.
+     * @returns number of cached results, including expired ones not evicted yet.
+     */
+    std::size_t get_cache_size() const;
+
+    /// @brief Drop all cached results.
+    void clear_cache();
+
+    /* Disable copying and moving */
+    Resolver(Resolver const& other) = delete;
+    Resolver(Resolver&& other) = delete;
+    Resolver& operator = (Resolver const& other) = delete;
+    Resolver&& operator = (Resolver&& other) = delete;
+
+    class Impl;
+
+private:
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace host_monitor
+
+#endif // RESOLVER_HPP_202610161510
@@ -0,0 +1,78 @@
+/**
+ * @file      ResolvingProbe.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <poll.h>
+
+#include "ResolvingProbe.hpp"
+
+namespace host_monitor
+{
+
+ResolvingProbe::ResolvingProbe(Resolver& resolver, std::string_view fqhn, int family, Factory factory)
+    : resolver_(resolver)
+    , fqhn_(fqhn)
+    , family_(family)
+    , factory_(std::move(factory))
+    , request_()
+    , probe_()
+{
+}
+
+Probe::Status ResolvingProbe::start()
+{
+    request_ = resolver_.resolve(fqhn_, family_);
+    if (request_.is_done())
+    {
+        return start_probe();
+    }
+    return Status::PENDING;
+}
+
+int ResolvingProbe::get_fd() const
+{
+    return probe_ ? probe_->get_fd() : request_.get_fd();
+}
+
+std::uint32_t ResolvingProbe::get_events() const
+{
+    return probe_ ? probe_->get_events() : POLLIN;
+}
+
+Probe::Status ResolvingProbe::on_event(std::uint32_t events)
+{
+    if (probe_)
+    {
+        return probe_->on_event(events);
+    }
+
+    if (request_.is_done())
+    {
+        return start_probe();
+    }
+    return Status::PENDING;
+}
+
+Probe::Status ResolvingProbe::start_probe()
+{
+    // The request stays alive: its descriptor number must not be reused
+    // by the actual probe while it might still be registered for polling.
+    auto address = request_.get_result();
+    if (!address)
+    {
+        return Status::DOWN;
+    }
+
+    probe_ = factory_(*address);
+    return probe_->start();
+}
+
+} // namespace host_monitor
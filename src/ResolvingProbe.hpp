@@ -0,0 +1,69 @@
+/**
+ * @file      ResolvingProbe.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef RESOLVINGPROBE_HPP_202610161540
+#define RESOLVINGPROBE_HPP_202610161540
+
+#include <string_view>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+#include "Probe.hpp"
+#include "Resolver.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Probe resolving its target before handing over to the actual probe.
+ * @note  Cached names resolve within start(). Otherwise the probe waits on
+ *        the resolvers completion descriptor, without blocking.
+ */
+class ResolvingProbe : public Probe
+{
+public:
+    /// @brief Creates the actual probe from the resolved address.
+    using Factory = std::function<std::unique_ptr<Probe>(Address const&)>;
+
+    /**
+     * @brief Constructor.
+     * @param[in] resolver   Resolver to resolve @p fqhn with.
+     * @param[in] fqhn       FQDN or IP-Address of the target, e.g. Endpoint::get_fqhn().
+     *                       Must outlive the probe: the Endpoint it was taken from must stay alive.
+     * @param[in] family     Requested address family: AF_INET, AF_INET6 or AF_UNSPEC.
+     * @param[in] factory    Creates the actual probe.
+     */
+    ResolvingProbe(Resolver& resolver, std::string_view fqhn, int family, Factory factory);
+
+    Status start() override;
+
+    int get_fd() const override;
+
+    std::uint32_t get_events() const override;
+
+    Status on_event(std::uint32_t events) override;
+
+private:
+    Status start_probe();
+
+    Resolver&              resolver_; // Resolver to resolve fqhn_ with
+    std::string_view       fqhn_;     // Target host name, owned by the caller
+    int                    family_;   // Requested address family
+    Factory                factory_;  // Creates the actual probe
+    Resolver::Request      request_;  // Pending resolution
+    std::unique_ptr<Probe> probe_;    // Actual probe, once resolved
+};
+
+} // namespace host_monitor
+
+#endif // RESOLVINGPROBE_HPP_202610161540
@@ -0,0 +1,120 @@
+/**
+ * @file      SeqLock.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef SEQLOCK_HPP_202610161700
+#define SEQLOCK_HPP_202610161700
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace host_monitor
+{
+
+/**
+ * @brief Sequence lock publishing a value from a single writer to many readers.
+ * @note  Readers never write shared memory and never block the writer. A read
+ *        overlapping a write is retried, values are never torn. The value is
+ *        kept in relaxed atomic words, so concurrent access is race-free.
+ *        Concurrent store() calls must be serialized by the caller.
+ */
+template <typename T>
+class alignas(64) SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+    static_assert(std::is_default_constructible_v<T>, "SeqLock requires a default constructible type");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] value   Initial value.
+     */
+    explicit SeqLock(T const& value = T())
+        : seq_(0)
+    {
+        store(value);
+    }
+
+    /**
+     * @brief Publish a new value. Wait-free.
+     * @param[in] value   The value to publish.
+     */
+    void store(T const& value)
+    {
+        auto words = Words();
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        // Odd sequence numbers mark a write in progress
+        auto seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (auto i = std::size_t(0); i < WORDS; ++i)
+        {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Read the latest published value. Lock-free.
+     * @returns consistent copy of the value.
+     */
+    T load() const
+    {
+        auto words = Words();
+        while (true)
+        {
+            auto before = seq_.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                continue;
+            }
+
+            for (auto i = std::size_t(0); i < WORDS; ++i)
+            {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before)
+            {
+                break;
+            }
+        }
+
+        auto value = T();
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+    /* Disable copying and moving */
+    SeqLock(SeqLock const& other) = delete;
+    SeqLock(SeqLock&& other) = delete;
+    SeqLock& operator = (SeqLock const& other) = delete;
+    SeqLock&& operator = (SeqLock&& other) = delete;
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    using Words = std::array<std::uint64_t, WORDS>;
+
+    std::atomic<std::uint64_t>                     seq_;   // Sequence number, odd while writing
+    std::array<std::atomic<std::uint64_t>, WORDS>  words_; // Value, split in atomic words
+};
+
+} // namespace host_monitor
+
+#endif // SEQLOCK_HPP_202610161700
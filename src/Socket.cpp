@@ -0,0 +1,174 @@
+/**
+ * @file      Socket.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <cstring>
+#include <cerrno>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// First address getaddrinfo(3) returns for @p fqhn, @p flags are passed as hints
+std::optional<Address> get_address(std::string const& fqhn, int family, int flags)
+{
+    auto hints = addrinfo();
+    hints.ai_family = family;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = flags;
+
+    auto* res = static_cast<addrinfo*>(nullptr);
+    if (getaddrinfo(fqhn.c_str(), nullptr, &hints, &res) != 0 || res == nullptr)
+    {
+        return {};
+    }
+
+    auto addr = Address();
+    std::memset(&addr.storage, 0, sizeof(addr.storage));
+    std::memcpy(&addr.storage, res->ai_addr, res->ai_addrlen);
+    addr.length = res->ai_addrlen;
+
+    freeaddrinfo(res);
+    return addr;
+}
+} // anon namespace
+
+// Address related implementation
+int Address::family() const
+{
+    return storage.ss_family;
+}
+
+sockaddr const* Address::get() const
+{
+    return reinterpret_cast<sockaddr const*>(&storage);
+}
+
+void Address::set_port(std::uint16_t port)
+{
+    if (family() == AF_INET6)
+    {
+        reinterpret_cast<sockaddr_in6*>(&storage)->sin6_port = htons(port);
+    }
+    else
+    {
+        reinterpret_cast<sockaddr_in*>(&storage)->sin_port = htons(port);
+    }
+}
+
+std::optional<Address> resolve_address(std::string const& fqhn, int family)
+{
+    return get_address(fqhn, family, 0);
+}
+
+std::optional<Address> parse_address(std::string const& ip, int family)
+{
+    // Never blocks on a name lookup
+    return get_address(ip, family, AI_NUMERICHOST);
+}
+
+// Socket related implementation
+Socket::Socket()
+    : fd_(-1)
+{
+}
+
+Socket::Socket(int fd)
+    : fd_(fd)
+{
+}
+
+Socket::~Socket()
+{
+    if (is_valid())
+    {
+        ::close(fd_);
+    }
+}
+
+Socket::Socket(Socket&& other)
+    : fd_(other.fd_)
+{
+    other.fd_ = -1;
+}
+
+Socket& Socket::operator = (Socket&& other)
+{
+    if (this != &other)
+    {
+        if (is_valid())
+        {
+            ::close(fd_);
+        }
+        fd_ = other.fd_;
+        other.fd_ = -1;
+    }
+    return *this;
+}
+
+int Socket::get() const
+{
+    return fd_;
+}
+
+bool Socket::is_valid() const
+{
+    return fd_ >= 0;
+}
+
+short wait_for( int                                   fd
+              , short                                 events
+              , std::chrono::steady_clock::time_point deadline)
+{
+    return wait_for(fd, events, -1, deadline);
+}
+
+short wait_for( int                                   fd
+              , short                                 events
+              , int                                   cancel_fd
+              , std::chrono::steady_clock::time_point deadline)
+{
+    using namespace std::chrono;
+
+    // poll ignores negative file descriptors
+    auto pfds = std::array<pollfd, 2>{pollfd{fd, events, 0}, pollfd{cancel_fd, POLLIN, 0}};
+    while (true)
+    {
+        auto now = steady_clock::now();
+        if (deadline <= now)
+        {
+            return 0;
+        }
+
+        // Round up, poll would otherwise spin on sub-millisecond remainders
+        auto remaining = duration_cast<milliseconds>(deadline - now) + milliseconds(1);
+        auto ret = ::poll(pfds.data(), pfds.size(), static_cast<int>(remaining.count()));
+        if (ret > 0)
+        {
+            return pfds[1].revents ? 0 : pfds[0].revents;
+        }
+
+        if (ret < 0 && errno != EINTR)
+        {
+            return POLLERR;
+        }
+    }
+}
+
+} // namespace host_monitor
@@ -0,0 +1,130 @@
+/**
+ * @file      Socket.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef SOCKET_HPP_202610161012
+#define SOCKET_HPP_202610161012
+
+#include <string>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+#include <sys/socket.h>
+
+namespace host_monitor
+{
+
+/// @brief Resolved network address of an endpoint.
+struct Address
+{
+    sockaddr_storage storage; ///< Storage holding either sockaddr_in or sockaddr_in6.
+    socklen_t        length;  ///< Number of valid bytes in storage.
+
+    /**
+     * @brief Get address family.
+     * @returns AF_INET or AF_INET6.
+     */
+    int family() const;
+
+    /**
+     * @brief Get address as generic socket address.
+     * @returns pointer to the stored address.
+     */
+    sockaddr const* get() const;
+
+    /**
+     * @brief Set the transport layer port of the address.
+     * @param[in] port   Port number in host byte order.
+     */
+    void set_port(std::uint16_t port);
+};
+
+/**
+ * @brief Resolve a host name to a network address.
+ * @param[in] fqhn     FQDN or IP-Address that should be resolved.
+ * @param[in] family   Requested address family: AF_INET, AF_INET6 or AF_UNSPEC.
+ * @returns First resolved address. In case @p fqhn can't be resolved, the optional is none.
+ */
+std::optional<Address> resolve_address(std::string const& fqhn, int family);
+
+/**
+ * @brief Parse a numeric network address, host names are not resolved.
+ * @param[in] ip       IPv4 or IPv6 address in numeric form.
+ * @param[in] family   Requested address family: AF_INET, AF_INET6 or AF_UNSPEC.
+ * @returns The parsed address. In case @p ip isn't a numeric address of @p family, the optional is none.
+ */
+std::optional<Address> parse_address(std::string const& ip, int family);
+
+/// @brief Move-only owner of a socket file descriptor.
+class Socket
+{
+public:
+    Socket();
+
+    /**
+     * @brief Take ownership of an existing file descriptor.
+     * @param[in] fd   The file descriptor to own. -1 marks an invalid socket.
+     */
+    explicit Socket(int fd);
+
+    ~Socket();
+
+    /**
+     * @brief Get owned file descriptor.
+     * @returns the owned file descriptor or -1.
+     */
+    int get() const;
+
+    /**
+     * @brief Check if a file descriptor is owned.
+     * @returns true if the socket is valid.
+     */
+    bool is_valid() const;
+
+    Socket(Socket&& other);
+    Socket& operator = (Socket&& other);
+
+    /* Disable copying */
+    Socket(Socket const& other) = delete;
+    Socket& operator = (Socket const& other) = delete;
+
+private:
+    int fd_;
+};
+
+/**
+ * @brief Wait until @p fd signals @p events or @p deadline expires.
+ * @param[in] fd         The file descriptor to wait on.
+ * @param[in] events     poll(2) events to wait for.
+ * @param[in] deadline   Point in time after that waiting is aborted.
+ * @returns the signaled events or 0 in case the deadline expired.
+ */
+short wait_for( int                                   fd
+              , short                                 events
+              , std::chrono::steady_clock::time_point deadline);
+
+/**
+ * @brief Wait until @p fd signals @p events, @p deadline expires or @p cancel_fd becomes readable.
+ * @param[in] fd          The file descriptor to wait on.
+ * @param[in] events      poll(2) events to wait for.
+ * @param[in] cancel_fd   File descriptor aborting the wait once readable, e.g. an eventfd. -1 to ignore.
+ * @param[in] deadline    Point in time after that waiting is aborted.
+ * @returns the signaled events or 0 in case the deadline expired or the wait was cancelled.
+ */
+short wait_for( int                                   fd
+              , short                                 events
+              , int                                   cancel_fd
+              , std::chrono::steady_clock::time_point deadline);
+
+} // namespace host_monitor
+
+#endif // SOCKET_HPP_202610161012
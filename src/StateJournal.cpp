@@ -0,0 +1,385 @@
+/**
+ * @file      StateJournal.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "StateJournalImpl.hpp"
+
+namespace host_monitor
+{
+
+// Layout of the first record-sized block of the file
+struct StateJournal::Impl::Header
+{
+    std::uint64_t magic;       // MAGIC
+    std::uint64_t record_size; // sizeof(Record)
+    std::uint64_t capacity;    // Number of records, a power of two
+    std::uint64_t used;        // Number of allocated records
+    std::uint64_t reserved[4];
+};
+
+namespace
+{
+constexpr auto MAGIC = std::uint64_t(0x314C4E524A4D4824ull); // "$HMJRNL1"
+constexpr auto MAX_CAPACITY = std::size_t(1) << 28;
+
+// Reads of a record with an unchanged odd sequence number before it counts as torn
+constexpr auto TORN_RETRIES = 64;
+
+static_assert(sizeof(StateJournal::Impl::Record) == 64, "Records must fill a cache line");
+
+std::uint64_t load_word(std::uint64_t const& word, int order = __ATOMIC_RELAXED)
+{
+    return __atomic_load_n(&word, order);
+}
+
+void store_word(std::uint64_t& word, std::uint64_t value, int order = __ATOMIC_RELAXED)
+{
+    __atomic_store_n(&word, value, order);
+}
+
+// FNV-1a. Endpoint::hash() depends on addresses, keys must be stable across processes.
+class KeyHash
+{
+public:
+    void add(std::string_view data)
+    {
+        for (auto c : data)
+        {
+            hash_ = (hash_ ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+        }
+        add_word(data.size());
+    }
+
+    void add_word(std::uint64_t word)
+    {
+        for (auto i = 0; i < 8; ++i)
+        {
+            hash_ = (hash_ ^ ((word >> (8 * i)) & 0xFF)) * 0x100000001B3ull;
+        }
+    }
+
+    std::uint64_t get() const
+    {
+        // 0 marks unused records
+        return (hash_ == 0) ? 1 : hash_;
+    }
+
+private:
+    std::uint64_t hash_ = 0xCBF29CE484222325ull;
+};
+
+std::uint64_t make_key(Endpoint const& endpoint)
+{
+    auto hash = KeyHash();
+    hash.add_word(static_cast<std::uint64_t>(endpoint.get_protocol()));
+    hash.add(endpoint.get_fqhn());
+    hash.add_word(endpoint.get_port().value_or(0));
+    hash.add(endpoint.get_payload());
+    auto expected = endpoint.get_expected_response();
+    hash.add_word(expected ? 1 : 0);
+    hash.add(expected.value_or(std::string_view()));
+    hash.add_word(endpoint.get_expected_status().value_or(0));
+    return hash.get();
+}
+
+std::size_t round_up_pow2(std::size_t n)
+{
+    auto p = std::size_t(1);
+    while (p < n)
+    {
+        p <<= 1;
+    }
+    return p;
+}
+
+std::uint64_t to_ns(std::chrono::system_clock::time_point tp)
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count());
+}
+
+std::chrono::system_clock::time_point from_ns(std::uint64_t ns)
+{
+    auto d = std::chrono::nanoseconds(static_cast<std::int64_t>(ns));
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(d));
+}
+} // anon namespace
+
+StateJournal::Impl::Impl(std::string const& path, std::size_t capacity)
+    : file_(::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644))
+    , mapping_(MAP_FAILED)
+    , size_(0)
+    , header_(nullptr)
+    , records_(nullptr)
+    , mask_(0)
+    , owned_()
+    , mtx_()
+{
+    auto const prefix = std::string(__PRETTY_FUNCTION__) + ": " + path + ": ";
+    auto fail = [&prefix] (char const* reason)
+    {
+        return std::runtime_error(prefix + reason);
+    };
+
+    if (!file_.is_valid())
+    {
+        throw fail("failed to open");
+    }
+
+    // Records have a single writer, two processes must not share a journal
+    if (::flock(file_.get(), LOCK_EX | LOCK_NB) != 0)
+    {
+        throw fail("in use");
+    }
+
+    struct stat st = {};
+    if (::fstat(file_.get(), &st) != 0)
+    {
+        throw fail("failed to stat");
+    }
+
+    auto created = (st.st_size == 0);
+    if (created)
+    {
+        capacity = round_up_pow2(std::max(capacity, std::size_t(1)));
+        if (capacity > MAX_CAPACITY)
+        {
+            throw fail("capacity too large");
+        }
+
+        // Sparse file, blocks are allocated as records are used
+        size_ = sizeof(Record) * (capacity + 1);
+        if (::ftruncate(file_.get(), static_cast<off_t>(size_)) != 0)
+        {
+            throw fail("failed to resize");
+        }
+    }
+    else
+    {
+        size_ = static_cast<std::size_t>(st.st_size);
+    }
+
+    mapping_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_.get(), 0);
+    if (mapping_ == MAP_FAILED)
+    {
+        throw fail("failed to map");
+    }
+
+    header_ = static_cast<Header*>(mapping_);
+    records_ = reinterpret_cast<Record*>(static_cast<char*>(mapping_) + sizeof(Record));
+    if (created)
+    {
+        header_->record_size = sizeof(Record);
+        header_->capacity = capacity;
+        header_->used = 0;
+        store_word(header_->magic, MAGIC, __ATOMIC_RELEASE);
+    }
+
+    // Reject foreign files and journals of a different layout
+    auto valid = size_ >= sizeof(Record) * 2
+              && header_->magic == MAGIC
+              && header_->record_size == sizeof(Record)
+              && header_->capacity != 0 && header_->capacity <= MAX_CAPACITY
+              && (header_->capacity & (header_->capacity - 1)) == 0
+              && size_ == sizeof(Record) * (header_->capacity + 1);
+    if (!valid)
+    {
+        ::munmap(mapping_, size_);
+        mapping_ = MAP_FAILED;
+        throw fail("not a state journal");
+    }
+    mask_ = header_->capacity - 1;
+}
+
+StateJournal::Impl::~Impl()
+{
+    if (mapping_ != MAP_FAILED)
+    {
+        ::munmap(mapping_, size_);
+    }
+}
+
+StateJournal::Impl::Record* StateJournal::Impl::acquire(Endpoint const& endpoint)
+{
+    auto key = make_key(endpoint);
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+
+    // Linear probing. Records are never freed, probing ends at the first unused one.
+    for (auto i = std::uint64_t(0); i <= mask_; ++i)
+    {
+        auto& record = records_[(key + i) & mask_];
+        auto slot = load_word(record.key);
+        if (slot == key)
+        {
+            // Two writers would lose updates and could tear the record
+            return owned_.insert(&record).second ? &record : nullptr;
+        }
+        if (slot == 0)
+        {
+            store_word(record.key, key, __ATOMIC_RELEASE);
+            store_word(header_->used, load_word(header_->used) + 1);
+            owned_.insert(&record);
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+void StateJournal::Impl::release(Record const* record)
+{
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    owned_.erase(record);
+}
+
+StateJournal::Impl::Record* StateJournal::Impl::lookup(std::uint64_t key) const
+{
+    for (auto i = std::uint64_t(0); i <= mask_; ++i)
+    {
+        auto& record = records_[(key + i) & mask_];
+        auto slot = load_word(record.key, __ATOMIC_ACQUIRE);
+        if (slot == key)
+        {
+            return &record;
+        }
+        if (slot == 0)
+        {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<StateJournal::Entry> StateJournal::Impl::find(Endpoint const& endpoint) const
+{
+    auto* record = lookup(make_key(endpoint));
+    if (!record)
+    {
+        return std::nullopt;
+    }
+
+    // Retry reads overlapping a write of the reporter. An odd sequence number
+    // that doesn't change was left behind by a crash during a write.
+    auto stalled = 0;
+    auto last = load_word(record->sequence, __ATOMIC_ACQUIRE);
+    while (true)
+    {
+        auto before = load_word(record->sequence, __ATOMIC_ACQUIRE);
+        auto entry = load(*record);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (before % 2 == 0 && load_word(record->sequence) == before)
+        {
+            return entry;
+        }
+
+        stalled = (before == last) ? stalled + 1 : 0;
+        last = before;
+        if (before % 2 != 0 && stalled >= TORN_RETRIES)
+        {
+            return std::nullopt;
+        }
+        std::this_thread::yield();
+    }
+}
+
+std::size_t StateJournal::Impl::get_capacity() const
+{
+    return static_cast<std::size_t>(mask_ + 1);
+}
+
+std::size_t StateJournal::Impl::get_size() const
+{
+    return static_cast<std::size_t>(load_word(header_->used));
+}
+
+void StateJournal::Impl::flush()
+{
+    ::msync(mapping_, size_, MS_SYNC);
+}
+
+std::optional<StateJournal::Entry> StateJournal::Impl::load(Record const& record)
+{
+    // An odd sequence number is left behind by a crash during a write
+    auto sequence = load_word(record.sequence);
+    auto probes = load_word(record.probes);
+    if (sequence % 2 != 0 || probes == 0)
+    {
+        return std::nullopt;
+    }
+
+    auto state = load_word(record.state);
+    auto entry = Entry();
+    entry.available = (state & 1) != 0;
+    entry.consecutive_failures = static_cast<std::uint32_t>(state >> 32);
+    entry.last_probe = from_ns(load_word(record.last_probe));
+    entry.last_change = from_ns(load_word(record.last_change));
+    entry.probes = probes;
+    entry.failures = load_word(record.failures);
+    entry.changes = load_word(record.changes);
+    return entry;
+}
+
+void StateJournal::Impl::store(Record& record, Entry const& entry, bool probe_failed, bool changed)
+{
+    // Odd sequence numbers mark a write in progress. A crash might have left one behind.
+    auto sequence = (load_word(record.sequence) + 1) | 1;
+    store_word(record.sequence, sequence);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    auto state = (std::uint64_t(entry.consecutive_failures) << 32) | (entry.available ? 1u : 0u);
+    store_word(record.state, state);
+    store_word(record.last_probe, to_ns(entry.last_probe));
+    store_word(record.last_change, to_ns(entry.last_change));
+    store_word(record.probes, load_word(record.probes) + 1);
+    store_word(record.failures, load_word(record.failures) + (probe_failed ? 1 : 0));
+    store_word(record.changes, load_word(record.changes) + (changed ? 1 : 0));
+
+    store_word(record.sequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+// Interface Implementation
+StateJournal::StateJournal(std::string const& path, std::size_t capacity)
+    : pimpl_(std::make_unique<Impl>(path, capacity))
+{
+}
+
+StateJournal::~StateJournal() = default;
+
+std::optional<StateJournal::Entry> StateJournal::find(Endpoint const& endpoint) const
+{
+    return pimpl_->find(endpoint);
+}
+
+std::size_t StateJournal::get_capacity() const
+{
+    return pimpl_->get_capacity();
+}
+
+std::size_t StateJournal::get_size() const
+{
+    return pimpl_->get_size();
+}
+
+void StateJournal::flush()
+{
+    pimpl_->flush();
+}
+
+} // namespace host_monitor
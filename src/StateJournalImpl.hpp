@@ -0,0 +1,117 @@
+/**
+ * @file      StateJournalImpl.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef STATEJOURNALIMPL_HPP_202610171410
+#define STATEJOURNALIMPL_HPP_202610171410
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <cstddef>
+#include <cstdint>
+
+#include "StateJournal.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+class StateJournal::Impl
+{
+public:
+    /**
+     * @brief Record of a single endpoint, one cache line.
+     * @note  All fields are accessed atomically. The reporter of the monitor owning
+     *        the record is the only writer, readers retry on a changed sequence number.
+     */
+    struct alignas(64) Record
+    {
+        std::uint64_t key;         // Stable hash of the endpoint, 0 if unused
+        std::uint64_t sequence;    // Odd while the record is written
+        std::uint64_t state;       // Availability in bit 0, consecutive failures in the upper half
+        std::uint64_t last_probe;  // Nanoseconds since the epoch of the system clock
+        std::uint64_t last_change; // Nanoseconds since the epoch of the system clock
+        std::uint64_t probes;      // Tests performed
+        std::uint64_t failures;    // Failed tests
+        std::uint64_t changes;     // Changes of availability
+    };
+
+    Impl(std::string const& path, std::size_t capacity);
+
+    ~Impl();
+
+    /**
+     * @brief Take ownership of the record of an endpoint, allocate one if there is none.
+     * @note  Thread-safe. Called on registration of a monitor, never on the hot path.
+     *        A record has a single owner: further monitors of the endpoint don't get it.
+     * @param[in] endpoint   The endpoint to get the record of.
+     * @returns record of @p endpoint. nullptr if the journal is full or the record is owned.
+     */
+    Record* acquire(Endpoint const& endpoint);
+
+    /**
+     * @brief Give up ownership of a record. Records of other journals are ignored.
+     * @note  Thread-safe. The owner must not write the record anymore.
+     * @param[in] record   Record returned by acquire().
+     */
+    void release(Record const* record);
+
+    std::optional<Entry> find(Endpoint const& endpoint) const;
+
+    std::size_t get_capacity() const;
+
+    std::size_t get_size() const;
+
+    void flush();
+
+    /**
+     * @brief Read a record.
+     * @param[in] record   The record to read.
+     * @returns content of @p record. None if it holds no test yet or was torn.
+     */
+    static std::optional<Entry> load(Record const& record);
+
+    /**
+     * @brief Record the result of a connection test. Wait-free, no system call.
+     * @note  Must only be called by the reporter of the records endpoint.
+     * @param[out] record        The record to update.
+     * @param[in]  entry         Availability, failures and times after the test.
+     * @param[in]  probe_failed  true if the test failed.
+     * @param[in]  changed       true if the availability changed.
+     */
+    static void store(Record& record, Entry const& entry, bool probe_failed, bool changed);
+
+    /* Disable copying and moving */
+    Impl(Impl const& other) = delete;
+    Impl(Impl&& other) = delete;
+    Impl& operator = (Impl const& other) = delete;
+    Impl&& operator = (Impl&& other) = delete;
+
+private:
+    struct Header;
+
+    Record* lookup(std::uint64_t key) const;
+
+    Socket                             file_;    // Journal file, locked while open
+    void*                              mapping_; // Mapped journal file
+    std::size_t                        size_;    // Size of the mapping
+    Header*                            header_;  // Header at the start of the mapping
+    Record*                            records_; // Records following the header
+    std::uint64_t                      mask_;    // Capacity - 1, capacity is a power of two
+    std::unordered_set<Record const*>  owned_;   // Records owned by a monitor
+    std::mutex                         mtx_;     // Lock for synchronizing record allocation and owned_
+};
+
+} // namespace host_monitor
+
+#endif // STATEJOURNALIMPL_HPP_202610171410
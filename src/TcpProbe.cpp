@@ -0,0 +1,82 @@
+/**
+ * @file      TcpProbe.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <cerrno>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "TcpProbe.hpp"
+
+namespace host_monitor
+{
+
+Socket tcp_connect_start(Address const& address)
+{
+    auto flags = SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC;
+    auto sock = Socket(::socket(address.family(), flags, 0));
+    if (!sock.is_valid())
+    {
+        return sock;
+    }
+
+    // Abort the connection on close. Probes must not leave TIME_WAIT entries behind.
+    auto lin = linger{1, 0};
+    setsockopt(sock.get(), SOL_SOCKET, SO_LINGER, &lin, sizeof(lin));
+
+    if (::connect(sock.get(), address.get(), address.length) < 0 && errno != EINPROGRESS)
+    {
+        return Socket();
+    }
+    return sock;
+}
+
+bool tcp_connect_finish(Socket const& sock)
+{
+    auto err = 0;
+    auto len = socklen_t(sizeof(err));
+    if (getsockopt(sock.get(), SOL_SOCKET, SO_ERROR, &err, &len) < 0)
+    {
+        return false;
+    }
+    return err == 0;
+}
+
+TcpProbe::TcpProbe(Address address)
+    : address_(std::move(address))
+    , sock_()
+{
+}
+
+Probe::Status TcpProbe::start()
+{
+    sock_ = tcp_connect_start(address_);
+    return sock_.is_valid() ? Status::PENDING : Status::DOWN;
+}
+
+int TcpProbe::get_fd() const
+{
+    return sock_.get();
+}
+
+std::uint32_t TcpProbe::get_events() const
+{
+    return POLLOUT;
+}
+
+Probe::Status TcpProbe::on_event(std::uint32_t)
+{
+    // Writable signals completion, successful or not
+    return tcp_connect_finish(sock_) ? Status::UP : Status::DOWN;
+}
+
+} // namespace host_monitor
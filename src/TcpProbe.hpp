@@ -0,0 +1,67 @@
+/**
+ * @file      TcpProbe.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef TCPPROBE_HPP_202610161105
+#define TCPPROBE_HPP_202610161105
+
+#include <cstdint>
+
+#include "Probe.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Start a non-blocking TCP connection attempt.
+ * @param[in] address   Resolved address of the target, including the port.
+ * @returns The connecting socket. Invalid in case the connection attempt
+ *          failed immediately (e.g. ECONNREFUSED).
+ */
+Socket tcp_connect_start(Address const& address);
+
+/**
+ * @brief Check the outcome of a connection attempt after it became writable.
+ * @param[in] sock   Socket returned by tcp_connect_start.
+ * @returns true in case the connection was established. false if not.
+ */
+bool tcp_connect_finish(Socket const& sock);
+
+/**
+ * @brief Probe testing if a TCP connection can be established.
+ * @note  Refused connections (RST) are reported immediately.
+ */
+class TcpProbe : public Probe
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] address   Resolved address of the target, including the port.
+     */
+    explicit TcpProbe(Address address);
+
+    Status start() override;
+
+    int get_fd() const override;
+
+    std::uint32_t get_events() const override;
+
+    Status on_event(std::uint32_t events) override;
+
+private:
+    Address address_; // Target address
+    Socket  sock_;    // Connecting socket
+};
+
+} // namespace host_monitor
+
+#endif // TCPPROBE_HPP_202610161105
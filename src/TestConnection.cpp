@@ -10,68 +10,164 @@
  * directory for more details.
  */
 
-#include <cstdlib>
+#include <string>
+
+#include <netinet/in.h>
 
 #include "TestConnection.hpp"
+#include "HttpProbe.hpp"
+#include "IcmpProbe.hpp"
+#include "IcmpTransport.hpp"
+#include "PersistentTcpProbe.hpp"
+#include "ResolvingProbe.hpp"
+#include "TcpProbe.hpp"
+#include "UdpProbe.hpp"
 
 namespace host_monitor
 {
 namespace
 {
-// network layer connection test is based on ping.
-bool test_connection_icmp(std::string const& fqhn, bool useIPv6)
+// resolves the endpoint before creating the actual probe, unless it holds an address.
+std::unique_ptr<Probe> make_resolving_probe( Resolver& resolver, Endpoint const& endpoint
+                                           , int family, ResolvingProbe::Factory factory)
 {
-    // Create command
-    auto ping_cmd = std::string();
-
-    ping_cmd += "ping -c 1 ";        // Send single ICMP packet
-
-    if (useIPv6)
+    auto const* storage = endpoint.get_address();
+    if (storage)
     {
-        ping_cmd += "-6 ";
+        auto address = Address();
+        address.storage = *storage;
+        address.length = (storage->ss_family == AF_INET6) ? sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+        return factory(address);
     }
+    // The name is owned by the endpoint, which must outlive the probe
+    return std::make_unique<ResolvingProbe>(resolver, endpoint.get_fqhn(), family, std::move(factory));
+}
 
-    ping_cmd += fqhn;                // Specify fqhn
-    ping_cmd += " > /dev/null 2>&1"; // Discard output from command
+// network layer connection test is based on native ICMP echo requests.
+std::unique_ptr<Probe> make_probe_icmp( Resolver& resolver, Endpoint const& endpoint, bool useIPv6
+                                      , IcmpTransport* transport, std::uint64_t token)
+{
+    auto factory = [transport, token] (Address const& address) -> std::unique_ptr<Probe>
+    {
+        // Prefer batching over a shared socket
+        if (transport && transport->is_valid())
+        {
+            return std::make_unique<IcmpProbe>(address, *transport, token);
+        }
+        return std::make_unique<IcmpProbe>(address);
+    };
+
+    auto family = useIPv6 ? AF_INET6 : AF_INET;
+    return make_resolving_probe(resolver, endpoint, family, factory);
+}
 
-    // Call command
-    return (std::system(ping_cmd.c_str()) == 0) ? true : false;
+// transport layer connection test is based on a non-blocking connect.
+std::unique_ptr<Probe> make_probe_tcp(Resolver& resolver, Endpoint const& endpoint)
+{
+    // Port was validated on Endpoint construction
+    auto factory = [port = endpoint.get_port().value()] (Address const& address)
+    {
+        auto target = address;
+        target.set_port(port);
+        return std::make_unique<TcpProbe>(target);
+    };
+    return make_resolving_probe(resolver, endpoint, AF_UNSPEC, factory);
 }
 
-// transport layer connection test is based on nc.
-bool test_connection_tcp(std::string const& fqhn, std::string const& port)
+// transport layer connection test is based on a request-response exchange.
+std::unique_ptr<Probe> make_probe_udp(Resolver& resolver, Endpoint const& endpoint)
 {
-    // Create command
-    auto nc_cmd = std::string();
+    // Payload and expected response are owned by the endpoint, which must outlive the probe
+    auto factory = [ port = endpoint.get_port().value(), payload = endpoint.get_payload()
+                   , expected = endpoint.get_expected_response()] (Address const& address)
+    {
+        auto target = address;
+        target.set_port(port);
+        return std::make_unique<UdpProbe>(target, payload, expected);
+    };
+    return make_resolving_probe(resolver, endpoint, AF_UNSPEC, factory);
+}
 
-    nc_cmd += "nc -z "; // Establish connection, close afterwards
-    nc_cmd += fqhn;     // Specify address
-    nc_cmd += " ";
-    nc_cmd += port;     // Specify port
+// application layer connection test is based on a GET request over a kept alive connection.
+std::unique_ptr<Probe> make_probe_http(Resolver& resolver, Endpoint const& endpoint, Socket* connection)
+{
+    // IPv6 literals are bracketed in the Host header, default ports omitted
+    auto port = endpoint.get_port().value();
+    auto fqhn = endpoint.get_fqhn();
+    auto host = (fqhn.find(':') != std::string_view::npos) ? "[" + std::string(fqhn) + "]" : std::string(fqhn);
+    if (port != 80)
+    {
+        host += ":" + std::to_string(port);
+    }
 
-    // Call command
-    return (std::system(nc_cmd.c_str()) == 0) ? true : false;
+    // Path and expected body are owned by the endpoint, which must outlive the probe
+    auto factory = [ port, host = std::move(host), path = endpoint.get_payload()
+                   , status = endpoint.get_expected_status().value()
+                   , body = endpoint.get_expected_response(), connection] (Address const& address)
+    {
+        auto target = address;
+        target.set_port(port);
+        return std::make_unique<HttpProbe>(target, host, path, status, body, connection);
+    };
+    return make_resolving_probe(resolver, endpoint, AF_UNSPEC, factory);
+}
+
+// transport layer connection test based on the state of a persistent connection.
+std::unique_ptr<Probe> make_probe_tcp_persistent( Resolver& resolver, Endpoint const& endpoint
+                                                , Socket* connection, std::chrono::milliseconds keepalive)
+{
+    auto factory = [port = endpoint.get_port().value(), connection, keepalive] (Address const& address)
+    {
+        auto target = address;
+        target.set_port(port);
+        return std::make_unique<PersistentTcpProbe>(target, keepalive, connection);
+    };
+    return make_resolving_probe(resolver, endpoint, AF_UNSPEC, factory);
 }
 } // anon namespace
 
-bool test_connection(Endpoint const& endpoint)
+std::unique_ptr<Probe> make_probe(Endpoint const& endpoint, ProbeContext const& context)
 {
+    auto& resolver = context.resolver ? *context.resolver : Resolver::get_default();
+
     // Demux by specified protocol
     switch (endpoint.get_protocol())
     {
         case Endpoint::Protocol::ICMPV4:
-            return test_connection_icmp(endpoint.get_fqhn(), false);
+            return make_probe_icmp( resolver, endpoint, false
+                                  , context.icmpv4, context.token);
 
         case Endpoint::Protocol::ICMPV6:
-            return test_connection_icmp(endpoint.get_fqhn(), true);
+            return make_probe_icmp( resolver, endpoint, true
+                                  , context.icmpv6, context.token);
 
         case Endpoint::Protocol::TCP:
-            return test_connection_tcp( endpoint.get_fqhn()
-                                      , endpoint.get_port().value());
+            return make_probe_tcp(resolver, endpoint);
+
+        case Endpoint::Protocol::UDP:
+            return make_probe_udp(resolver, endpoint);
+
+        case Endpoint::Protocol::HTTP:
+            return make_probe_http(resolver, endpoint, context.connection);
+
+        case Endpoint::Protocol::TCP_PERSISTENT:
+            return make_probe_tcp_persistent(resolver, endpoint, context.connection, context.keepalive);
 
     // NOTE: Add additional protocol support here ....
     }
-    return false;
+    return nullptr;
+}
+
+bool test_connection(Endpoint const& endpoint, std::chrono::milliseconds timeout, int cancel_fd)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    auto probe = make_probe(endpoint);
+    if (!probe)
+    {
+        return false;
+    }
+    return run_probe(*probe, deadline, cancel_fd) == Probe::Status::UP;
 }
 
 } // namespace host_monitor
@@ -13,17 +13,54 @@
 #ifndef TESTCONNECTION_HPP_201706130910
 #define TESTCONNECTION_HPP_201706130910
 
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
 #include "HostMonitor.hpp"
+#include "Probe.hpp"
 
 namespace host_monitor
 {
 
+class IcmpTransport;
+class Resolver;
+class Socket;
+
+/// @brief Shared resources, probes created by make_probe() may use.
+struct ProbeContext
+{
+    IcmpTransport* icmpv4 = nullptr;   ///< Shared ICMPv4 transport, nullptr to use a socket per probe.
+    IcmpTransport* icmpv6 = nullptr;   ///< Shared ICMPv6 transport, nullptr to use a socket per probe.
+    std::uint64_t  token = 0;          ///< Token shared transports report the result with.
+    Resolver*      resolver = nullptr; ///< Resolver for host names, nullptr for the default resolver.
+    Socket*        connection = nullptr; ///< Idle connection kept alive between probes of a monitor,
+                                         ///< nullptr to close connections after each probe.
+    std::chrono::milliseconds keepalive = std::chrono::milliseconds(0); ///< Idle time before kernel keepalives
+                                                                         ///< on persistent connections, 0 for the default.
+};
+
+/**
+ * @brief Function to create a probe for a given endpoint.
+ * @note  The probe refers to the host name and payloads of @p endpoint.
+ * @param[in] endpoint   the endpoint to test. Must outlive the probe.
+ * @param[in] context    shared resources the probe may use.
+ * @returns probe suitable for @p endpoint. Probes of unresolvable endpoints
+ *          report DOWN. nullptr in case the protocol is not supported.
+ */
+std::unique_ptr<Probe> make_probe( Endpoint const& endpoint
+                                 , ProbeContext const& context = ProbeContext());
+
 /**
  * @brief Function to test if a given endpoint can be reached.
  * @param[in] endpoint   the endpoint to test.
- * @returns true in case @p endpoint is reachable. false if not.
+ * @param[in] timeout    deadline of the test, including name resolution.
+ * @param[in] cancel_fd  file descriptor aborting the test once readable. -1 if not cancellable.
+ * @returns true in case @p endpoint is reachable. false if not, on timeout or if cancelled.
  */
-bool test_connection(Endpoint const& endpoint);
+bool test_connection( Endpoint const&           endpoint
+                    , std::chrono::milliseconds timeout = DEFAULT_PROBE_TIMEOUT
+                    , int                       cancel_fd = -1);
 
 } // namespace host_monitor
 
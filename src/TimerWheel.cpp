@@ -0,0 +1,277 @@
+/**
+ * @file      TimerWheel.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <limits>
+#include <algorithm>
+
+#include "TimerWheel.hpp"
+
+namespace host_monitor
+{
+
+TimerWheel::Node::Node()
+    : id(0)
+    , prev_(nullptr)
+    , next_(nullptr)
+    , expires_(0)
+    , level_(0)
+{
+}
+
+TimerWheel::TimerWheel(Clock::time_point start)
+    : start_(start)
+    , current_(0)
+    , levels_()
+    , expired_()
+    , size_(0)
+{
+    for (auto& level : levels_)
+    {
+        for (auto& head : level.slots)
+        {
+            init_list(head);
+        }
+        level.count = 0;
+    }
+    init_list(expired_);
+}
+
+TimerWheel::~TimerWheel()
+{
+    // Leave no dangling links behind in nodes outliving the wheel
+    for (auto& level : levels_)
+    {
+        for (auto& head : level.slots)
+        {
+            while (head.next_ != &head)
+            {
+                unlink(*head.next_);
+            }
+        }
+    }
+}
+
+void TimerWheel::schedule(Node& node, Clock::time_point when)
+{
+    if (is_scheduled(node))
+    {
+        unlink(node);
+    }
+
+    // Due nodes expire on the next processed tick
+    node.expires_ = std::max(to_tick(when), current_ + 1);
+    link(node);
+}
+
+void TimerWheel::cancel(Node& node)
+{
+    if (is_scheduled(node))
+    {
+        unlink(node);
+    }
+}
+
+bool TimerWheel::is_scheduled(Node const& node)
+{
+    return node.next_ != nullptr;
+}
+
+int TimerWheel::next_timeout(Clock::time_point now) const
+{
+    using namespace std::chrono;
+
+    if (size_ == 0)
+    {
+        return -1;
+    }
+
+    // Find the next occupied slot on the lowest level, at the latest wake up
+    // on the next cascade refilling it.
+    auto due = next_cascade();
+    if (levels_[0].count != 0)
+    {
+        auto last = current_ | (slot_count(0) - 1);
+        due = last + 1;
+        for (auto tick = current_ + 1; tick <= last; ++tick)
+        {
+            auto const& head = levels_[0].slots[slot_index(0, tick)];
+            if (head.next_ != &head)
+            {
+                due = tick;
+                break;
+            }
+        }
+    }
+
+    auto when = to_time_point(due);
+    if (when <= now)
+    {
+        return 0;
+    }
+
+    auto timeout = duration_cast<milliseconds>(when - now).count();
+    if (Clock::time_point(now + milliseconds(timeout)) < when)
+    {
+        timeout += 1;
+    }
+    return static_cast<int>(std::min<decltype(timeout)>(timeout, std::numeric_limits<int>::max()));
+}
+
+std::size_t TimerWheel::size() const
+{
+    return size_;
+}
+
+std::uint64_t TimerWheel::to_tick(Clock::time_point when) const
+{
+    using namespace std::chrono;
+
+    if (when <= start_)
+    {
+        return 0;
+    }
+
+    // Round up, timers must never fire early
+    auto tick = duration_cast<milliseconds>(when - start_).count();
+    if (Clock::time_point(start_ + milliseconds(tick)) < when)
+    {
+        tick += 1;
+    }
+    return static_cast<std::uint64_t>(tick);
+}
+
+TimerWheel::Clock::time_point TimerWheel::to_time_point(std::uint64_t tick) const
+{
+    return start_ + std::chrono::milliseconds(tick);
+}
+
+void TimerWheel::link(Node& node)
+{
+    // Select the finest level covering the remaining time
+    auto delta = node.expires_ - current_;
+    auto placement = node.expires_;
+    auto level = std::size_t(0);
+    while (level < LEVELS && delta >= (std::uint64_t(1) << (ROOT_BITS + LEVEL_BITS * level)))
+    {
+        level += 1;
+    }
+
+    // Beyond the wheels range: park on the highest level, cascading relinks it again
+    if (level == LEVELS)
+    {
+        level = LEVELS - 1;
+        placement = current_ + (std::uint64_t(1) << (ROOT_BITS + LEVEL_BITS * level)) - 1;
+    }
+
+    push_back(levels_[level].slots[slot_index(level, placement)], node);
+    node.level_ = level;
+    levels_[level].count += 1;
+    size_ += 1;
+}
+
+void TimerWheel::unlink(Node& node)
+{
+    node.prev_->next_ = node.next_;
+    node.next_->prev_ = node.prev_;
+    node.prev_ = nullptr;
+    node.next_ = nullptr;
+
+    if (node.level_ < LEVELS)
+    {
+        levels_[node.level_].count -= 1;
+    }
+    size_ -= 1;
+}
+
+void TimerWheel::cascade(std::size_t level)
+{
+    // Detach the slot first, nodes may be relinked into the same slot
+    auto& head = levels_[level].slots[slot_index(level, current_)];
+    auto pending = Node();
+    init_list(pending);
+
+    while (head.next_ != &head)
+    {
+        auto& node = *head.next_;
+        unlink(node);
+        push_back(pending, node);
+    }
+
+    while (pending.next_ != &pending)
+    {
+        auto& node = *pending.next_;
+        node.prev_->next_ = node.next_;
+        node.next_->prev_ = node.prev_;
+        link(node);
+    }
+}
+
+std::uint64_t TimerWheel::next_cascade() const
+{
+    // Search each level for the next occupied slot before it wraps around.
+    // The wrap-around itself cascades the next higher level.
+    auto tick = std::uint64_t(0);
+    for (auto level = std::size_t(1); level < LEVELS; ++level)
+    {
+        auto shift = ROOT_BITS + LEVEL_BITS * (level - 1);
+        auto block = current_ >> shift;
+        auto last = block | (slot_count(level) - 1);
+
+        for (auto b = block + 1; b <= last; ++b)
+        {
+            auto const& head = levels_[level].slots[slot_index(level, b << shift)];
+            if (head.next_ != &head)
+            {
+                return b << shift;
+            }
+        }
+        tick = (last + 1) << shift;
+
+        if (levels_[level].count != 0)
+        {
+            break;
+        }
+    }
+    return tick;
+}
+
+void TimerWheel::init_list(Node& head)
+{
+    head.prev_ = &head;
+    head.next_ = &head;
+}
+
+void TimerWheel::push_back(Node& head, Node& node)
+{
+    node.prev_ = head.prev_;
+    node.next_ = &head;
+    head.prev_->next_ = &node;
+    head.prev_ = &node;
+}
+
+std::size_t TimerWheel::slot_count(std::size_t level)
+{
+    return std::size_t(1) << ((level == 0) ? ROOT_BITS : LEVEL_BITS);
+}
+
+std::size_t TimerWheel::slot_index(std::size_t level, std::uint64_t tick)
+{
+    if (level == 0)
+    {
+        return static_cast<std::size_t>(tick & (slot_count(0) - 1));
+    }
+
+    auto shift = ROOT_BITS + LEVEL_BITS * (level - 1);
+    return static_cast<std::size_t>((tick >> shift) & (slot_count(level) - 1));
+}
+
+} // namespace host_monitor
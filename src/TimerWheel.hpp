@@ -0,0 +1,217 @@
+/**
+ * @file      TimerWheel.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef TIMERWHEEL_HPP_202610161330
+#define TIMERWHEEL_HPP_202610161330
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace host_monitor
+{
+
+/**
+ * @brief Hierarchical timing wheel with millisecond resolution.
+ * @note  Insert and cancel are O(1), expiry is amortized O(1) per timer.
+ *        Timers are intrusive nodes owned by the caller. A node must be
+ *        cancelled before it is destroyed. Timers never fire early.
+ */
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Intrusive timer node. Embed in the object that should be scheduled.
+    struct Node
+    {
+        Node();
+
+        /* Disable copying and moving, the wheel links nodes by address */
+        Node(Node const& other) = delete;
+        Node& operator = (Node const& other) = delete;
+
+        std::uint64_t id;      ///< Caller defined identifier.
+
+    private:
+        friend class TimerWheel;
+        Node*         prev_;    // Previous node in list, nullptr if not scheduled
+        Node*         next_;    // Next node in list, nullptr if not scheduled
+        std::uint64_t expires_; // Expiry tick
+        std::size_t   level_;   // Level the node is linked on
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] start   Point in time of tick zero.
+     */
+    explicit TimerWheel(Clock::time_point start);
+
+    ~TimerWheel();
+
+    /**
+     * @brief Schedule a node. An already scheduled node is rescheduled.
+     * @param[in] node   Node to schedule.
+     * @param[in] when   Point in time the node expires.
+     */
+    void schedule(Node& node, Clock::time_point when);
+
+    /**
+     * @brief Cancel a scheduled node. Cancelling an unscheduled node is a no-op.
+     * @param[in] node   Node to cancel.
+     */
+    void cancel(Node& node);
+
+    /**
+     * @brief Check if a node is scheduled.
+     * @param[in] node   Node to check.
+     * @returns true if @p node is scheduled.
+     */
+    static bool is_scheduled(Node const& node);
+
+    /**
+     * @brief Expire all nodes due until @p now.
+     * @note  @p on_expired may schedule and cancel nodes, including the expired one.
+     * @param[in] now          Current point in time.
+     * @param[in] on_expired   Callable invoked with each expired Node&.
+     */
+    template<typename F>
+    void advance(Clock::time_point now, F&& on_expired);
+
+    /**
+     * @brief Get time until the wheel needs to be advanced next.
+     * @note  The returned value may be earlier than the next expiry, but never later.
+     * @param[in] now   Current point in time.
+     * @returns milliseconds until the next advance is required. -1 if no node is scheduled.
+     */
+    int next_timeout(Clock::time_point now) const;
+
+    /**
+     * @brief Get number of scheduled nodes.
+     * @returns number of scheduled nodes.
+     */
+    std::size_t size() const;
+
+    /* Disable copying and moving */
+    TimerWheel(TimerWheel const& other) = delete;
+    TimerWheel(TimerWheel&& other) = delete;
+    TimerWheel& operator = (TimerWheel const& other) = delete;
+    TimerWheel&& operator = (TimerWheel&& other) = delete;
+
+private:
+    static std::size_t const LEVELS = 5;      // Ranges: 256ms, 16s, 17min, 18h, 49d
+    static std::size_t const ROOT_BITS = 8;   // Lowest level has 256 slots
+    static std::size_t const LEVEL_BITS = 6;  // Higher levels have 64 slots
+    static std::size_t const EXPIRED = LEVELS; // Level of nodes collected for expiry
+
+    // Slots are circular doubly linked lists with a sentinel node each
+    struct Level
+    {
+        std::array<Node, std::size_t(1) << ROOT_BITS> slots; // Slot sentinels
+        std::size_t                                   count; // Nodes linked on this level
+    };
+
+    std::uint64_t to_tick(Clock::time_point when) const;
+
+    Clock::time_point to_time_point(std::uint64_t tick) const;
+
+    void link(Node& node);
+
+    void unlink(Node& node);
+
+    void cascade(std::size_t level);
+
+    std::uint64_t next_cascade() const;
+
+    static void init_list(Node& head);
+
+    static void push_back(Node& head, Node& node);
+
+    static std::size_t slot_count(std::size_t level);
+
+    static std::size_t slot_index(std::size_t level, std::uint64_t tick);
+
+    Clock::time_point         start_;   // Point in time of tick zero
+    std::uint64_t             current_; // Last processed tick
+    std::array<Level, LEVELS> levels_;  // Wheel levels, finest first
+    Node                      expired_; // Nodes collected for expiry
+    std::size_t               size_;    // Number of scheduled nodes
+};
+
+template<typename F>
+void TimerWheel::advance(Clock::time_point now, F&& on_expired)
+{
+    if (now < start_)
+    {
+        return;
+    }
+
+    // Process only ticks that fully passed
+    auto target = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - start_).count());
+
+    while (current_ < target)
+    {
+        if (size_ == 0)
+        {
+            current_ = target;
+            break;
+        }
+
+        // Nothing to expire on the lowest level: skip to the next cascade
+        if (levels_[0].count == 0)
+        {
+            auto last = next_cascade() - 1;
+            if (target <= last)
+            {
+                current_ = target;
+                break;
+            }
+            current_ = last;
+        }
+
+        current_ += 1;
+
+        // Refill lower levels from higher ones on wrap-around
+        for (auto level = std::size_t(0); level + 1 < LEVELS; ++level)
+        {
+            if (slot_index(level, current_) != 0)
+            {
+                break;
+            }
+            cascade(level + 1);
+        }
+
+        // Collect due nodes first. Callbacks may (re)schedule and cancel any node.
+        auto& head = levels_[0].slots[slot_index(0, current_)];
+        while (head.next_ != &head)
+        {
+            auto& node = *head.next_;
+            unlink(node);
+            push_back(expired_, node);
+            node.level_ = EXPIRED;
+            size_ += 1;
+        }
+
+        while (expired_.next_ != &expired_)
+        {
+            auto& node = *expired_.next_;
+            unlink(node);
+            on_expired(node);
+        }
+    }
+}
+
+} // namespace host_monitor
+
+#endif // TIMERWHEEL_HPP_202610161330
@@ -0,0 +1,130 @@
+/**
+ * @file      UdpProbe.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "UdpProbe.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Bytes of a response the expected prefix is matched against
+constexpr auto MAX_RESPONSE = std::size_t(2048);
+
+// Read the queued error. Returns the errno it carries, e.g. ECONNREFUSED for ICMP port unreachable.
+int read_queued_error(Socket const& sock)
+{
+    auto control = std::array<char, 512>();
+    auto msg = msghdr();
+    msg.msg_control = control.data();
+    msg.msg_controllen = control.size();
+    if (::recvmsg(sock.get(), &msg, MSG_ERRQUEUE) < 0)
+    {
+        return errno;
+    }
+
+    for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        auto is_v4 = cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVERR;
+        auto is_v6 = cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_RECVERR;
+        if (is_v4 || is_v6)
+        {
+            auto err = sock_extended_err();
+            std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+            return static_cast<int>(err.ee_errno);
+        }
+    }
+    return EIO;
+}
+} // anon namespace
+
+UdpProbe::UdpProbe(Address address, std::string_view payload, std::optional<std::string_view> expected)
+    : address_(std::move(address))
+    , payload_(payload)
+    , expected_(expected)
+    , sock_()
+{
+}
+
+Probe::Status UdpProbe::start()
+{
+    auto flags = SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sock_ = Socket(::socket(address_.family(), flags, 0));
+    if (!sock_.is_valid())
+    {
+        return Status::DOWN;
+    }
+
+    // Queue ICMP errors on the socket, they are signaled as POLLERR
+    auto on = 1;
+    if (address_.family() == AF_INET)
+    {
+        ::setsockopt(sock_.get(), IPPROTO_IP, IP_RECVERR, &on, sizeof(on));
+    }
+    else
+    {
+        ::setsockopt(sock_.get(), IPPROTO_IPV6, IPV6_RECVERR, &on, sizeof(on));
+    }
+
+    // Connected sockets only receive datagrams of the target
+    if ( ::connect(sock_.get(), address_.get(), address_.length) < 0
+      || ::send(sock_.get(), payload_.data(), payload_.size(), 0) < 0)
+    {
+        return Status::DOWN;
+    }
+    return Status::PENDING;
+}
+
+int UdpProbe::get_fd() const
+{
+    return sock_.get();
+}
+
+std::uint32_t UdpProbe::get_events() const
+{
+    return POLLIN;
+}
+
+Probe::Status UdpProbe::on_event(std::uint32_t events)
+{
+    // Port or host unreachable: fail without waiting for the deadline
+    if (events & POLLERR)
+    {
+        return (read_queued_error(sock_) == 0) ? Status::PENDING : Status::DOWN;
+    }
+
+    auto buffer = std::array<char, MAX_RESPONSE>();
+    auto n = ::recv(sock_.get(), buffer.data(), buffer.size(), MSG_TRUNC);
+    if (n < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? Status::PENDING : Status::DOWN;
+    }
+
+    if (!expected_)
+    {
+        return Status::UP;
+    }
+
+    auto received = std::string_view(buffer.data(), std::min(static_cast<std::size_t>(n), buffer.size()));
+    return (received.substr(0, expected_->size()) == *expected_) ? Status::UP : Status::DOWN;
+}
+
+} // namespace host_monitor
@@ -0,0 +1,60 @@
+/**
+ * @file      UdpProbe.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef UDPPROBE_HPP_202610162200
+#define UDPPROBE_HPP_202610162200
+
+#include <optional>
+#include <string_view>
+#include <cstdint>
+
+#include "Probe.hpp"
+#include "Socket.hpp"
+
+namespace host_monitor
+{
+
+/**
+ * @brief Probe sending a request datagram and waiting for a response.
+ * @note  ICMP errors, e.g. port unreachable, are queued on the socket via
+ *        IP_RECVERR and fail the probe immediately. Responses not starting
+ *        with the expected prefix fail the probe as well.
+ */
+class UdpProbe : public Probe
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] address    Resolved address of the target, including the port.
+     * @param[in] payload    Datagram to send. Must outlive the probe.
+     * @param[in] expected   Prefix the response must start with. Must outlive the probe.
+     */
+    UdpProbe(Address address, std::string_view payload, std::optional<std::string_view> expected);
+
+    Status start() override;
+
+    int get_fd() const override;
+
+    std::uint32_t get_events() const override;
+
+    Status on_event(std::uint32_t events) override;
+
+private:
+    Address                         address_;  // Target address
+    std::string_view                payload_;  // Request datagram
+    std::optional<std::string_view> expected_; // Expected response prefix
+    Socket                          sock_;     // Connected datagram socket
+};
+
+} // namespace host_monitor
+
+#endif // UDPPROBE_HPP_202610162200
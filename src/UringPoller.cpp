@@ -0,0 +1,354 @@
+/**
+ * @file      UringPoller.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "UringPoller.hpp"
+
+namespace host_monitor
+{
+namespace
+{
+// Features the poller relies on: completions are never dropped, waits take a timeout
+constexpr auto REQUIRED_FEATURES = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+
+// User data of requests whose completion is ignored
+constexpr auto IGNORED = std::uint64_t(0);
+
+int setup(unsigned entries, io_uring_params& params)
+{
+    // Deferred task work avoids interrupting the loop thread, available since Linux 5.19
+    params = io_uring_params();
+    params.flags = IORING_SETUP_COOP_TASKRUN;
+    auto fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0 && errno == EINVAL)
+    {
+        params = io_uring_params();
+        fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    }
+    return fd;
+}
+
+// Completions identify the file descriptor and the generation of its request
+std::uint64_t to_user_data(int fd, std::uint32_t generation)
+{
+    return (std::uint64_t(generation) << 32) | static_cast<std::uint32_t>(fd);
+}
+} // anon namespace
+
+UringPoller::UringPoller(unsigned entries)
+    : ring_()
+    , rings_(MAP_FAILED)
+    , rings_size_(0)
+    , sqes_(nullptr)
+    , sqes_size_(0)
+    , sq_head_(nullptr)
+    , sq_tail_(nullptr)
+    , sq_array_(nullptr)
+    , sq_mask_(0)
+    , sq_entries_(0)
+    , cq_head_(nullptr)
+    , cq_tail_(nullptr)
+    , cqes_(nullptr)
+    , cq_mask_(0)
+    , tail_(0)
+    , regs_()
+    , pending_()
+{
+    auto params = io_uring_params();
+    auto ring = Socket(setup(entries, params));
+    if (!ring.is_valid() || (params.features & REQUIRED_FEATURES) != REQUIRED_FEATURES)
+    {
+        return;
+    }
+
+    // Submission and completion ring share a single mapping
+    rings_size_ = std::max( params.sq_off.array + params.sq_entries * sizeof(unsigned)
+                          , params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    rings_ = ::mmap( nullptr, rings_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+                   , ring.get(), IORING_OFF_SQ_RING);
+    if (rings_ == MAP_FAILED)
+    {
+        return;
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    auto* sqes = ::mmap( nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+                       , ring.get(), IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        return;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* base = static_cast<char*>(rings_);
+    sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    sq_array_ = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+    cq_mask_ = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    tail_ = *sq_tail_;
+
+    ring_ = std::move(ring);
+}
+
+UringPoller::~UringPoller()
+{
+    if (sqes_)
+    {
+        ::munmap(sqes_, sqes_size_);
+    }
+    if (rings_ != MAP_FAILED)
+    {
+        ::munmap(rings_, rings_size_);
+    }
+}
+
+bool UringPoller::is_valid() const
+{
+    return ring_.is_valid();
+}
+
+Poller::Backend UringPoller::get_backend() const
+{
+    return Backend::IO_URING;
+}
+
+bool UringPoller::add(int fd, std::uint32_t events, std::uint64_t id)
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (regs_.size() <= static_cast<std::size_t>(fd))
+    {
+        regs_.resize(static_cast<std::size_t>(fd) + 1);
+    }
+
+    auto& reg = regs_[static_cast<std::size_t>(fd)];
+    if (reg.active)
+    {
+        return false;
+    }
+
+    // Generation 0 is never used, user data of requests is never IGNORED
+    reg.id = id;
+    reg.events = events;
+    reg.generation = std::max(reg.generation + 1, std::uint32_t(1));
+    reg.active = true;
+    queue_poll(fd, reg);
+    return true;
+}
+
+bool UringPoller::modify(int fd, std::uint32_t events, std::uint64_t id)
+{
+    if (fd < 0 || regs_.size() <= static_cast<std::size_t>(fd) || !regs_[static_cast<std::size_t>(fd)].active)
+    {
+        return false;
+    }
+
+    auto& reg = regs_[static_cast<std::size_t>(fd)];
+    queue_remove(fd, reg);
+    reg.id = id;
+    reg.events = events;
+    reg.generation = std::max(reg.generation + 1, std::uint32_t(1));
+    queue_poll(fd, reg);
+    return true;
+}
+
+void UringPoller::remove(int fd)
+{
+    if (fd < 0 || regs_.size() <= static_cast<std::size_t>(fd) || !regs_[static_cast<std::size_t>(fd)].active)
+    {
+        return;
+    }
+
+    auto& reg = regs_[static_cast<std::size_t>(fd)];
+    queue_remove(fd, reg);
+    reg.active = false;
+}
+
+std::size_t UringPoller::wait(PollEvent* events, std::size_t max, int timeout_ms)
+{
+    // Completions left over by the last call are returned without waiting.
+    // Re-armed requests are submitted once the events were handled, readiness
+    // the caller consumed in the meantime is not reported again.
+    auto n = harvest(events, max);
+    if (n > 0)
+    {
+        return n;
+    }
+
+    flush_pending();
+    enter(1, timeout_ms);
+    return harvest(events, max);
+}
+
+io_uring_sqe* UringPoller::get_sqe()
+{
+    // Submit queued entries if the ring is full
+    if (tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+    {
+        enter(0, 0);
+        if (tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+        {
+            return nullptr;
+        }
+    }
+
+    auto index = tail_ & sq_mask_;
+    auto* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    tail_ += 1;
+    return sqe;
+}
+
+void UringPoller::queue(Pending const& request)
+{
+    // Without a free entry the request waits for the next flush_pending()
+    auto* sqe = get_sqe();
+    if (!sqe)
+    {
+        pending_.push_back(request);
+        return;
+    }
+
+    sqe->opcode = request.opcode;
+    if (request.opcode == IORING_OP_POLL_ADD)
+    {
+        sqe->fd = request.fd;
+        sqe->poll32_events = regs_[static_cast<std::size_t>(request.fd)].events;
+        sqe->user_data = to_user_data(request.fd, request.generation);
+    }
+    else
+    {
+        sqe->fd = -1;
+        sqe->addr = to_user_data(request.fd, request.generation);
+        sqe->user_data = IGNORED;
+    }
+}
+
+void UringPoller::queue_poll(int fd, Registration const& reg)
+{
+    queue(Pending{IORING_OP_POLL_ADD, fd, reg.generation});
+}
+
+void UringPoller::queue_remove(int fd, Registration const& reg)
+{
+    // Outstanding requests pin the file, a lost removal would keep closed sockets open
+    queue(Pending{IORING_OP_POLL_REMOVE, fd, reg.generation});
+}
+
+void UringPoller::flush_pending()
+{
+    if (pending_.empty())
+    {
+        return;
+    }
+
+    // Polls of removed or replaced registrations are dropped, requests finding the ring full again are kept
+    auto pending = std::vector<Pending>();
+    pending.swap(pending_);
+    for (auto const& request : pending)
+    {
+        auto const& reg = regs_[static_cast<std::size_t>(request.fd)];
+        if ( request.opcode == IORING_OP_POLL_ADD
+          && (!reg.active || reg.generation != request.generation))
+        {
+            continue;
+        }
+        queue(request);
+    }
+}
+
+void UringPoller::enter(unsigned min_complete, int timeout_ms)
+{
+    __atomic_store_n(sq_tail_, tail_, __ATOMIC_RELEASE);
+    auto to_submit = tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (to_submit == 0 && min_complete == 0)
+    {
+        return;
+    }
+
+    if (min_complete == 0)
+    {
+        ::syscall(__NR_io_uring_enter, ring_.get(), to_submit, 0, 0, nullptr, 0);
+        return;
+    }
+
+    // Wait with timeout, the queued entries are submitted by the same call
+    auto ts = __kernel_timespec();
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (timeout_ms % 1000) * 1000000ll;
+
+    auto arg = io_uring_getevents_arg();
+    arg.sigmask = 0;
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = (timeout_ms >= 0) ? reinterpret_cast<std::uint64_t>(&ts) : 0;
+
+    auto flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    ::syscall(__NR_io_uring_enter, ring_.get(), to_submit, min_complete, flags, &arg, sizeof(arg));
+}
+
+std::size_t UringPoller::harvest(PollEvent* events, std::size_t max)
+{
+    auto head = *cq_head_;
+    auto tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    auto n = std::size_t(0);
+
+    while (head != tail && n < max)
+    {
+        auto const& cqe = cqes_[head & cq_mask_];
+        head += 1;
+
+        auto fd = static_cast<int>(static_cast<std::uint32_t>(cqe.user_data));
+        auto generation = static_cast<std::uint32_t>(cqe.user_data >> 32);
+        if ( cqe.user_data == IGNORED || regs_.size() <= static_cast<std::size_t>(fd)
+          || !regs_[static_cast<std::size_t>(fd)].active
+          || regs_[static_cast<std::size_t>(fd)].generation != generation)
+        {
+            // Completion of a removed or replaced request
+            continue;
+        }
+
+        // Failed requests are reported as error and not re-armed
+        auto& reg = regs_[static_cast<std::size_t>(fd)];
+        if (cqe.res < 0)
+        {
+            events[n++] = PollEvent{reg.id, EPOLLERR};
+            continue;
+        }
+
+        events[n++] = PollEvent{reg.id, static_cast<std::uint32_t>(cqe.res)};
+        queue_poll(fd, reg);
+    }
+
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+} // namespace host_monitor
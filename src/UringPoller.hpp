@@ -0,0 +1,124 @@
+/**
+ * @file      UringPoller.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef URINGPOLLER_HPP_202610171110
+#define URINGPOLLER_HPP_202610171110
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Poller.hpp"
+#include "Socket.hpp"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace host_monitor
+{
+
+/**
+ * @brief Poller based on io_uring(7), driven by raw system calls.
+ * @note  Registrations are one-shot poll requests, re-armed after each
+ *        completion to behave level-triggered. Registration changes only queue
+ *        submission entries: all changes of a loop iteration are submitted
+ *        together with the next wait, in a single system call. Requests finding
+ *        the submission ring full are kept and queued before the next wait.
+ *        Requires Linux 5.11 (IORING_FEAT_EXT_ARG).
+ */
+class UringPoller : public Poller
+{
+public:
+    /**
+     * @brief Constructor. Check is_valid() before use.
+     * @param[in] entries   Size of the submission queue.
+     */
+    explicit UringPoller(unsigned entries = 4096);
+
+    ~UringPoller() override;
+
+    /**
+     * @brief Check if the ring was set up.
+     * @returns false if the kernel lacks io_uring or a required feature.
+     */
+    bool is_valid() const;
+
+    Backend get_backend() const override;
+
+    bool add(int fd, std::uint32_t events, std::uint64_t id) override;
+
+    bool modify(int fd, std::uint32_t events, std::uint64_t id) override;
+
+    void remove(int fd) override;
+
+    std::size_t wait(PollEvent* events, std::size_t max, int timeout_ms) override;
+
+    /* Disable copying and moving */
+    UringPoller(UringPoller const& other) = delete;
+    UringPoller(UringPoller&& other) = delete;
+    UringPoller& operator = (UringPoller const& other) = delete;
+    UringPoller&& operator = (UringPoller&& other) = delete;
+
+private:
+    // Poll request of a file descriptor
+    struct Registration
+    {
+        std::uint64_t id = 0;         // Id reported with events
+        std::uint32_t events = 0;     // Events to wait for
+        std::uint32_t generation = 0; // Tells completions of replaced requests apart
+        bool          active = false; // File descriptor is registered
+    };
+
+    // Request that found the submission ring full
+    struct Pending
+    {
+        std::uint8_t  opcode;     // IORING_OP_POLL_ADD or IORING_OP_POLL_REMOVE
+        int           fd;         // File descriptor of the request
+        std::uint32_t generation; // Generation of the request
+    };
+
+    io_uring_sqe* get_sqe();
+
+    void queue(Pending const& request);
+
+    void queue_poll(int fd, Registration const& reg);
+
+    void queue_remove(int fd, Registration const& reg);
+
+    void flush_pending();
+
+    void enter(unsigned min_complete, int timeout_ms);
+
+    std::size_t harvest(PollEvent* events, std::size_t max);
+
+    Socket                    ring_;         // io_uring instance
+    void*                     rings_;        // Mapped submission and completion rings
+    std::size_t               rings_size_;   // Size of the ring mapping
+    io_uring_sqe*             sqes_;         // Mapped submission entries
+    std::size_t               sqes_size_;    // Size of the entry mapping
+    unsigned*                 sq_head_;      // Submission head, advanced by the kernel
+    unsigned*                 sq_tail_;      // Submission tail, advanced by us
+    unsigned*                 sq_array_;     // Submission index array
+    unsigned                  sq_mask_;      // Submission ring mask
+    unsigned                  sq_entries_;   // Submission ring size
+    unsigned*                 cq_head_;      // Completion head, advanced by us
+    unsigned*                 cq_tail_;      // Completion tail, advanced by the kernel
+    io_uring_cqe*             cqes_;         // Completion entries
+    unsigned                  cq_mask_;      // Completion ring mask
+    unsigned                  tail_;         // Local submission tail, published on enter
+    std::vector<Registration> regs_;         // Registrations by file descriptor
+    std::vector<Pending>      pending_;      // Requests to queue before the next wait
+};
+
+} // namespace host_monitor
+
+#endif // URINGPOLLER_HPP_202610171110
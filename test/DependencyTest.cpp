@@ -0,0 +1,248 @@
+/**
+ * @file      DependencyTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using namespace std::chrono;
+
+namespace
+{
+// Records each state change as (available, unreachable)
+struct RecordingObserver : public host_monitor::HostMonitorObserver
+{
+    void state_change(Data const& data) override
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx);
+        changes.emplace_back(data.available, data.unreachable);
+    }
+
+    std::vector<std::pair<bool, bool>> get() const
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx);
+        return changes;
+    }
+
+    mutable std::mutex                 mtx;
+    std::vector<std::pair<bool, bool>> changes;
+};
+
+bool wait_until(std::function<bool()> pred, milliseconds timeout)
+{
+    auto deadline = steady_clock::now() + timeout;
+    while (!pred() && steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(milliseconds(5));
+    }
+    return pred();
+}
+
+bool is_tested(HostMonitor const& mon)
+{
+    return mon.get_state().last_probe != system_clock::time_point();
+}
+} // anon namespace
+
+TEST(DependencyTest, SuppressesChildren)
+{
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        // The parent doesn't listen yet, the children do
+        auto gateway = LoopbackSocket();
+        auto parent = Endpoint::make_tcp_endpoint("127.0.0.1", gateway.port);
+        auto hosts = std::vector<std::unique_ptr<LoopbackSocket>>();
+        auto engine = MonitorEngine(mode, 1);
+        for (auto i = 0; i < 3; ++i)
+        {
+            hosts.push_back(std::make_unique<LoopbackSocket>());
+            hosts.back()->listen();
+            engine.add_dependency(parent, Endpoint::make_tcp_endpoint("127.0.0.1", hosts.back()->port));
+        }
+
+        auto parent_mon = HostMonitor(parent, milliseconds(50), engine);
+        ASSERT_TRUE(wait_until([&parent_mon] () { return is_tested(parent_mon); }, milliseconds(1000)));
+        ASSERT_FALSE(parent_mon.is_available());
+
+        // Children are never tested, each observer is informed once
+        auto children = std::vector<std::unique_ptr<HostMonitor>>();
+        auto observers = std::vector<std::shared_ptr<RecordingObserver>>();
+        for (auto const& host : hosts)
+        {
+            auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", host->port);
+            observers.push_back(std::make_shared<RecordingObserver>());
+            children.push_back(std::make_unique<HostMonitor>(ep, milliseconds(50), engine));
+            children.back()->add_observer(observers.back());
+        }
+
+        std::this_thread::sleep_for(milliseconds(300));
+        for (auto i = std::size_t(0); i < children.size(); ++i)
+        {
+            auto state = children[i]->get_state();
+            ASSERT_FALSE(state.available);
+            ASSERT_TRUE(state.unreachable);
+            ASSERT_EQ(system_clock::time_point(), state.last_probe);
+            ASSERT_EQ((std::vector<std::pair<bool, bool>>{{false, true}}), observers[i]->get());
+        }
+
+        // Once the parent is back, the children are tested again
+        gateway.listen();
+        for (auto i = std::size_t(0); i < children.size(); ++i)
+        {
+            auto const& child = children[i];
+            ASSERT_TRUE(wait_until([&child] () { return child->is_available(); }, milliseconds(1000)));
+            ASSERT_FALSE(child->get_state().unreachable);
+            ASSERT_EQ((std::vector<std::pair<bool, bool>>{{false, true}, {true, false}}), observers[i]->get());
+        }
+    }
+}
+
+TEST(DependencyTest, Transitive)
+{
+    auto core = LoopbackSocket();
+    auto gateway = LoopbackSocket();
+    auto host = LoopbackSocket();
+    gateway.listen();
+    host.listen();
+
+    auto core_ep = Endpoint::make_tcp_endpoint("127.0.0.1", core.port);
+    auto gateway_ep = Endpoint::make_tcp_endpoint("127.0.0.1", gateway.port);
+    auto host_ep = Endpoint::make_tcp_endpoint("127.0.0.1", host.port);
+
+    // Dependencies are declared after the monitors are registered
+    auto engine = MonitorEngine(1);
+    auto core_mon = HostMonitor(core_ep, milliseconds(50), engine);
+    auto gateway_mon = HostMonitor(gateway_ep, milliseconds(50), engine);
+    auto host_mon = HostMonitor(host_ep, milliseconds(50), engine);
+    ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.is_available(); }, milliseconds(1000)));
+    ASSERT_TRUE(wait_until([&core_mon] () { return is_tested(core_mon); }, milliseconds(1000)));
+
+    engine.add_dependency(core_ep, gateway_ep);
+    engine.add_dependency(gateway_ep, host_ep);
+    ASSERT_TRUE(wait_until([&gateway_mon] () { return gateway_mon.get_state().unreachable; }, milliseconds(1000)));
+    ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.get_state().unreachable; }, milliseconds(1000)));
+    ASSERT_FALSE(host_mon.is_available());
+
+    // Without the dependency, the host is tested again
+    engine.del_dependency(host_ep);
+    ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.is_available(); }, milliseconds(1000)));
+    ASSERT_TRUE(gateway_mon.get_state().unreachable);
+}
+
+TEST(DependencyTest, RemovedParent)
+{
+    auto gateway = LoopbackSocket();
+    auto host = LoopbackSocket();
+    host.listen();
+    auto gateway_ep = Endpoint::make_tcp_endpoint("127.0.0.1", gateway.port);
+    auto host_ep = Endpoint::make_tcp_endpoint("127.0.0.1", host.port);
+
+    auto engine = MonitorEngine(1);
+    engine.add_dependency(gateway_ep, host_ep);
+    auto host_mon = HostMonitor(host_ep, milliseconds(50), engine);
+    {
+        auto gateway_mon = HostMonitor(gateway_ep, milliseconds(50), engine);
+        ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.get_state().unreachable; }, milliseconds(1000)));
+    }
+
+    // The last state of a removed parent doesn't suppress tests
+    ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.is_available(); }, milliseconds(1000)));
+}
+
+TEST(DependencyTest, Cycles)
+{
+    auto a = Endpoint::make_icmpv4_endpoint("127.0.0.1");
+    auto b = Endpoint::make_icmpv4_endpoint("127.0.0.2");
+    auto c = Endpoint::make_icmpv4_endpoint("127.0.0.3");
+
+    auto engine = MonitorEngine(1);
+    ASSERT_THROW(engine.add_dependency(a, a), std::runtime_error);
+    engine.add_dependency(a, b);
+    engine.add_dependency(b, c);
+    ASSERT_THROW(engine.add_dependency(c, a), std::runtime_error);
+    ASSERT_THROW(engine.add_dependency(c, b), std::runtime_error);
+
+    // Replacing a parent lifts the cycle
+    engine.add_dependency(a, c);
+    ASSERT_NO_THROW(engine.add_dependency(c, b));
+    engine.del_dependency(b);
+    engine.del_dependency(b);
+    ASSERT_NO_THROW(engine.add_dependency(b, a));
+}
+
+TEST(DependencyTest, SharedParentEndpoint)
+{
+    auto gateway = LoopbackSocket();
+    auto host = LoopbackSocket();
+    host.listen();
+    auto gateway_ep = Endpoint::make_tcp_endpoint("127.0.0.1", gateway.port);
+    auto host_ep = Endpoint::make_tcp_endpoint("127.0.0.1", host.port);
+
+    auto engine = MonitorEngine(1);
+    engine.add_dependency(gateway_ep, host_ep);
+    // The first gateway monitor reports once only
+    auto gateway_mon = HostMonitor(gateway_ep, seconds(10), engine);
+    auto host_mon = HostMonitor(host_ep, milliseconds(50), engine);
+    ASSERT_TRUE(wait_until([&gateway_mon] () { return is_tested(gateway_mon); }, milliseconds(1000)));
+    {
+        auto other_mon = HostMonitor(gateway_ep, milliseconds(50), engine);
+        ASSERT_TRUE(wait_until([&other_mon] () { return is_tested(other_mon); }, milliseconds(1000)));
+        ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.get_state().unreachable; }, milliseconds(1000)));
+    }
+
+    // The remaining monitor of the gateway still sees it down
+    std::this_thread::sleep_for(milliseconds(200));
+    ASSERT_TRUE(host_mon.get_state().unreachable);
+    ASSERT_FALSE(host_mon.is_available());
+}
+
+TEST(DependencyTest, DampingAppliesAfterRecovery)
+{
+    auto gateway = LoopbackSocket();
+    auto host = LoopbackSocket();
+    host.listen();
+    auto gateway_ep = Endpoint::make_tcp_endpoint("127.0.0.1", gateway.port);
+    auto host_ep = Endpoint::make_tcp_endpoint("127.0.0.1", host.port);
+
+    // Up on 3 successes out of the last 5 tests
+    auto damping = HostMonitor::Damping();
+    damping.failures = 3;
+    damping.successes = 3;
+    damping.window = 5;
+
+    // The host builds up a clean history before the dependency is declared
+    auto engine = MonitorEngine(1);
+    auto gateway_mon = HostMonitor(gateway_ep, milliseconds(50), engine);
+    auto host_mon = HostMonitor(host_ep, HostMonitor::Schedule::fixed(milliseconds(50)), damping, engine);
+    ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.get_latency().get_count() >= 5; }, milliseconds(1000)));
+    ASSERT_TRUE(host_mon.is_available());
+
+    engine.add_dependency(gateway_ep, host_ep);
+    ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.get_state().unreachable; }, milliseconds(1000)));
+    std::this_thread::sleep_for(milliseconds(200));
+    auto tested = host_mon.get_latency().get_count();
+
+    // Coming back takes the successful tests of the damping
+    engine.del_dependency(host_ep);
+    ASSERT_TRUE(wait_until([&host_mon] () { return host_mon.is_available(); }, milliseconds(1000)));
+    ASSERT_LE(tested + 3, host_mon.get_latency().get_count());
+}
@@ -0,0 +1,131 @@
+/**
+ * @file      EndpointTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include "Endpoint.hpp"
+#include "TestConnection.hpp"
+
+using host_monitor::Endpoint;
+
+TEST(EndpointTest, Accessors)
+{
+    auto icmp = Endpoint::make_icmpv4_endpoint("127.0.0.1");
+    ASSERT_EQ("127.0.0.1", icmp.get_fqhn());
+    ASSERT_FALSE(icmp.get_port());
+    ASSERT_EQ("127.0.0.1", icmp.get_target());
+    ASSERT_EQ(nullptr, icmp.get_address());
+
+    auto tcp = Endpoint::make_tcp_endpoint("localhost", "8080");
+    ASSERT_EQ("localhost", tcp.get_fqhn());
+    ASSERT_EQ(8080, tcp.get_port().value());
+    ASSERT_EQ("localhost:8080", tcp.get_target());
+
+    ASSERT_THROW(Endpoint::make_tcp_endpoint("localhost", "0"), std::runtime_error);
+    ASSERT_THROW(Endpoint::make_tcp_endpoint("localhost", "65536"), std::runtime_error);
+    ASSERT_THROW(Endpoint::make_tcp_endpoint("localhost", "http"), std::runtime_error);
+
+    auto persistent = Endpoint::make_tcp_persistent_endpoint("localhost", "22");
+    ASSERT_EQ(Endpoint::Protocol::TCP_PERSISTENT, persistent.get_protocol());
+    ASSERT_EQ("localhost:22", persistent.get_target());
+    ASSERT_NE(persistent, Endpoint::make_tcp_endpoint("localhost", "22"));
+
+    auto udp = Endpoint::make_udp_endpoint("localhost", "53", "query", "answer");
+    ASSERT_EQ(Endpoint::Protocol::UDP, udp.get_protocol());
+    ASSERT_EQ("localhost:53", udp.get_target());
+    ASSERT_EQ("query", udp.get_payload());
+    ASSERT_EQ("answer", udp.get_expected_response().value());
+    ASSERT_FALSE(Endpoint::make_udp_endpoint("localhost", "53").get_expected_response());
+    ASSERT_THROW(Endpoint::make_udp_endpoint("localhost", "0"), std::runtime_error);
+
+    auto http = Endpoint::make_http_endpoint("localhost", "8080", "/health", 204, "ok");
+    ASSERT_EQ(Endpoint::Protocol::HTTP, http.get_protocol());
+    ASSERT_EQ("localhost:8080/health", http.get_target());
+    ASSERT_EQ("/health", http.get_payload());
+    ASSERT_EQ(204, http.get_expected_status().value());
+    ASSERT_EQ("ok", http.get_expected_response().value());
+    ASSERT_FALSE(udp.get_expected_status());
+    ASSERT_THROW(Endpoint::make_http_endpoint("localhost", "80", "health"), std::runtime_error);
+    ASSERT_THROW(Endpoint::make_http_endpoint("localhost", "80", "/a b"), std::runtime_error);
+    ASSERT_THROW(Endpoint::make_http_endpoint("localhost", "80", "/", 600), std::runtime_error);
+}
+
+TEST(EndpointTest, NamesAreInterned)
+{
+    auto a = Endpoint::make_icmpv4_endpoint(std::string("host.test"));
+    auto b = Endpoint::make_tcp_endpoint(std::string("host.test"), "80");
+    ASSERT_EQ(a.get_fqhn().data(), b.get_fqhn().data());
+}
+
+TEST(EndpointTest, InternedNamesOutliveTheirOrigin)
+{
+    auto copy = std::optional<Endpoint>();
+    {
+        auto origin = Endpoint::make_icmpv4_endpoint(std::string("released.test"));
+        copy = origin;
+    }
+    ASSERT_EQ("released.test", copy->get_fqhn());
+
+    // Released names are interned again on demand
+    copy.reset();
+    auto again = Endpoint::make_icmpv4_endpoint(std::string("released.test"));
+    ASSERT_EQ("released.test", again.get_fqhn());
+    ASSERT_EQ(again, Endpoint::make_icmpv4_endpoint("released.test"));
+}
+
+TEST(EndpointTest, EqualityAndHashing)
+{
+    auto a = Endpoint::make_tcp_endpoint("host.test", "80");
+    auto b = Endpoint::make_tcp_endpoint("host.test", "80");
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(std::hash<Endpoint>()(a), std::hash<Endpoint>()(b));
+
+    ASSERT_NE(a, Endpoint::make_tcp_endpoint("host.test", "81"));
+    ASSERT_NE(a, Endpoint::make_tcp_endpoint("other.test", "80"));
+    ASSERT_NE( Endpoint::make_icmpv4_endpoint("host.test")
+             , Endpoint::make_icmpv6_endpoint("host.test"));
+    ASSERT_NE(a, Endpoint::make_udp_endpoint("host.test", "80"));
+    ASSERT_EQ( Endpoint::make_udp_endpoint("host.test", "53", "q")
+             , Endpoint::make_udp_endpoint("host.test", "53", "q"));
+    ASSERT_NE( Endpoint::make_udp_endpoint("host.test", "53", "q")
+             , Endpoint::make_udp_endpoint("host.test", "53", "q", "a"));
+    ASSERT_NE( Endpoint::make_http_endpoint("host.test", "80", "/", 200)
+             , Endpoint::make_http_endpoint("host.test", "80", "/", 204));
+
+    auto map = std::unordered_map<Endpoint, int>();
+    map[a] = 1;
+    map[b] += 1;
+    map[Endpoint::make_icmpv4_endpoint("host.test")] = 5;
+    ASSERT_EQ(2u, map.size());
+    ASSERT_EQ(2, map.at(Endpoint::make_tcp_endpoint("host.test", "80")));
+}
+
+TEST(EndpointTest, PreResolvedAddress)
+{
+    auto storage = sockaddr_storage();
+    auto* in = reinterpret_cast<sockaddr_in*>(&storage);
+    in->sin_family = AF_INET;
+    in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    // Name can't be resolved, the probe uses the given address instead
+    auto plain = Endpoint::make_icmpv4_endpoint("asdkhads.local");
+    auto resolved = plain.with_address(storage);
+    ASSERT_EQ(nullptr, plain.get_address());
+    ASSERT_NE(nullptr, resolved.get_address());
+    ASSERT_EQ(plain, resolved);
+
+    ASSERT_TRUE(host_monitor::test_connection(resolved));
+}
@@ -0,0 +1,203 @@
+/**
+ * @file      FlapDamperTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "HostMonitorImpl.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::FlapDamper;
+using host_monitor::HostMonitor;
+using host_monitor::HostMonitorObserver;
+using namespace std::chrono;
+
+namespace
+{
+auto const START = FlapDamper::Clock::time_point();
+
+// Feeds @p results one second apart, returns the published availability afterwards
+bool feed(FlapDamper& damper, char const* results, FlapDamper::Clock::time_point& now)
+{
+    auto available = false;
+    for (auto const* r = results; *r; ++r)
+    {
+        now += seconds(1);
+        available = damper.update(*r == '+', now);
+    }
+    return available;
+}
+
+class CountingObserver : public HostMonitorObserver
+{
+public:
+    void state_change(Data const& data) override
+    {
+        changes += 1;
+        available = data.available;
+    }
+
+    int  changes = 0;
+    bool available = false;
+};
+} // anon namespace
+
+TEST(FlapDamperTest, DefaultFollowsEachResult)
+{
+    auto damper = FlapDamper(HostMonitor::Damping());
+    auto now = START;
+    ASSERT_TRUE(feed(damper, "+", now));
+    ASSERT_FALSE(feed(damper, "-", now));
+    ASSERT_TRUE(feed(damper, "+", now));
+    ASSERT_FALSE(damper.is_suppressed());
+}
+
+TEST(FlapDamperTest, ConsecutiveThresholds)
+{
+    auto damping = HostMonitor::Damping();
+    damping.failures = 3;
+    damping.successes = 2;
+    auto damper = FlapDamper(damping);
+    auto now = START;
+
+    ASSERT_FALSE(feed(damper, "+", now));
+    ASSERT_TRUE(feed(damper, "+", now));
+
+    // Interrupted failures don't count
+    ASSERT_TRUE(feed(damper, "--+--+", now));
+    ASSERT_FALSE(feed(damper, "---", now));
+    ASSERT_FALSE(feed(damper, "+-+-", now));
+    ASSERT_TRUE(feed(damper, "++", now));
+}
+
+TEST(FlapDamperTest, SeededAvailability)
+{
+    auto damping = HostMonitor::Damping();
+    damping.failures = 3;
+    damping.successes = 2;
+    auto damper = FlapDamper(damping);
+    auto now = START;
+
+    // A seeded host stays up until the failure threshold is met
+    damper.seed(true);
+    ASSERT_TRUE(feed(damper, "+", now));
+    ASSERT_TRUE(feed(damper, "--", now));
+    ASSERT_FALSE(feed(damper, "-", now));
+}
+
+TEST(FlapDamperTest, SlidingWindow)
+{
+    // Down on 3 failures out of the last 5 tests, up on 4 successes out of 5
+    auto damping = HostMonitor::Damping();
+    damping.failures = 3;
+    damping.successes = 4;
+    damping.window = 5;
+    auto damper = FlapDamper(damping);
+    auto now = START;
+
+    ASSERT_FALSE(feed(damper, "+-++", now));
+    ASSERT_TRUE(feed(damper, "+", now));
+    ASSERT_TRUE(feed(damper, "-+-+", now));
+    ASSERT_FALSE(feed(damper, "-", now));
+
+    // Results before the state change don't count
+    ASSERT_FALSE(feed(damper, "+++", now));
+    ASSERT_TRUE(feed(damper, "+", now));
+}
+
+TEST(FlapDamperTest, ForcedAvailability)
+{
+    auto damping = HostMonitor::Damping();
+    damping.failures = 3;
+    damping.successes = 3;
+    damping.window = 5;
+    auto damper = FlapDamper(damping);
+    auto now = START;
+    ASSERT_TRUE(feed(damper, "+++++", now));
+
+    // The clean history before forcing doesn't count towards coming back
+    damper.force(false);
+    ASSERT_FALSE(feed(damper, "++", now));
+    ASSERT_TRUE(feed(damper, "+", now));
+}
+
+TEST(FlapDamperTest, FlappingIsSuppressed)
+{
+    auto damping = HostMonitor::Damping();
+    damping.penalty = 1000.0;
+    damping.suppress_limit = 2500.0;
+    damping.reuse_limit = 750.0;
+    damping.half_life = seconds(10);
+    auto damper = FlapDamper(damping);
+    auto now = START;
+
+    // Third change within a few seconds exceeds the suppress limit
+    ASSERT_FALSE(feed(damper, "+-", now));
+    ASSERT_FALSE(damper.is_suppressed());
+    ASSERT_FALSE(feed(damper, "+", now));
+    ASSERT_TRUE(damper.is_suppressed());
+    ASSERT_FALSE(feed(damper, "-+-+", now));
+
+    // Penalty halves every 10 seconds while the host is stable
+    auto penalty = damper.get_penalty();
+    now += seconds(10);
+    ASSERT_FALSE(damper.update(true, now));
+    ASSERT_NEAR(penalty / 2, damper.get_penalty(), 1.0);
+
+    // Once below the reuse limit the current state is published
+    now += seconds(30);
+    ASSERT_TRUE(damper.update(true, now));
+    ASSERT_FALSE(damper.is_suppressed());
+}
+
+TEST(FlapDamperTest, InvalidDamping)
+{
+    auto zero = HostMonitor::Damping();
+    zero.failures = 0;
+    ASSERT_THROW(FlapDamper{zero}, std::runtime_error);
+
+    auto window = HostMonitor::Damping();
+    window.window = 65;
+    ASSERT_THROW(FlapDamper{window}, std::runtime_error);
+    window.window = 2;
+    window.failures = 3;
+    ASSERT_THROW(FlapDamper{window}, std::runtime_error);
+
+    auto penalty = HostMonitor::Damping();
+    penalty.penalty = 1.0;
+    penalty.suppress_limit = 1.0;
+    penalty.reuse_limit = 2.0;
+    penalty.half_life = seconds(1);
+    ASSERT_THROW(FlapDamper{penalty}, std::runtime_error);
+}
+
+TEST(FlapDamperTest, ObserversSeeDampedState)
+{
+    auto damping = HostMonitor::Damping();
+    damping.failures = 2;
+    auto monitor = std::make_shared<HostMonitor::Impl>( Endpoint::make_icmpv4_endpoint("127.0.0.1")
+                                                      , HostMonitor::Schedule::fixed(seconds(1)), damping);
+    auto observer = std::make_shared<CountingObserver>();
+    monitor->add_observer(observer);
+
+    monitor->report(true, milliseconds(1));
+    monitor->report(false, milliseconds(0));
+    ASSERT_EQ(1, observer->changes);
+    ASSERT_TRUE(monitor->is_available());
+    ASSERT_EQ(1u, monitor->get_state().consecutive_failures);
+
+    monitor->report(false, milliseconds(0));
+    ASSERT_EQ(2, observer->changes);
+    ASSERT_FALSE(observer->available);
+    ASSERT_FALSE(monitor->is_available());
+}
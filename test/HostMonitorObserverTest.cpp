@@ -13,9 +13,11 @@
 #include <thread>
 #include <chrono>
 #include <memory>
+#include <atomic>
 #include <gtest/gtest.h>
 #include "HostMonitor.hpp"
 #include "HostMonitorObserver.hpp"
+#include "LoopbackSocket.hpp"
 
 using host_monitor::Endpoint;
 using host_monitor::HostMonitor;
@@ -75,6 +77,42 @@ TEST(HostMonitorObserverTest, TCPToGoogle)
     ASSERT_TRUE(obs->available);
 }
 
+TEST(HostMonitorObserverTest, TCPToLoopbackListener)
+{
+    // Create Monitor. Start listening after the observer was added.
+    auto listener = LoopbackSocket();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+    auto obs = std::make_shared<Observer>();
+
+    mon.add_observer(obs);
+    listener.listen();
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ASSERT_TRUE(obs->available);
+}
+
+TEST(HostMonitorObserverTest, TCPToLoopbackListenerNotified)
+{
+    // Create Monitor. State changes are delivered by the notifier.
+    auto notifier = host_monitor::Notifier(16, host_monitor::Notifier::OverflowPolicy::DROP_OLDEST);
+    auto listener = LoopbackSocket();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+    auto obs = std::make_shared<Observer>();
+
+    mon.add_observer(obs, notifier);
+    listener.listen();
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ASSERT_TRUE(obs->available);
+    ASSERT_EQ(1u, notifier.get_statistics(obs).delivered);
+}
+
 TEST(HostMonitorObserverTest, ICMPv4ToInvalid)
 {
     // Create Monitor.
@@ -120,3 +158,43 @@ TEST(HostMonitorObserverTest, TCPToInvalid)
     ASSERT_FALSE(obs->available);
 }
 
+
+// Observer replacing itself by another observer on the first state change.
+struct ReplacingObserver : public host_monitor::HostMonitorObserver
+{
+    virtual void state_change(Data const&) override
+    {
+        calls += 1;
+        monitor->del_observer(self.lock());
+        monitor->add_observer(replacement);
+    }
+
+    HostMonitor*                               monitor = nullptr;
+    std::weak_ptr<HostMonitorObserver>         self;
+    std::shared_ptr<Observer>                  replacement = std::make_shared<Observer>();
+    std::atomic<int>                           calls{0};
+};
+
+TEST(HostMonitorObserverTest, ChangeObserversFromObserver)
+{
+    // Create Monitor. The listener comes and goes, causing state changes.
+    auto listener = std::make_unique<LoopbackSocket>();
+    auto port = listener->port;
+    listener->listen();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", port);
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+    auto obs = std::make_shared<ReplacingObserver>();
+    obs->monitor = &mon;
+    obs->self = obs;
+    obs->replacement->available = true;
+
+    mon.add_observer(obs);
+
+    // Wait for target to respond, then for it to vanish
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    listener.reset();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    ASSERT_EQ(1, obs->calls);
+    ASSERT_FALSE(obs->replacement->available);
+}
@@ -12,8 +12,10 @@
 
 #include <thread>
 #include <chrono>
+#include <stdexcept>
 #include <gtest/gtest.h>
 #include "HostMonitor.hpp"
+#include "LoopbackSocket.hpp"
 
 using host_monitor::Endpoint;
 using host_monitor::HostMonitor;
@@ -54,6 +56,137 @@ TEST(HostMonitorTest, TCPToGoogle)
     ASSERT_TRUE(mon.is_available());
 }
 
+TEST(HostMonitorTest, ICMPv4ToLoopback)
+{
+    // Create Monitor.
+    auto ep = Endpoint::make_icmpv4_endpoint("127.0.0.1");
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ASSERT_TRUE(mon.is_available());
+}
+
+TEST(HostMonitorTest, ICMPv6ToLoopback)
+{
+    // Create Monitor.
+    auto ep = Endpoint::make_icmpv6_endpoint("::1");
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ASSERT_TRUE(mon.is_available());
+}
+
+TEST(HostMonitorTest, TCPToLoopbackListener)
+{
+    // Create Monitor.
+    auto listener = LoopbackSocket();
+    listener.listen();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ASSERT_TRUE(mon.is_available());
+}
+
+TEST(HostMonitorTest, TCPToLoopbackClosedPort)
+{
+    // Create Monitor. The port is bound but nobody listens on it.
+    auto closed = LoopbackSocket();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", closed.port);
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ASSERT_FALSE(mon.is_available());
+}
+
+TEST(HostMonitorTest, StateOfLoopbackListener)
+{
+    // Create Monitor. No test finished yet.
+    auto listener = LoopbackSocket();
+    listener.listen();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+    auto before = std::chrono::system_clock::now();
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    auto state = mon.get_state();
+    ASSERT_TRUE(state.available);
+    ASSERT_EQ(0u, state.consecutive_failures);
+    ASSERT_LE(before, state.last_change);
+    ASSERT_LE(state.last_change, state.last_probe);
+    ASSERT_LT(std::chrono::nanoseconds(0), state.rtt);
+
+    // Each successful test recorded its round-trip time
+    auto latency = mon.get_latency();
+    ASSERT_EQ(2u, latency.get_count());
+    ASSERT_LT(std::chrono::microseconds(0), latency.get_percentile(99.0));
+}
+
+TEST(HostMonitorTest, StateOfLoopbackClosedPort)
+{
+    // Create Monitor. Failures are counted, the state never changed.
+    auto closed = LoopbackSocket();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", closed.port);
+    auto mon = HostMonitor(ep, std::chrono::seconds(1));
+
+    // Wait for two tests to finish
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+    auto state = mon.get_state();
+    ASSERT_FALSE(state.available);
+    ASSERT_EQ(2u, state.consecutive_failures);
+    ASSERT_EQ(std::chrono::system_clock::time_point(), state.last_change);
+    ASSERT_NE(std::chrono::system_clock::time_point(), state.last_probe);
+    ASSERT_EQ(std::chrono::nanoseconds(0), state.rtt);
+}
+
+TEST(HostMonitorTest, SubSecondInterval)
+{
+    // Create Monitor, testing every 100ms.
+    auto closed = LoopbackSocket();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", closed.port);
+    auto mon = HostMonitor(ep, std::chrono::milliseconds(100));
+    ASSERT_EQ(std::chrono::milliseconds(100), mon.get_interval());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1050));
+
+    auto state = mon.get_state();
+    ASSERT_LE(9u, state.consecutive_failures);
+    ASSERT_GE(11u, state.consecutive_failures);
+}
+
+TEST(HostMonitorTest, TimeoutCountsAsFailure)
+{
+    auto blackhole = BlackholeListener();
+
+    // Create Monitor with a deadline longer than the interval.
+    auto schedule = HostMonitor::Schedule::fixed(std::chrono::milliseconds(100));
+    schedule.timeout = std::chrono::milliseconds(300);
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", blackhole.listener.port);
+    auto mon = HostMonitor(ep, schedule);
+
+    // Each test fails after 300ms, the next one starts right away
+    std::this_thread::sleep_for(std::chrono::milliseconds(1050));
+
+    auto state = mon.get_state();
+    ASSERT_FALSE(state.available);
+    ASSERT_LE(3u, state.consecutive_failures);
+    ASSERT_GE(4u, state.consecutive_failures);
+
+    schedule.timeout = std::chrono::milliseconds(0);
+    ASSERT_THROW(HostMonitor(ep, schedule), std::runtime_error);
+}
+
 TEST(HostMonitorTest, ICMPv4ToInvalid)
 {
     // Create Monitor.
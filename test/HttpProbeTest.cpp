@@ -0,0 +1,345 @@
+/**
+ * @file      HttpProbeTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <mutex>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "HttpProbe.hpp"
+#include "TestConnection.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using host_monitor::HttpResponseParser;
+using host_monitor::Probe;
+using host_monitor::Socket;
+using namespace std::chrono;
+
+namespace
+{
+// HTTP server on 127.0.0.1 answering each request with a fixed response
+class StubHttp
+{
+public:
+    StubHttp()
+        : listener_()
+        , mtx_()
+        , response_("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok")
+        , drop_(false)
+        , accepted_(0)
+        , requests_(0)
+        , stop_(false)
+        , thread_()
+    {
+        listener_.listen();
+        thread_ = std::thread(&StubHttp::run, this);
+    }
+
+    ~StubHttp()
+    {
+        stop_ = true;
+        thread_.join();
+    }
+
+    std::string const& get_port() const
+    {
+        return listener_.port;
+    }
+
+    void set_response(std::string response)
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        response_ = std::move(response);
+    }
+
+    // Close all open connections, as servers do on idle timeouts
+    void drop_connections()
+    {
+        drop_ = true;
+        while (drop_)
+        {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+    }
+
+    std::size_t get_accepted() const
+    {
+        return accepted_;
+    }
+
+    std::size_t get_requests() const
+    {
+        return requests_;
+    }
+
+private:
+    struct Connection
+    {
+        int         fd;      // Accepted socket
+        std::string request; // Incomplete request
+    };
+
+    void run()
+    {
+        auto conns = std::vector<Connection>();
+        while (!stop_)
+        {
+            if (drop_)
+            {
+                for (auto const& conn : conns)
+                {
+                    ::close(conn.fd);
+                }
+                conns.clear();
+                drop_ = false;
+            }
+
+            auto pfds = std::vector<pollfd>{pollfd{listener_.fd, POLLIN, 0}};
+            for (auto const& conn : conns)
+            {
+                pfds.push_back(pollfd{conn.fd, POLLIN, 0});
+            }
+            if (::poll(pfds.data(), pfds.size(), 10) <= 0)
+            {
+                continue;
+            }
+
+            if (pfds[0].revents & POLLIN)
+            {
+                conns.push_back(Connection{::accept(listener_.fd, nullptr, nullptr), std::string()});
+                accepted_ += 1;
+            }
+
+            for (auto i = std::size_t(1); i < pfds.size(); ++i)
+            {
+                if (pfds[i].revents && !serve(conns[i - 1]))
+                {
+                    ::close(conns[i - 1].fd);
+                    conns[i - 1].fd = -1;
+                }
+            }
+            conns.erase( std::remove_if(conns.begin(), conns.end(), [] (Connection const& c) { return c.fd < 0; })
+                       , conns.end());
+        }
+
+        for (auto const& conn : conns)
+        {
+            ::close(conn.fd);
+        }
+    }
+
+    // Returns false once the connection is closed
+    bool serve(Connection& conn)
+    {
+        auto buffer = std::array<char, 1024>();
+        auto n = ::recv(conn.fd, buffer.data(), buffer.size(), 0);
+        if (n <= 0)
+        {
+            return false;
+        }
+
+        conn.request.append(buffer.data(), static_cast<std::size_t>(n));
+        if (conn.request.find("\r\n\r\n") == std::string::npos)
+        {
+            return true;
+        }
+        requests_ += 1;
+
+        auto close = conn.request.find("Connection: close") != std::string::npos;
+        conn.request.clear();
+
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        ::send(conn.fd, response_.data(), response_.size(), MSG_NOSIGNAL);
+        return !close;
+    }
+
+    LoopbackSocket           listener_;
+    std::mutex               mtx_;
+    std::string              response_;
+    std::atomic<bool>        drop_;
+    std::atomic<std::size_t> accepted_;
+    std::atomic<std::size_t> requests_;
+    std::atomic<bool>        stop_;
+    std::thread              thread_;
+};
+
+// Feed a response byte by byte
+HttpResponseParser::Result feed_bytewise(HttpResponseParser& parser, std::string_view data)
+{
+    auto result = HttpResponseParser::Result::INCOMPLETE;
+    for (auto c : data)
+    {
+        result = parser.feed(std::string_view(&c, 1));
+    }
+    return result;
+}
+
+bool probe(Endpoint const& ep, Socket& connection)
+{
+    auto context = host_monitor::ProbeContext();
+    context.connection = &connection;
+    auto probe = host_monitor::make_probe(ep, context);
+    return host_monitor::run_probe(*probe, steady_clock::now() + seconds(1)) == Probe::Status::UP;
+}
+} // anon namespace
+
+TEST(HttpProbeTest, ParseContentLength)
+{
+    auto parser = HttpResponseParser("healthy");
+    auto result = feed_bytewise(parser, "HTTP/1.1 200 OK\r\ncontent-length: 12\r\n\r\nall healthy!");
+    ASSERT_EQ(HttpResponseParser::Result::COMPLETE, result);
+    ASSERT_EQ(200, parser.get_status());
+    ASSERT_TRUE(parser.is_body_matched());
+    ASSERT_TRUE(parser.is_keep_alive());
+}
+
+TEST(HttpProbeTest, ParseChunked)
+{
+    // Searched text spans two chunks
+    auto parser = HttpResponseParser("healthy");
+    auto response = std::string( "HTTP/1.1 503 Unavailable\r\nTransfer-Encoding: chunked\r\n\r\n"
+                                 "5;ext=1\r\nnot h\r\n6\r\nealthy\r\n0\r\nX-Trailer: 1\r\n\r\n");
+    ASSERT_EQ(HttpResponseParser::Result::COMPLETE, feed_bytewise(parser, response));
+    ASSERT_EQ(503, parser.get_status());
+    ASSERT_TRUE(parser.is_body_matched());
+    ASSERT_TRUE(parser.is_keep_alive());
+
+    auto whole = HttpResponseParser("missing");
+    ASSERT_EQ(HttpResponseParser::Result::COMPLETE, whole.feed(response));
+    ASSERT_FALSE(whole.is_body_matched());
+}
+
+TEST(HttpProbeTest, ParseConnectionHandling)
+{
+    // Interim responses are skipped
+    auto interim = HttpResponseParser();
+    ASSERT_EQ( HttpResponseParser::Result::COMPLETE
+             , interim.feed("HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 204 No Content\r\n\r\n"));
+    ASSERT_EQ(204, interim.get_status());
+    ASSERT_TRUE(interim.is_keep_alive());
+
+    auto close = HttpResponseParser();
+    ASSERT_EQ( HttpResponseParser::Result::COMPLETE
+             , close.feed("HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 0\r\n\r\n"));
+    ASSERT_FALSE(close.is_keep_alive());
+
+    // Bodies without length end with the connection
+    auto until_close = HttpResponseParser("ok");
+    ASSERT_EQ(HttpResponseParser::Result::INCOMPLETE, until_close.feed("HTTP/1.0 200 OK\r\n\r\nok"));
+    ASSERT_EQ(HttpResponseParser::Result::COMPLETE, until_close.finish());
+    ASSERT_TRUE(until_close.is_body_matched());
+    ASSERT_FALSE(until_close.is_keep_alive());
+
+    // Trailing data leaves the connection in an unknown state
+    auto trailing = HttpResponseParser();
+    ASSERT_EQ( HttpResponseParser::Result::COMPLETE
+             , trailing.feed("HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\nHTTP"));
+    ASSERT_FALSE(trailing.is_keep_alive());
+}
+
+TEST(HttpProbeTest, ParseInvalid)
+{
+    ASSERT_EQ(HttpResponseParser::Result::INVALID, HttpResponseParser().feed("SSH-2.0-OpenSSH\r\n"));
+    ASSERT_EQ( HttpResponseParser::Result::INVALID
+             , HttpResponseParser().feed("HTTP/1.1 200 OK\r\nContent-Length: x\r\n\r\n"));
+
+    auto truncated = HttpResponseParser();
+    truncated.feed("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nshort");
+    ASSERT_EQ(HttpResponseParser::Result::INVALID, truncated.finish());
+
+    // Header size is bounded
+    auto huge = HttpResponseParser();
+    huge.feed("HTTP/1.1 200 OK\r\nX-Pad: ");
+    ASSERT_EQ( HttpResponseParser::Result::INVALID
+             , huge.feed(std::string(HttpResponseParser::MAX_HEADER, 'a')));
+}
+
+TEST(HttpProbeTest, StatusAndBody)
+{
+    auto server = StubHttp();
+    auto port = server.get_port();
+    ASSERT_TRUE(test_connection(Endpoint::make_http_endpoint("127.0.0.1", port)));
+    ASSERT_TRUE(test_connection(Endpoint::make_http_endpoint("127.0.0.1", port, "/health", 200, "ok")));
+    ASSERT_FALSE(test_connection(Endpoint::make_http_endpoint("127.0.0.1", port, "/health", 200, "fine")));
+    ASSERT_FALSE(test_connection(Endpoint::make_http_endpoint("127.0.0.1", port, "/health", 204)));
+
+    server.set_response("HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n");
+    ASSERT_FALSE(test_connection(Endpoint::make_http_endpoint("127.0.0.1", port)));
+    ASSERT_TRUE(test_connection(Endpoint::make_http_endpoint("127.0.0.1", port, "/", 503)));
+}
+
+TEST(HttpProbeTest, ClosedPort)
+{
+    auto port = LoopbackSocket().port;
+    ASSERT_FALSE(test_connection(Endpoint::make_http_endpoint("127.0.0.1", port)));
+}
+
+TEST(HttpProbeTest, ConnectionIsKeptAlive)
+{
+    auto server = StubHttp();
+    auto ep = Endpoint::make_http_endpoint("127.0.0.1", server.get_port(), "/health", 200, "ok");
+
+    auto connection = Socket();
+    for (auto i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(probe(ep, connection));
+        ASSERT_TRUE(connection.is_valid());
+    }
+    ASSERT_EQ(1u, server.get_accepted());
+    ASSERT_EQ(5u, server.get_requests());
+}
+
+TEST(HttpProbeTest, StaleConnectionIsReplaced)
+{
+    auto server = StubHttp();
+    auto ep = Endpoint::make_http_endpoint("127.0.0.1", server.get_port());
+
+    auto connection = Socket();
+    ASSERT_TRUE(probe(ep, connection));
+    server.drop_connections();
+    ASSERT_TRUE(probe(ep, connection));
+    ASSERT_EQ(2u, server.get_accepted());
+
+    // Responses asking to close the connection aren't reused
+    server.set_response("HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 0\r\n\r\n");
+    ASSERT_TRUE(probe(ep, connection));
+    ASSERT_FALSE(connection.is_valid());
+}
+
+TEST(HttpProbeTest, MonitorKeepsConnectionAlive)
+{
+    auto server = StubHttp();
+    auto ep = Endpoint::make_http_endpoint("127.0.0.1", server.get_port(), "/health");
+
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        auto engine = MonitorEngine(mode, 1);
+        auto accepted = server.get_accepted();
+        {
+            auto mon = HostMonitor(ep, milliseconds(50), engine);
+            std::this_thread::sleep_for(milliseconds(300));
+            ASSERT_TRUE(mon.is_available());
+        }
+        ASSERT_EQ(accepted + 1, server.get_accepted());
+        ASSERT_LE(accepted + 4, server.get_requests());
+    }
+}
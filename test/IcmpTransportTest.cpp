@@ -0,0 +1,96 @@
+/**
+ * @file      IcmpTransportTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <set>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include "IcmpTransport.hpp"
+
+using host_monitor::IcmpTransport;
+using host_monitor::resolve_address;
+using host_monitor::wait_for;
+
+namespace
+{
+// Flush and receive until @p expected replies arrived or a second passed.
+std::set<std::uint64_t> exchange(IcmpTransport& transport, std::size_t expected)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    auto replied = std::vector<std::uint64_t>();
+    auto failed = std::vector<std::uint64_t>();
+
+    transport.flush(failed);
+    while (replied.size() < expected && std::chrono::steady_clock::now() < deadline)
+    {
+        if (wait_for(transport.get_fd(), POLLIN, deadline) & POLLIN)
+        {
+            transport.receive(replied);
+        }
+    }
+    return std::set<std::uint64_t>(replied.begin(), replied.end());
+}
+} // anon namespace
+
+TEST(IcmpTransportTest, BatchToLoopbackV4)
+{
+    auto transport = IcmpTransport(AF_INET);
+    ASSERT_TRUE(transport.is_valid());
+
+    // Submit more requests than fit in one batch
+    auto address = resolve_address("127.0.0.1", AF_INET).value();
+    auto expected = std::set<std::uint64_t>();
+    for (auto token = std::uint64_t(0); token < 500; ++token)
+    {
+        ASSERT_TRUE(transport.submit(address, token));
+        expected.insert(token);
+    }
+
+    ASSERT_EQ(expected, exchange(transport, expected.size()));
+    ASSERT_EQ(0u, transport.get_pending_count());
+}
+
+TEST(IcmpTransportTest, BatchToLoopbackV6)
+{
+    auto transport = IcmpTransport(AF_INET6);
+    ASSERT_TRUE(transport.is_valid());
+
+    auto address = resolve_address("::1", AF_INET6).value();
+    auto expected = std::set<std::uint64_t>();
+    for (auto token = std::uint64_t(0); token < 100; ++token)
+    {
+        ASSERT_TRUE(transport.submit(address, token));
+        expected.insert(token);
+    }
+
+    ASSERT_EQ(expected, exchange(transport, expected.size()));
+    ASSERT_EQ(0u, transport.get_pending_count());
+}
+
+TEST(IcmpTransportTest, CancelledRequestsAreNotReported)
+{
+    auto transport = IcmpTransport(AF_INET);
+    ASSERT_TRUE(transport.is_valid());
+
+    auto address = resolve_address("127.0.0.1", AF_INET).value();
+    auto cancelled = transport.submit(address, 1);
+    auto kept = transport.submit(address, 2);
+    ASSERT_TRUE(cancelled && kept);
+    ASSERT_NE(*cancelled, *kept);
+
+    transport.cancel(*cancelled);
+    ASSERT_EQ(1u, transport.get_pending_count());
+    ASSERT_EQ(std::set<std::uint64_t>({2}), exchange(transport, 2));
+}
@@ -0,0 +1,120 @@
+/**
+ * @file      LatencyHistogramTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "LatencyHistogram.hpp"
+
+using host_monitor::LatencyHistogram;
+using namespace std::chrono;
+
+TEST(LatencyHistogramTest, Empty)
+{
+    auto histogram = LatencyHistogram();
+    ASSERT_EQ(0u, histogram.get_count());
+    ASSERT_EQ(microseconds(0), histogram.get_percentile(50.0));
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    auto histogram = LatencyHistogram();
+    for (auto us = 1; us <= 10; ++us)
+    {
+        histogram.record(microseconds(us));
+    }
+
+    ASSERT_EQ(10u, histogram.get_count());
+    ASSERT_EQ(microseconds(1), histogram.get_percentile(0.0));
+    ASSERT_EQ(microseconds(5), histogram.get_percentile(50.0));
+    ASSERT_EQ(microseconds(10), histogram.get_percentile(100.0));
+}
+
+TEST(LatencyHistogramTest, RelativeErrorIsBounded)
+{
+    for (auto us : {17u, 100u, 999u, 12345u, 250000u, 999999u})
+    {
+        auto histogram = LatencyHistogram();
+        histogram.record(microseconds(us));
+
+        auto value = static_cast<unsigned>(histogram.get_percentile(50.0).count());
+        ASSERT_LE(us, value);
+        ASSERT_LE(value - us, us / 16);
+    }
+
+    // Values out of range end up in the highest bucket
+    auto histogram = LatencyHistogram();
+    histogram.record(hours(1));
+    ASSERT_LT(seconds(16), histogram.get_percentile(100.0));
+}
+
+TEST(LatencyHistogramTest, Percentiles)
+{
+    // 1000 values: 990 at 100us, 9 at 10ms, 1 at 500ms
+    auto histogram = LatencyHistogram();
+    for (auto i = 0; i < 990; ++i)
+    {
+        histogram.record(microseconds(100));
+    }
+    for (auto i = 0; i < 9; ++i)
+    {
+        histogram.record(milliseconds(10));
+    }
+    histogram.record(milliseconds(500));
+
+    ASSERT_NEAR(100, static_cast<double>(histogram.get_percentile(50.0).count()), 100 / 16);
+    ASSERT_NEAR(100, static_cast<double>(histogram.get_percentile(99.0).count()), 100 / 16);
+    ASSERT_NEAR(10000, static_cast<double>(histogram.get_percentile(99.9).count()), 10000 / 16);
+    ASSERT_NEAR(500000, static_cast<double>(histogram.get_percentile(100.0).count()), 500000 / 16);
+}
+
+TEST(LatencyHistogramTest, Merge)
+{
+    auto fast = LatencyHistogram();
+    auto slow = LatencyHistogram();
+    for (auto i = 0; i < 50; ++i)
+    {
+        fast.record(microseconds(10));
+        slow.record(milliseconds(1));
+    }
+
+    auto total = LatencyHistogram();
+    total.merge(fast);
+    total.merge(slow);
+    ASSERT_EQ(100u, total.get_count());
+    ASSERT_EQ(microseconds(10), total.get_percentile(50.0));
+    ASSERT_NEAR(1000, static_cast<double>(total.get_percentile(51.0).count()), 1000 / 16);
+    ASSERT_EQ(50u, fast.get_count());
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecording)
+{
+    auto histogram = LatencyHistogram();
+    auto threads = std::vector<std::thread>();
+    for (auto t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&histogram] ()
+        {
+            for (auto i = 0; i < 100000; ++i)
+            {
+                histogram.record(microseconds(i % 1000));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(400000u, histogram.get_count());
+}
@@ -0,0 +1,84 @@
+/**
+ * @file      LoopbackSocket.hpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#ifndef LOOPBACKSOCKET_HPP_202610161310
+#define LOOPBACKSOCKET_HPP_202610161310
+
+#include <array>
+#include <string>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+/// @brief Socket bound to an ephemeral port on 127.0.0.1.
+struct LoopbackSocket
+{
+    explicit LoopbackSocket(int type = SOCK_STREAM)
+        : fd(::socket(AF_INET, type, 0))
+    {
+        auto addr = sockaddr_in();
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+        auto len = socklen_t(sizeof(addr));
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = std::to_string(ntohs(addr.sin_port));
+    }
+
+    ~LoopbackSocket()
+    {
+        ::close(fd);
+    }
+
+    void listen(int backlog = 16)
+    {
+        ::listen(fd, backlog);
+    }
+
+    LoopbackSocket(LoopbackSocket const& other) = delete;
+    LoopbackSocket& operator = (LoopbackSocket const& other) = delete;
+
+    int         fd;
+    std::string port;
+};
+
+/// @brief Listener on 127.0.0.1 with a full accept queue: connection attempts hang.
+struct BlackholeListener
+{
+    BlackholeListener()
+        : listener()
+        , pending()
+    {
+        listener.listen(0);
+
+        auto addr = sockaddr_in();
+        auto len = socklen_t(sizeof(addr));
+        ::getsockname(listener.fd, reinterpret_cast<sockaddr*>(&addr), &len);
+
+        // Further SYNs are dropped once the queue is full
+        for (auto& sock : pending)
+        {
+            ::fcntl(sock.fd, F_SETFL, O_NONBLOCK);
+            ::connect(sock.fd, reinterpret_cast<sockaddr*>(&addr), len);
+        }
+        ::usleep(50000);
+    }
+
+    LoopbackSocket                listener;
+    std::array<LoopbackSocket, 4> pending;
+};
+
+#endif // LOOPBACKSOCKET_HPP_202610161310
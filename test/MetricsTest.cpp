@@ -0,0 +1,161 @@
+/**
+ * @file      MetricsTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "Metrics.hpp"
+#include "HostMonitorImpl.hpp"
+#include "Socket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::HostMonitorObserver;
+using host_monitor::MetricsServer;
+using host_monitor::render_metrics;
+using namespace std::chrono;
+
+namespace
+{
+// Value of sample @p sample in the rendered metrics, -1 if missing
+double get_sample(std::string const& sample)
+{
+    auto text = std::string();
+    render_metrics(text);
+
+    auto pos = text.find("\n" + sample + " ");
+    if (pos == std::string::npos)
+    {
+        return -1.0;
+    }
+    return std::stod(text.substr(pos + sample.size() + 2));
+}
+
+struct NullObserver : public HostMonitorObserver
+{
+    void state_change(Data const&) override
+    {
+    }
+};
+
+// Send @p request to 127.0.0.1:@p port, returns the complete response
+std::string http_request(std::uint16_t port, std::string const& request)
+{
+    auto address = host_monitor::resolve_address("127.0.0.1", AF_INET).value();
+    address.set_port(port);
+    auto sock = host_monitor::Socket(::socket(AF_INET, SOCK_STREAM, 0));
+    if (::connect(sock.get(), address.get(), address.length) != 0)
+    {
+        return std::string();
+    }
+    ::send(sock.get(), request.data(), request.size(), MSG_NOSIGNAL);
+
+    auto response = std::string();
+    auto buffer = std::array<char, 4096>();
+    auto n = ssize_t(0);
+    while ((n = ::recv(sock.get(), buffer.data(), buffer.size(), 0)) > 0)
+    {
+        response.append(buffer.data(), static_cast<std::size_t>(n));
+    }
+    return response;
+}
+} // anon namespace
+
+TEST(MetricsTest, ReportsAreCounted)
+{
+    auto const probes = std::string("host_monitor_probes_total{protocol=\"TCP\"}");
+    auto const failures = std::string("host_monitor_probe_failures_total{protocol=\"TCP\"}");
+    auto const fast = std::string("host_monitor_probe_duration_seconds_bucket{protocol=\"TCP\",le=\"0.0001\"}");
+    auto const slow = std::string("host_monitor_probe_duration_seconds_bucket{protocol=\"TCP\",le=\"0.0025\"}");
+    auto const ups = std::string("host_monitor_state_changes_total{state=\"up\"}");
+    auto const calls = std::string("host_monitor_observer_callback_seconds_count");
+
+    auto probes_before = get_sample(probes);
+    auto failures_before = get_sample(failures);
+    auto fast_before = get_sample(fast);
+    auto slow_before = get_sample(slow);
+    auto ups_before = get_sample(ups);
+    auto calls_before = get_sample(calls);
+
+    auto monitor = std::make_shared<HostMonitor::Impl>( Endpoint::make_tcp_endpoint("127.0.0.1", "1")
+                                                      , HostMonitor::Schedule::fixed(seconds(1)));
+    monitor->add_observer(std::make_shared<NullObserver>());
+    monitor->report(true, microseconds(50));
+    monitor->report(true, milliseconds(2));
+    monitor->report(false, milliseconds(2));
+
+    ASSERT_EQ(probes_before + 3, get_sample(probes));
+    ASSERT_EQ(failures_before + 1, get_sample(failures));
+    ASSERT_EQ(fast_before + 1, get_sample(fast));
+    ASSERT_EQ(slow_before + 3, get_sample(slow));
+    ASSERT_EQ(ups_before + 1, get_sample(ups));
+    ASSERT_EQ(calls_before + 2, get_sample(calls));
+}
+
+TEST(MetricsTest, CountsOfExitedThreadsAreKept)
+{
+    auto const probes = std::string("host_monitor_probes_total{protocol=\"ICMPV6\"}");
+    auto before = get_sample(probes);
+
+    auto monitor = std::make_shared<HostMonitor::Impl>( Endpoint::make_icmpv6_endpoint("::1")
+                                                      , HostMonitor::Schedule::fixed(seconds(1)));
+    auto thread = std::thread([&monitor]
+    {
+        for (auto i = 0; i < 10; ++i)
+        {
+            monitor->report(true, microseconds(10));
+        }
+    });
+    thread.join();
+
+    ASSERT_EQ(before + 10, get_sample(probes));
+}
+
+TEST(MetricsTest, Server)
+{
+    auto server = MetricsServer("127.0.0.1", 0);
+    ASSERT_NE(0, server.get_port());
+
+    auto response = http_request(server.get_port(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    ASSERT_EQ(0u, response.find("HTTP/1.1 200 OK\r\n"));
+    ASSERT_NE(std::string::npos, response.find("# TYPE host_monitor_probes_total counter"));
+
+    response = http_request(server.get_port(), "GET / HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(0u, response.find("HTTP/1.1 404 Not Found\r\n"));
+
+    ASSERT_THROW(MetricsServer("not an address", 0), std::runtime_error);
+
+    // Host names are not resolved
+    ASSERT_THROW(MetricsServer("localhost", 0), std::runtime_error);
+    ASSERT_NO_THROW(MetricsServer("::1", 0));
+}
+
+TEST(MetricsTest, ShutdownDoesntWaitForIdleClients)
+{
+    auto server = std::make_unique<MetricsServer>("127.0.0.1", 0);
+    auto address = host_monitor::resolve_address("127.0.0.1", AF_INET).value();
+    address.set_port(server->get_port());
+
+    // The client connects but never sends a request
+    auto sock = host_monitor::Socket(::socket(AF_INET, SOCK_STREAM, 0));
+    ASSERT_EQ(0, ::connect(sock.get(), address.get(), address.length));
+    std::this_thread::sleep_for(milliseconds(100));
+
+    auto start = steady_clock::now();
+    server.reset();
+    ASSERT_GT(milliseconds(500), steady_clock::now() - start);
+}
@@ -0,0 +1,167 @@
+/**
+ * @file      MonitorEngineTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <gtest/gtest.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+
+TEST(MonitorEngineTest, Configuration)
+{
+    auto loop_engine = MonitorEngine(2);
+    ASSERT_EQ(MonitorEngine::Mode::EVENT_LOOP, loop_engine.get_mode());
+    ASSERT_EQ(2u, loop_engine.get_thread_count());
+    ASSERT_EQ(MonitorEngine::Backend::EPOLL, loop_engine.get_backend());
+
+    auto thread_engine = MonitorEngine(MonitorEngine::Mode::THREAD_PER_MONITOR, 0);
+    ASSERT_EQ(MonitorEngine::Mode::THREAD_PER_MONITOR, thread_engine.get_mode());
+    ASSERT_EQ(0u, thread_engine.get_thread_count());
+
+    ASSERT_THROW(MonitorEngine(0), std::runtime_error);
+}
+
+TEST(MonitorEngineTest, EventLoopManyMonitors)
+{
+    // Create Monitors, sharing two threads.
+    auto engine = MonitorEngine(2);
+    auto mons = std::vector<std::unique_ptr<HostMonitor>>();
+    for (auto i = 0; i < 100; ++i)
+    {
+        auto ep = Endpoint::make_icmpv4_endpoint("127.0.0.1");
+        mons.push_back(std::make_unique<HostMonitor>(ep, std::chrono::seconds(1), engine));
+    }
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    for (auto const& mon : mons)
+    {
+        ASSERT_TRUE(mon->is_available());
+    }
+}
+
+TEST(MonitorEngineTest, ThreadPerMonitorToLoopback)
+{
+    // Create Monitor.
+    auto engine = MonitorEngine(MonitorEngine::Mode::THREAD_PER_MONITOR, 0);
+    auto ep = Endpoint::make_icmpv4_endpoint("127.0.0.1");
+    auto mon = HostMonitor(ep, std::chrono::seconds(1), engine);
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ASSERT_TRUE(mon.is_available());
+}
+
+// Observer destroying the monitor it is registered on.
+struct DestroyingObserver : public host_monitor::HostMonitorObserver
+{
+    virtual void state_change(Data const&) override
+    {
+        monitor.reset();
+        calls += 1;
+    }
+
+    std::unique_ptr<HostMonitor> monitor;
+    std::atomic<int>             calls = 0;
+};
+
+TEST(MonitorEngineTest, DestroyFromObserver)
+{
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        // Create Monitor. Start listening after the observer was added.
+        auto engine = MonitorEngine(mode, 1);
+        auto listener = LoopbackSocket();
+        auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+        auto obs = std::make_shared<DestroyingObserver>();
+        obs->monitor = std::make_unique<HostMonitor>(ep, std::chrono::seconds(1), engine);
+        obs->monitor->add_observer(obs);
+        listener.listen();
+
+        // Wait for target to respond
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+
+        ASSERT_EQ(1, obs->calls);
+        ASSERT_FALSE(obs->monitor);
+    }
+}
+
+TEST(MonitorEngineTest, DestroyDuringProbe)
+{
+    auto blackhole = BlackholeListener();
+    auto schedule = HostMonitor::Schedule::fixed(std::chrono::seconds(1));
+    schedule.timeout = std::chrono::seconds(30);
+
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        // Create Monitors, their first tests hang until the deadline.
+        auto engine = MonitorEngine(mode, 1);
+        auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", blackhole.listener.port);
+        auto mons = std::vector<std::unique_ptr<HostMonitor>>();
+        for (auto i = 0; i < 50; ++i)
+        {
+            mons.push_back(std::make_unique<HostMonitor>(ep, schedule, engine));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        // In-flight tests are cancelled instead of awaited
+        auto start = std::chrono::steady_clock::now();
+        mons.clear();
+        ASSERT_GT(std::chrono::milliseconds(100), std::chrono::steady_clock::now() - start);
+    }
+}
+
+// Observer blocking the reporting thread on its first call.
+struct BlockingObserver : public host_monitor::HostMonitorObserver
+{
+    virtual void state_change(Data const&) override
+    {
+        if (calls++ == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+
+    std::atomic<int> calls = 0;
+};
+
+TEST(MonitorEngineTest, DestroyWhileLoopIsBusy)
+{
+    // Create Monitors on one loop. The observer of the first one blocks the loop.
+    auto engine = MonitorEngine(1);
+    auto listener = LoopbackSocket();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+    auto obs = std::make_shared<BlockingObserver>();
+    auto busy = HostMonitor(ep, std::chrono::seconds(10), engine);
+    auto other = std::make_unique<HostMonitor>(ep, std::chrono::seconds(10), engine);
+    busy.add_observer(obs);
+    listener.listen();
+    while (obs->calls == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Removal doesn't wait for the loop
+    auto start = std::chrono::steady_clock::now();
+    other.reset();
+    ASSERT_GT(std::chrono::milliseconds(100), std::chrono::steady_clock::now() - start);
+}
@@ -0,0 +1,208 @@
+/**
+ * @file      MonitorSetTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+#include <gtest/gtest.h>
+#include "MonitorSet.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitorObserver;
+using host_monitor::MonitorEngine;
+using host_monitor::MonitorSet;
+
+namespace
+{
+class CountingObserver : public HostMonitorObserver
+{
+public:
+    void state_change(Data const&) override
+    {
+        changes += 1;
+    }
+
+    std::atomic<int> changes = 0;
+};
+} // anon namespace
+
+TEST(MonitorSetTest, Load)
+{
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+
+    auto changes = set.load( "# Endpoints\n"
+                             "ICMPV4 127.0.0.1 1s\n"
+                             "\n"
+                             "TCP    localhost 8080 500   # in ms\n"
+                             "ICMPV6 ::1 2m\r\n"
+                             "UDP 127.0.0.1 53 1s 0102 01\n"
+                             "HTTP 127.0.0.1 8080 1s /health 204 ok\n"
+                             "HTTP 127.0.0.1 8081 1s\n"
+                             "TCP_PERSISTENT 127.0.0.1 22 10s\n");
+    ASSERT_EQ(7u, changes.started);
+    ASSERT_EQ(0u, changes.stopped);
+    ASSERT_EQ(0u, changes.unchanged);
+    ASSERT_EQ(7u, set.size());
+
+    auto const* tcp = set.find(Endpoint::make_tcp_endpoint("localhost", "8080"));
+    ASSERT_NE(nullptr, tcp);
+    ASSERT_EQ(std::chrono::milliseconds(500), tcp->get_interval());
+    ASSERT_EQ( std::chrono::minutes(2)
+             , set.find(Endpoint::make_icmpv6_endpoint("::1"))->get_interval());
+    ASSERT_EQ(nullptr, set.find(Endpoint::make_tcp_endpoint("localhost", "8081")));
+    ASSERT_NE(nullptr, set.find(Endpoint::make_udp_endpoint("127.0.0.1", "53", "\x01\x02", "\x01")));
+    ASSERT_NE(nullptr, set.find(Endpoint::make_http_endpoint("127.0.0.1", "8080", "/health", 204, "ok")));
+    ASSERT_NE(nullptr, set.find(Endpoint::make_http_endpoint("127.0.0.1", "8081")));
+    ASSERT_NE(nullptr, set.find(Endpoint::make_tcp_persistent_endpoint("127.0.0.1", "22")));
+}
+
+TEST(MonitorSetTest, ReloadTouchesChangedMonitorsOnly)
+{
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+    set.load( "ICMPV4 127.0.0.1 1s\n"
+              "TCP 127.0.0.1 1 1s\n"
+              "TCP 127.0.0.1 2 1s\n");
+
+    auto const* kept = set.find(Endpoint::make_icmpv4_endpoint("127.0.0.1"));
+    auto changes = set.load( "ICMPV4 127.0.0.1 1000ms\n"
+                             "TCP 127.0.0.1 2 2s\n"
+                             "TCP 127.0.0.1 3 1s\n");
+    ASSERT_EQ(2u, changes.started);
+    ASSERT_EQ(2u, changes.stopped);
+    ASSERT_EQ(1u, changes.unchanged);
+    ASSERT_EQ(3u, set.size());
+
+    ASSERT_EQ(kept, set.find(Endpoint::make_icmpv4_endpoint("127.0.0.1")));
+    ASSERT_EQ(nullptr, set.find(Endpoint::make_tcp_endpoint("127.0.0.1", "1")));
+    ASSERT_EQ( std::chrono::seconds(2)
+             , set.find(Endpoint::make_tcp_endpoint("127.0.0.1", "2"))->get_interval());
+}
+
+TEST(MonitorSetTest, LastDuplicateWins)
+{
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+
+    auto changes = set.load( "TCP 127.0.0.1 1 1s\n"
+                             "TCP 127.0.0.1 1 3s\n");
+    ASSERT_EQ(1u, changes.started);
+    ASSERT_EQ(1u, set.size());
+    ASSERT_EQ( std::chrono::seconds(3)
+             , set.find(Endpoint::make_tcp_endpoint("127.0.0.1", "1"))->get_interval());
+}
+
+TEST(MonitorSetTest, InvalidListIsRejected)
+{
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+    set.load("ICMPV4 127.0.0.1 1s\n");
+
+    ASSERT_THROW(set.load("ICMPV4 127.0.0.2 1s\nSCTP 127.0.0.1 53 1s\n"), std::runtime_error);
+    ASSERT_THROW(set.load("TCP 127.0.0.1 1s\n"), std::runtime_error);
+    ASSERT_THROW(set.load("TCP 127.0.0.1 http 1s\n"), std::runtime_error);
+    ASSERT_THROW(set.load("ICMPV4 127.0.0.1 1h\n"), std::runtime_error);
+    ASSERT_THROW(set.load("ICMPV4 127.0.0.1 0\n"), std::runtime_error);
+    ASSERT_THROW(set.load("ICMPV4 127.0.0.1 1s 1s\n"), std::runtime_error);
+    ASSERT_THROW(set.load("UDP 127.0.0.1 53 1s 0g\n"), std::runtime_error);
+    ASSERT_THROW(set.load("UDP 127.0.0.1 53 1s 01 02 03\n"), std::runtime_error);
+    ASSERT_THROW(set.load("HTTP 127.0.0.1 80 1s health\n"), std::runtime_error);
+    ASSERT_THROW(set.load("HTTP 127.0.0.1 80 1s / OK\n"), std::runtime_error);
+    ASSERT_THROW(set.load_file("/nonexistent/endpoints"), std::runtime_error);
+    ASSERT_THROW(set.load_file(::testing::TempDir()), std::runtime_error);
+
+    // Running monitors are untouched
+    ASSERT_EQ(1u, set.size());
+    ASSERT_NE(nullptr, set.find(Endpoint::make_icmpv4_endpoint("127.0.0.1")));
+}
+
+TEST(MonitorSetTest, LoadFile)
+{
+    auto path = std::string(::testing::TempDir()) + "MonitorSetTest.endpoints";
+    {
+        auto file = std::ofstream(path);
+        for (auto port = 1; port <= 1000; ++port)
+        {
+            file << "TCP 127.0.0.1 " << port << " 1m\n";
+        }
+    }
+
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+    ASSERT_EQ(1000u, set.load_file(path).started);
+
+    auto changes = set.load_file(path);
+    ASSERT_EQ(0u, changes.started);
+    ASSERT_EQ(0u, changes.stopped);
+    ASSERT_EQ(1000u, changes.unchanged);
+    std::remove(path.c_str());
+}
+
+TEST(MonitorSetTest, LoadFifo)
+{
+    // FIFOs have no size, the list is read until the writer closes it
+    auto path = std::string(::testing::TempDir()) + "MonitorSetTest.fifo";
+    std::remove(path.c_str());
+    ASSERT_EQ(0, ::mkfifo(path.c_str(), 0600));
+    auto writer = std::thread([&path] ()
+    {
+        auto file = std::ofstream(path);
+        file << "ICMPV4 127.0.0.1 1m\nICMPV4 127.0.0.2 1m\n";
+    });
+
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+    auto changes = set.load_file(path);
+    writer.join();
+    std::remove(path.c_str());
+    ASSERT_EQ(2u, changes.started);
+}
+
+TEST(MonitorSetTest, ObserversFollowTheSet)
+{
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+    auto observer = std::make_shared<CountingObserver>();
+
+    set.add_observer(observer);
+    set.load("ICMPV4 127.0.0.1 100\n");
+    set.load("ICMPV4 127.0.0.1 100\nICMPV4 localhost 100\n");
+
+    // Both loopback monitors come up
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    ASSERT_EQ(2, observer->changes);
+}
+
+TEST(MonitorSetTest, ErrorsNameTheParser)
+{
+    auto engine = MonitorEngine(1);
+    auto set = MonitorSet(engine);
+    try
+    {
+        set.load("SCTP 127.0.0.1 53 1s\n");
+        FAIL();
+    }
+    catch (std::runtime_error const& e)
+    {
+        auto what = std::string(e.what());
+        ASSERT_NE(std::string::npos, what.find("parse_line("));
+        ASSERT_EQ(std::string::npos, what.find("lambda"));
+        ASSERT_NE(std::string::npos, what.find("line 1: unknown protocol"));
+    }
+}
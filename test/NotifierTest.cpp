@@ -0,0 +1,163 @@
+/**
+ * @file      NotifierTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Notifier.hpp"
+#include "HostMonitorImpl.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::Notifier;
+using namespace std::chrono;
+
+namespace
+{
+// Observer blocking in its first call until it is released.
+struct GatedObserver : public host_monitor::HostMonitorObserver
+{
+    virtual void state_change(Data const& data) override
+    {
+        entered = true;
+        while (!released)
+        {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+
+        auto lock = std::lock_guard<std::mutex>(mtx);
+        received.push_back(data.available);
+    }
+
+    std::vector<bool> get_received()
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx);
+        return received;
+    }
+
+    std::atomic<bool> entered{false};
+    std::atomic<bool> released{false};
+    std::mutex        mtx;
+    std::vector<bool> received;
+};
+
+std::shared_ptr<HostMonitor::Impl> make_monitor()
+{
+    return std::make_shared<HostMonitor::Impl>( Endpoint::make_icmpv4_endpoint("127.0.0.1")
+                                              , HostMonitor::Schedule::fixed(seconds(1)));
+}
+
+// Report alternating results, each one is a state change.
+void report_changes(HostMonitor::Impl& monitor, std::size_t count)
+{
+    for (auto i = std::size_t(0); i < count; ++i)
+    {
+        monitor.report(i % 2 == 0, milliseconds(1));
+    }
+}
+
+void wait_for_delivery(Notifier::Impl const& notifier, std::shared_ptr<GatedObserver> const& obs)
+{
+    auto deadline = steady_clock::now() + seconds(2);
+    while (notifier.get_statistics(obs).queued > 0 && steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+}
+} // anon namespace
+
+TEST(NotifierTest, SlowObserverDoesNotDelayReporting)
+{
+    auto notifier = Notifier::Impl(64, Notifier::OverflowPolicy::BLOCK);
+    auto monitor = make_monitor();
+    auto obs = std::make_shared<GatedObserver>();
+    monitor->add_observer(obs, &notifier);
+
+    // The observer blocks, reporting goes on
+    auto start = steady_clock::now();
+    report_changes(*monitor, 10);
+    ASSERT_LT(steady_clock::now() - start, milliseconds(100));
+    ASSERT_EQ(10u, notifier.get_statistics(obs).queued);
+
+    obs->released = true;
+    wait_for_delivery(notifier, obs);
+
+    auto stats = notifier.get_statistics(obs);
+    ASSERT_EQ(10u, stats.delivered);
+    ASSERT_EQ(0u, stats.dropped);
+    ASSERT_EQ((std::vector<bool>{true, false, true, false, true, false, true, false, true, false}),
+              obs->get_received());
+}
+
+TEST(NotifierTest, OverflowDropsNewest)
+{
+    auto notifier = Notifier::Impl(2, Notifier::OverflowPolicy::DROP_NEWEST);
+    auto monitor = make_monitor();
+    auto obs = std::make_shared<GatedObserver>();
+    monitor->add_observer(obs, &notifier);
+
+    // First change occupies the notifier thread, two fit in the queue
+    monitor->report(true, milliseconds(1));
+    while (!obs->entered)
+    {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    monitor->report(false, milliseconds(1));
+    report_changes(*monitor, 9);
+
+    auto stats = notifier.get_statistics(obs);
+    ASSERT_EQ(3u, stats.queued);
+    ASSERT_EQ(8u, stats.dropped);
+
+    obs->released = true;
+    wait_for_delivery(notifier, obs);
+    ASSERT_EQ(3u, notifier.get_statistics(obs).delivered);
+    ASSERT_EQ((std::vector<bool>{true, false, true}), obs->get_received());
+}
+
+TEST(NotifierTest, OverflowDropsOldest)
+{
+    auto notifier = Notifier::Impl(2, Notifier::OverflowPolicy::DROP_OLDEST);
+    auto monitor = make_monitor();
+    auto obs = std::make_shared<GatedObserver>();
+    monitor->add_observer(obs, &notifier);
+
+    monitor->report(true, milliseconds(1));
+    while (!obs->entered)
+    {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    monitor->report(false, milliseconds(1));
+    report_changes(*monitor, 9);
+
+    auto stats = notifier.get_statistics(obs);
+    ASSERT_EQ(3u, stats.queued);
+    ASSERT_EQ(8u, stats.dropped);
+
+    // The latest state changes survived
+    obs->released = true;
+    wait_for_delivery(notifier, obs);
+    ASSERT_EQ((std::vector<bool>{true, false, true}), obs->get_received());
+}
+
+TEST(NotifierTest, UnknownObserver)
+{
+    auto notifier = Notifier::Impl(2, Notifier::OverflowPolicy::DROP_NEWEST);
+    auto stats = notifier.get_statistics(std::make_shared<GatedObserver>());
+    ASSERT_EQ(0u, stats.queued);
+    ASSERT_EQ(0u, stats.delivered);
+    ASSERT_EQ(0u, stats.dropped);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file      PersistentTcpProbeTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "PersistentTcpProbe.hpp"
+#include "TestConnection.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::ConnectionHealth;
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using host_monitor::Probe;
+using host_monitor::Socket;
+using namespace std::chrono;
+
+namespace
+{
+// Accept all pending connections
+std::vector<Socket> accept_pending(LoopbackSocket const& listener)
+{
+    auto accepted = std::vector<Socket>();
+    auto pfd = pollfd{listener.fd, POLLIN, 0};
+    while (::poll(&pfd, 1, 50) > 0)
+    {
+        accepted.emplace_back(::accept(listener.fd, nullptr, nullptr));
+    }
+    return accepted;
+}
+
+bool probe(Endpoint const& ep, Socket& connection)
+{
+    auto context = host_monitor::ProbeContext();
+    context.connection = &connection;
+    auto probe = host_monitor::make_probe(ep, context);
+    return host_monitor::run_probe(*probe, steady_clock::now() + seconds(1)) == Probe::Status::UP;
+}
+
+bool wait_until(std::function<bool()> pred, milliseconds timeout)
+{
+    auto deadline = steady_clock::now() + timeout;
+    while (!pred() && steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(milliseconds(5));
+    }
+    return pred();
+}
+} // anon namespace
+
+TEST(PersistentTcpProbeTest, ConnectionIsReused)
+{
+    auto listener = LoopbackSocket();
+    listener.listen();
+    auto ep = Endpoint::make_tcp_persistent_endpoint("127.0.0.1", listener.port);
+
+    auto connection = Socket();
+    for (auto i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(probe(ep, connection));
+    }
+    auto peers = accept_pending(listener);
+    ASSERT_EQ(1u, peers.size());
+    ASSERT_EQ(ConnectionHealth::ALIVE, host_monitor::check_connection(connection));
+}
+
+TEST(PersistentTcpProbeTest, BannerIsDiscarded)
+{
+    auto listener = LoopbackSocket();
+    listener.listen();
+    auto ep = Endpoint::make_tcp_persistent_endpoint("127.0.0.1", listener.port);
+
+    auto connection = Socket();
+    ASSERT_TRUE(probe(ep, connection));
+    auto peers = accept_pending(listener);
+    ASSERT_EQ(1u, peers.size());
+
+    ::send(peers.front().get(), "SSH-2.0-Test\r\n", 14, 0);
+    std::this_thread::sleep_for(milliseconds(10));
+    ASSERT_EQ(ConnectionHealth::ALIVE, host_monitor::check_connection(connection));
+    ASSERT_TRUE(probe(ep, connection));
+    ASSERT_TRUE(accept_pending(listener).empty());
+}
+
+TEST(PersistentTcpProbeTest, ClosedConnectionIsReplaced)
+{
+    auto listener = std::make_unique<LoopbackSocket>();
+    listener->listen();
+    auto ep = Endpoint::make_tcp_persistent_endpoint("127.0.0.1", listener->port);
+
+    auto connection = Socket();
+    ASSERT_TRUE(probe(ep, connection));
+    accept_pending(*listener).clear();
+    std::this_thread::sleep_for(milliseconds(10));
+    ASSERT_EQ(ConnectionHealth::DEAD, host_monitor::check_connection(connection));
+
+    // Peer is still listening: reconnect
+    ASSERT_TRUE(probe(ep, connection));
+    auto peers = accept_pending(*listener);
+    ASSERT_EQ(1u, peers.size());
+
+    // Peer is gone: fail
+    peers.clear();
+    listener.reset();
+    std::this_thread::sleep_for(milliseconds(10));
+    ASSERT_FALSE(probe(ep, connection));
+}
+
+TEST(PersistentTcpProbeTest, HangUpIsDetectedBeforeInterval)
+{
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        auto listener = std::make_unique<LoopbackSocket>();
+        listener->listen();
+        auto ep = Endpoint::make_tcp_persistent_endpoint("127.0.0.1", listener->port);
+
+        auto engine = MonitorEngine(mode, 1);
+        auto mon = HostMonitor(ep, seconds(30), engine);
+        ASSERT_TRUE(wait_until([&mon] () { return mon.is_available(); }, milliseconds(1000)));
+
+        // Loss of the connection is reported without waiting for the next interval
+        auto peers = accept_pending(*listener);
+        ASSERT_EQ(1u, peers.size());
+        listener.reset();
+        peers.clear();
+        ASSERT_TRUE(wait_until([&mon] () { return !mon.is_available(); }, milliseconds(500)));
+    }
+}
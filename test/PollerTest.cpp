@@ -0,0 +1,231 @@
+/**
+ * @file      PollerTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "Poller.hpp"
+#include "UringPoller.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using host_monitor::PollEvent;
+using host_monitor::Poller;
+using host_monitor::Socket;
+using host_monitor::UringPoller;
+using namespace std::chrono;
+
+namespace
+{
+auto const BACKENDS = {MonitorEngine::Backend::EPOLL, MonitorEngine::Backend::IO_URING};
+
+void notify(Socket const& efd)
+{
+    auto val = std::uint64_t(1);
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(val)), ::write(efd.get(), &val, sizeof(val)));
+}
+} // anon namespace
+
+TEST(PollerTest, Fallback)
+{
+    // An empty ring is rejected by the kernel
+    auto uring = UringPoller(0);
+    ASSERT_FALSE(uring.is_valid());
+
+    ASSERT_EQ(MonitorEngine::Backend::EPOLL, Poller::create(MonitorEngine::Backend::EPOLL)->get_backend());
+    ASSERT_NO_THROW(Poller::create(MonitorEngine::Backend::IO_URING));
+}
+
+TEST(PollerTest, LevelTriggered)
+{
+    for (auto backend : BACKENDS)
+    {
+        auto poller = Poller::create(backend);
+        auto efd = Socket(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        auto events = std::array<PollEvent, 4>();
+
+        ASSERT_TRUE(poller->add(efd.get(), EPOLLIN, 42));
+        ASSERT_FALSE(poller->add(efd.get(), EPOLLIN, 42));
+        ASSERT_EQ(0u, poller->wait(events.data(), events.size(), 10));
+
+        // Readiness is reported until it is consumed
+        notify(efd);
+        for (auto i = 0; i < 3; ++i)
+        {
+            ASSERT_EQ(1u, poller->wait(events.data(), events.size(), 1000));
+            ASSERT_EQ(42u, events[0].id);
+            ASSERT_TRUE(events[0].events & EPOLLIN);
+        }
+
+        auto val = std::uint64_t();
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(val)), ::read(efd.get(), &val, sizeof(val)));
+        ASSERT_EQ(0u, poller->wait(events.data(), events.size(), 10));
+    }
+}
+
+TEST(PollerTest, ModifyAndRemove)
+{
+    for (auto backend : BACKENDS)
+    {
+        auto poller = Poller::create(backend);
+        auto efd = Socket(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        auto events = std::array<PollEvent, 4>();
+
+        ASSERT_FALSE(poller->modify(efd.get(), EPOLLOUT, 1));
+        ASSERT_TRUE(poller->add(efd.get(), EPOLLIN, 1));
+        ASSERT_EQ(0u, poller->wait(events.data(), events.size(), 10));
+
+        // An eventfd is always writable
+        ASSERT_TRUE(poller->modify(efd.get(), EPOLLOUT, 2));
+        ASSERT_EQ(1u, poller->wait(events.data(), events.size(), 1000));
+        ASSERT_EQ(2u, events[0].id);
+        ASSERT_TRUE(events[0].events & EPOLLOUT);
+
+        // Pending events are discarded on removal
+        poller->remove(efd.get());
+        ASSERT_EQ(0u, poller->wait(events.data(), events.size(), 10));
+
+        ASSERT_TRUE(poller->add(efd.get(), EPOLLOUT, 3));
+        ASSERT_EQ(1u, poller->wait(events.data(), events.size(), 1000));
+        ASSERT_EQ(3u, events[0].id);
+    }
+}
+
+TEST(PollerTest, Timeout)
+{
+    for (auto backend : BACKENDS)
+    {
+        auto poller = Poller::create(backend);
+        auto efd = Socket(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        auto events = std::array<PollEvent, 4>();
+        ASSERT_TRUE(poller->add(efd.get(), EPOLLIN, 1));
+
+        // Waits end at the timeout. Closing a ring interrupts the next system
+        // call of its thread once, that wait may return early.
+        auto start = steady_clock::now();
+        auto calls = 0;
+        while (steady_clock::now() - start < milliseconds(50))
+        {
+            ASSERT_EQ(0u, poller->wait(events.data(), events.size(), 50));
+            calls += 1;
+        }
+        ASSERT_GE(3, calls);
+
+        // A signal from another thread ends the wait early
+        auto writer = std::thread([&efd] ()
+        {
+            std::this_thread::sleep_for(milliseconds(20));
+            notify(efd);
+        });
+        start = steady_clock::now();
+        ASSERT_EQ(1u, poller->wait(events.data(), events.size(), 5000));
+        ASSERT_GT(seconds(1), steady_clock::now() - start);
+        writer.join();
+    }
+}
+
+TEST(PollerTest, ManyDescriptors)
+{
+    for (auto backend : BACKENDS)
+    {
+        auto poller = Poller::create(backend);
+        auto fds = std::vector<Socket>();
+        for (auto i = 0; i < 300; ++i)
+        {
+            fds.emplace_back(::eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC));
+            ASSERT_TRUE(poller->add(fds.back().get(), EPOLLIN, static_cast<std::uint64_t>(i)));
+        }
+
+        // Events exceeding the capacity are returned by the next call
+        auto events = std::array<PollEvent, 64>();
+        auto seen = std::vector<bool>(fds.size(), false);
+        auto deadline = steady_clock::now() + seconds(5);
+        while (std::find(seen.begin(), seen.end(), false) != seen.end() && steady_clock::now() < deadline)
+        {
+            auto n = poller->wait(events.data(), events.size(), 100);
+            ASSERT_GE(events.size(), n);
+            for (auto i = std::size_t(0); i < n; ++i)
+            {
+                seen.at(events[i].id) = true;
+            }
+        }
+        ASSERT_EQ(seen.end(), std::find(seen.begin(), seen.end(), false));
+
+        for (auto const& fd : fds)
+        {
+            poller->remove(fd.get());
+        }
+        ASSERT_EQ(0u, poller->wait(events.data(), events.size(), 10));
+    }
+}
+
+TEST(PollerTest, SmallRing)
+{
+    // Each wait re-arms more requests than the submission ring holds
+    auto uring = UringPoller(2);
+    ASSERT_TRUE(uring.is_valid());
+
+    auto fds = std::vector<Socket>();
+    for (auto i = 0; i < 32; ++i)
+    {
+        fds.emplace_back(::eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC));
+        ASSERT_TRUE(uring.add(fds.back().get(), EPOLLIN, static_cast<std::uint64_t>(i)));
+    }
+
+    // Level-triggered: no re-arm gets lost, each descriptor keeps being reported
+    auto events = std::array<PollEvent, 64>();
+    auto seen = std::vector<int>(fds.size(), 0);
+    auto deadline = steady_clock::now() + seconds(5);
+    while (*std::min_element(seen.begin(), seen.end()) < 3 && steady_clock::now() < deadline)
+    {
+        auto n = uring.wait(events.data(), events.size(), 100);
+        for (auto i = std::size_t(0); i < n; ++i)
+        {
+            seen.at(events[i].id) += 1;
+        }
+    }
+    ASSERT_LE(3, *std::min_element(seen.begin(), seen.end()));
+}
+
+TEST(PollerTest, EngineToLoopback)
+{
+    auto listener = LoopbackSocket();
+    listener.listen(128);
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+
+    auto engine = MonitorEngine(2, MonitorEngine::Backend::IO_URING);
+    auto mons = std::vector<std::unique_ptr<HostMonitor>>();
+    for (auto i = 0; i < 20; ++i)
+    {
+        mons.push_back(std::make_unique<HostMonitor>(ep, seconds(1), engine));
+    }
+
+    // Wait for target to respond
+    std::this_thread::sleep_for(milliseconds(500));
+
+    for (auto const& mon : mons)
+    {
+        ASSERT_TRUE(mon->is_available());
+    }
+    ASSERT_EQ(2u, engine.get_thread_count());
+}
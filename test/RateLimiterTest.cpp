@@ -0,0 +1,184 @@
+/**
+ * @file      RateLimiterTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "RateLimiter.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using host_monitor::RateLimiter;
+using namespace std::chrono;
+
+namespace
+{
+auto const TCP = Endpoint::Protocol::TCP;
+auto const HIGH = HostMonitor::Priority::HIGH;
+auto const NORMAL = HostMonitor::Priority::NORMAL;
+auto const LOW = HostMonitor::Priority::LOW;
+
+std::size_t count_available(std::vector<std::unique_ptr<HostMonitor>> const& mons)
+{
+    return static_cast<std::size_t>(std::count_if(mons.begin(), mons.end(), [] (auto const& mon)
+    {
+        return mon->is_available();
+    }));
+}
+} // anon namespace
+
+TEST(RateLimiterTest, Unlimited)
+{
+    auto limiter = RateLimiter();
+    auto now = RateLimiter::Clock::now();
+    for (auto i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(now, limiter.reserve(TCP, NORMAL, now));
+    }
+}
+
+TEST(RateLimiterTest, BurstThenSpaced)
+{
+    auto limiter = RateLimiter();
+    limiter.set_limit(MonitorEngine::RateLimit{10.0, 3});
+    auto now = RateLimiter::Clock::now();
+
+    // The burst starts at once, further tests are spread at the rate
+    ASSERT_EQ(now, limiter.reserve(TCP, NORMAL, now));
+    ASSERT_EQ(now, limiter.reserve(TCP, NORMAL, now));
+    ASSERT_EQ(now, limiter.reserve(TCP, NORMAL, now));
+    ASSERT_EQ(now + milliseconds(100), limiter.reserve(TCP, NORMAL, now));
+    ASSERT_EQ(now + milliseconds(200), limiter.reserve(TCP, NORMAL, now));
+
+    // An idle limiter refills its burst
+    auto later = now + seconds(10);
+    ASSERT_EQ(later, limiter.reserve(TCP, NORMAL, later));
+    ASSERT_EQ(later, limiter.reserve(TCP, NORMAL, later));
+    ASSERT_EQ(later, limiter.reserve(TCP, NORMAL, later));
+    ASSERT_EQ(later + milliseconds(100), limiter.reserve(TCP, NORMAL, later));
+
+    // Lifting the limit ends delays
+    limiter.set_limit(MonitorEngine::RateLimit());
+    ASSERT_EQ(later, limiter.reserve(TCP, NORMAL, later));
+}
+
+TEST(RateLimiterTest, ProtocolBudget)
+{
+    auto limiter = RateLimiter();
+    limiter.set_limit(MonitorEngine::RateLimit{100.0, 1});
+    limiter.set_limit(Endpoint::Protocol::ICMPV4, MonitorEngine::RateLimit{10.0, 1});
+    auto now = RateLimiter::Clock::now();
+
+    ASSERT_EQ(now, limiter.reserve(Endpoint::Protocol::ICMPV4, NORMAL, now));
+    ASSERT_EQ(now + milliseconds(100), limiter.reserve(Endpoint::Protocol::ICMPV4, NORMAL, now));
+
+    // Other protocols are limited by the global budget only, which ICMP used as well
+    ASSERT_EQ(now + milliseconds(110), limiter.reserve(TCP, NORMAL, now));
+    ASSERT_EQ(now + milliseconds(120), limiter.reserve(TCP, NORMAL, now));
+    ASSERT_EQ(now + milliseconds(200), limiter.reserve(Endpoint::Protocol::ICMPV4, NORMAL, now));
+}
+
+TEST(RateLimiterTest, Priorities)
+{
+    auto limiter = RateLimiter();
+    limiter.set_limit(MonitorEngine::RateLimit{10.0, 5});
+    auto now = RateLimiter::Clock::now();
+
+    // High priority tests are never delayed, but use up the budget
+    for (auto i = 0; i < 8; ++i)
+    {
+        ASSERT_EQ(now, limiter.reserve(TCP, HIGH, now));
+    }
+    ASSERT_EQ(now + milliseconds(400), limiter.reserve(TCP, NORMAL, now));
+
+    // Low priority tests leave half of the burst to others
+    auto later = now + seconds(10);
+    ASSERT_EQ(later, limiter.reserve(TCP, LOW, later));
+    ASSERT_EQ(later, limiter.reserve(TCP, LOW, later));
+    ASSERT_EQ(later, limiter.reserve(TCP, LOW, later));
+    ASSERT_EQ(later + milliseconds(100), limiter.reserve(TCP, LOW, later));
+    ASSERT_EQ(later, limiter.reserve(TCP, NORMAL, later));
+}
+
+TEST(RateLimiterTest, InvalidLimits)
+{
+    auto engine = MonitorEngine(1);
+    ASSERT_THROW(engine.set_rate_limit(MonitorEngine::RateLimit{-1.0, 1}), std::runtime_error);
+    ASSERT_THROW(engine.set_rate_limit(MonitorEngine::RateLimit{1.0, 0}), std::runtime_error);
+    ASSERT_THROW(engine.set_rate_limit(TCP, MonitorEngine::RateLimit{std::numeric_limits<double>::infinity(), 1}), std::runtime_error);
+    ASSERT_THROW(engine.set_startup_spread(milliseconds(-1)), std::runtime_error);
+    ASSERT_NO_THROW(engine.set_rate_limit(TCP, MonitorEngine::RateLimit{0.0, 1}));
+}
+
+TEST(RateLimiterTest, EngineSpreadsTests)
+{
+    auto listener = LoopbackSocket();
+    listener.listen(128);
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        auto engine = MonitorEngine(mode, 2);
+        engine.set_rate_limit(MonitorEngine::RateLimit{20.0, 1});
+
+        // Ten monitors due at once take half a second
+        auto mons = std::vector<std::unique_ptr<HostMonitor>>();
+        for (auto i = 0; i < 10; ++i)
+        {
+            mons.push_back(std::make_unique<HostMonitor>(ep, seconds(10), engine));
+        }
+
+        std::this_thread::sleep_for(milliseconds(150));
+        ASSERT_GE(5u, count_available(mons));
+
+        auto deadline = steady_clock::now() + seconds(2);
+        while (count_available(mons) < mons.size() && steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(milliseconds(10));
+        }
+        ASSERT_EQ(mons.size(), count_available(mons));
+    }
+}
+
+TEST(RateLimiterTest, StartupSpread)
+{
+    auto listener = LoopbackSocket();
+    listener.listen(128);
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        auto engine = MonitorEngine(mode, 1);
+        engine.set_startup_spread(milliseconds(600));
+
+        auto mons = std::vector<std::unique_ptr<HostMonitor>>();
+        for (auto i = 0; i < 40; ++i)
+        {
+            mons.push_back(std::make_unique<HostMonitor>(ep, seconds(10), engine));
+        }
+
+        // Random offsets within 600ms: hardly any within the first 30ms, all after 600ms
+        std::this_thread::sleep_for(milliseconds(30));
+        ASSERT_GT(mons.size() / 2, count_available(mons));
+
+        std::this_thread::sleep_for(milliseconds(900));
+        ASSERT_EQ(mons.size(), count_available(mons));
+    }
+}
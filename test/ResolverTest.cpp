@@ -0,0 +1,402 @@
+/**
+ * @file      ResolverTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <map>
+#include <algorithm>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include "Resolver.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Address;
+using host_monitor::Resolver;
+using host_monitor::resolve_address;
+
+namespace
+{
+auto const TIMEOUT = std::chrono::seconds(2);
+
+// Minimal DNS server on 127.0.0.1, answering A questions from a table.
+// Listens for UDP and TCP on the same port.
+class StubDns
+{
+public:
+    StubDns()
+        : sock_(SOCK_DGRAM)
+        , tcp_(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0))
+        , mtx_()
+        , records_()
+        , delay_(0)
+        , truncate_(false)
+        , queries_(0)
+        , tcp_queries_(0)
+        , stop_(false)
+        , thread_()
+    {
+        auto addr = sockaddr_in();
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<std::uint16_t>(std::stoi(sock_.port)));
+        ::bind(tcp_.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(tcp_.get(), 4);
+        thread_ = std::thread(&StubDns::run, this);
+    }
+
+    ~StubDns()
+    {
+        stop_ = true;
+        thread_.join();
+    }
+
+    // Answer A questions for @p name with @p ip. Empty ip answers NXDOMAIN.
+    void add(std::string const& name, std::string const& ip, std::uint32_t ttl)
+    {
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        records_[name] = Record{ip, ttl};
+    }
+
+    void set_delay(std::chrono::milliseconds delay)
+    {
+        delay_ = delay.count();
+    }
+
+    // Truncate all UDP responses, answer over TCP only
+    void set_truncate(bool truncate)
+    {
+        truncate_ = truncate;
+    }
+
+    std::size_t get_queries() const
+    {
+        return queries_;
+    }
+
+    std::size_t get_tcp_queries() const
+    {
+        return tcp_queries_;
+    }
+
+    Resolver::Options get_options() const
+    {
+        auto options = Resolver::Options::from_system();
+        options.nameservers = {resolve_address("127.0.0.1", AF_INET).value()};
+        options.nameservers.front().set_port(static_cast<std::uint16_t>(std::stoi(sock_.port)));
+        options.hosts_file.clear();
+        options.search.clear();
+        options.timeout = std::chrono::milliseconds(200);
+        options.attempts = 2;
+        options.min_ttl = std::chrono::seconds(0);
+        return options;
+    }
+
+private:
+    struct Record
+    {
+        std::string   ip;
+        std::uint32_t ttl;
+    };
+
+    void run()
+    {
+        auto buffer = std::array<std::uint8_t, 512>();
+        while (!stop_)
+        {
+            auto pfds = std::array<pollfd, 2>{pollfd{sock_.fd, POLLIN, 0}, pollfd{tcp_.get(), POLLIN, 0}};
+            if (::poll(pfds.data(), pfds.size(), 10) <= 0)
+            {
+                continue;
+            }
+
+            if (pfds[1].revents & POLLIN)
+            {
+                serve_tcp(host_monitor::Socket(::accept(tcp_.get(), nullptr, nullptr)));
+            }
+
+            if (!(pfds[0].revents & POLLIN))
+            {
+                continue;
+            }
+
+            auto peer = sockaddr_storage();
+            auto peer_len = socklen_t(sizeof(peer));
+            auto len = ::recvfrom( sock_.fd, buffer.data(), buffer.size(), 0
+                                 , reinterpret_cast<sockaddr*>(&peer), &peer_len);
+            if (len < 12)
+            {
+                continue;
+            }
+            queries_ += 1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_.load()));
+
+            auto response = answer(buffer.data(), static_cast<std::size_t>(len));
+            if (truncate_)
+            {
+                // Header and question only, with the TC flag set
+                response.resize(std::min(response.size(), question_size(buffer.data(), static_cast<std::size_t>(len))));
+                response[2] |= 0x02;
+                response[7] = 0;
+            }
+            ::sendto( sock_.fd, response.data(), response.size(), 0
+                    , reinterpret_cast<sockaddr*>(&peer), peer_len);
+        }
+    }
+
+    // Answer length prefixed queries until the client closes the connection
+    void serve_tcp(host_monitor::Socket conn)
+    {
+        auto buffer = std::array<std::uint8_t, 514>();
+        auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while (host_monitor::wait_for(conn.get(), POLLIN, deadline) & POLLIN)
+        {
+            auto len = ::recv(conn.get(), buffer.data(), 2, MSG_WAITALL);
+            auto size = std::size_t((buffer[0] << 8) | buffer[1]);
+            if (len != 2 || size < 12 || size > buffer.size() - 2 ||
+                ::recv(conn.get(), buffer.data() + 2, size, MSG_WAITALL) != static_cast<ssize_t>(size))
+            {
+                return;
+            }
+            tcp_queries_ += 1;
+
+            auto response = answer(buffer.data() + 2, size);
+            auto prefix = std::array<std::uint8_t, 2>{ static_cast<std::uint8_t>(response.size() >> 8)
+                                                     , static_cast<std::uint8_t>(response.size())};
+            response.insert(response.begin(), prefix.begin(), prefix.end());
+            ::send(conn.get(), response.data(), response.size(), MSG_NOSIGNAL);
+        }
+    }
+
+    // Length of header and question of @p query
+    static std::size_t question_size(std::uint8_t const* query, std::size_t len)
+    {
+        auto offset = std::size_t(12);
+        while (offset < len && query[offset] != 0)
+        {
+            offset += query[offset] + 1u;
+        }
+        return offset + 5;
+    }
+
+    std::vector<std::uint8_t> answer(std::uint8_t const* query, std::size_t len)
+    {
+        // Decode question name, labels are never compressed in queries
+        auto name = std::string();
+        auto offset = std::size_t(12);
+        while (offset < len && query[offset] != 0)
+        {
+            name += (name.empty() ? "" : ".");
+            name.append(reinterpret_cast<char const*>(query + offset + 1), query[offset]);
+            offset += query[offset] + 1u;
+        }
+        auto type = (query[offset + 1] << 8) | query[offset + 2];
+
+        auto response = std::vector<std::uint8_t>(query, query + offset + 5);
+        response[2] = 0x81; // QR, RD
+        response[3] = 0x80; // RA, NOERROR
+
+        auto lock = std::lock_guard<std::mutex>(mtx_);
+        auto record = records_.find(name);
+        if (record == records_.end() || record->second.ip.empty())
+        {
+            response[3] |= 0x03; // NXDOMAIN
+            return response;
+        }
+
+        // Only IPv4 records exist, AAAA questions get an empty answer
+        if (type == 1)
+        {
+            auto addr = in_addr();
+            ::inet_pton(AF_INET, record->second.ip.c_str(), &addr);
+            auto ttl = record->second.ttl;
+            auto const* ip = reinterpret_cast<std::uint8_t const*>(&addr);
+
+            response[7] = 1; // Answers
+            response.insert(response.end(), {0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01});
+            response.insert(response.end(), { static_cast<std::uint8_t>(ttl >> 24)
+                                            , static_cast<std::uint8_t>(ttl >> 16)
+                                            , static_cast<std::uint8_t>(ttl >> 8)
+                                            , static_cast<std::uint8_t>(ttl)});
+            response.insert(response.end(), {0x00, 0x04});
+            response.insert(response.end(), ip, ip + 4);
+        }
+        return response;
+    }
+
+    LoopbackSocket                 sock_;
+    host_monitor::Socket           tcp_;
+    std::mutex                     mtx_;
+    std::map<std::string, Record>  records_;
+    std::atomic<long>              delay_;
+    std::atomic<bool>              truncate_;
+    std::atomic<std::size_t>       queries_;
+    std::atomic<std::size_t>       tcp_queries_;
+    std::atomic<bool>              stop_;
+    std::thread                    thread_;
+};
+
+std::string to_string(Address const& address)
+{
+    auto buffer = std::array<char, INET6_ADDRSTRLEN>();
+    auto const* in = reinterpret_cast<sockaddr_in const*>(address.get());
+    ::inet_ntop(AF_INET, &in->sin_addr, buffer.data(), buffer.size());
+    return buffer.data();
+}
+} // anon namespace
+
+TEST(ResolverTest, NumericCompletesImmediately)
+{
+    auto dns = StubDns();
+    auto resolver = Resolver(dns.get_options());
+
+    auto request = resolver.resolve("127.0.0.1", AF_INET);
+    ASSERT_TRUE(request.is_done());
+    ASSERT_EQ(-1, request.get_fd());
+    ASSERT_EQ("127.0.0.1", to_string(request.get_result().value()));
+    ASSERT_EQ(0u, dns.get_queries());
+}
+
+TEST(ResolverTest, PositiveResultIsCached)
+{
+    auto dns = StubDns();
+    dns.add("host.test", "10.1.2.3", 60);
+    auto resolver = Resolver(dns.get_options());
+
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    auto first = resolver.resolve("host.test", AF_INET, deadline);
+    ASSERT_EQ("10.1.2.3", to_string(first.value()));
+    ASSERT_EQ(1u, dns.get_queries());
+
+    // Names are case-insensitive, trailing dots don't matter
+    auto request = resolver.resolve("HOST.test.", AF_INET);
+    ASSERT_TRUE(request.is_done());
+    ASSERT_EQ("10.1.2.3", to_string(request.get_result().value()));
+    ASSERT_EQ(1u, dns.get_queries());
+    ASSERT_EQ(1u, resolver.get_cache_size());
+}
+
+TEST(ResolverTest, NegativeResultIsCached)
+{
+    auto dns = StubDns();
+    auto resolver = Resolver(dns.get_options());
+
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_FALSE(resolver.resolve("missing.test", AF_INET, deadline));
+    ASSERT_EQ(1u, dns.get_queries());
+
+    auto request = resolver.resolve("missing.test", AF_INET);
+    ASSERT_TRUE(request.is_done());
+    ASSERT_FALSE(request.get_result());
+    ASSERT_EQ(1u, dns.get_queries());
+}
+
+TEST(ResolverTest, ConcurrentLookupsAreCoalesced)
+{
+    auto dns = StubDns();
+    dns.add("host.test", "10.1.2.3", 60);
+    dns.set_delay(std::chrono::milliseconds(100));
+    auto resolver = Resolver(dns.get_options());
+
+    auto requests = std::vector<Resolver::Request>();
+    for (auto i = 0; i < 10; ++i)
+    {
+        requests.push_back(resolver.resolve("host.test", AF_INET));
+        ASSERT_FALSE(requests.back().is_done());
+    }
+
+    for (auto const& request : requests)
+    {
+        ASSERT_TRUE(host_monitor::wait_for( request.get_fd(), POLLIN
+                                          , std::chrono::steady_clock::now() + TIMEOUT) & POLLIN);
+        ASSERT_EQ("10.1.2.3", to_string(request.get_result().value()));
+    }
+    ASSERT_EQ(1u, dns.get_queries());
+}
+
+TEST(ResolverTest, ExpiredResultIsQueriedAgain)
+{
+    auto dns = StubDns();
+    dns.add("host.test", "10.1.2.3", 1);
+    auto resolver = Resolver(dns.get_options());
+
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_TRUE(resolver.resolve("host.test", AF_INET, deadline));
+
+    // Record changed while the cached result expired
+    dns.add("host.test", "10.3.2.1", 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+    deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_EQ("10.3.2.1", to_string(resolver.resolve("host.test", AF_INET, deadline).value()));
+    ASSERT_EQ(2u, dns.get_queries());
+}
+
+TEST(ResolverTest, UnansweredQueryFails)
+{
+    auto dns = StubDns();
+    dns.add("host.test", "10.1.2.3", 60);
+    dns.set_delay(std::chrono::milliseconds(500));
+    auto resolver = Resolver(dns.get_options());
+
+    // Two attempts of 200ms each, both run into the timeout
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_FALSE(resolver.resolve("host.test", AF_INET, deadline));
+
+    auto request = resolver.resolve("host.test", AF_INET);
+    ASSERT_TRUE(request.is_done());
+    ASSERT_FALSE(request.get_result());
+}
+
+TEST(ResolverTest, SearchDomainsAreApplied)
+{
+    auto dns = StubDns();
+    dns.add("host.first.test", "", 60);
+    dns.add("host.second.test", "10.1.2.3", 60);
+    dns.add("host.first", "10.3.2.1", 60);
+    auto options = dns.get_options();
+    options.search = {"first.test", "second.test"};
+    options.ndots = 1;
+    auto resolver = Resolver(options);
+
+    // Fewer dots than ndots: search domains first, until one resolves
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_EQ("10.1.2.3", to_string(resolver.resolve("host", AF_INET, deadline).value()));
+    ASSERT_EQ(2u, dns.get_queries());
+
+    // Enough dots: as given first. Absolute names are never expanded.
+    deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_EQ("10.3.2.1", to_string(resolver.resolve("host.first", AF_INET, deadline).value()));
+    ASSERT_EQ(3u, dns.get_queries());
+
+    deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_FALSE(resolver.resolve("host.", AF_INET, deadline));
+    ASSERT_EQ(4u, dns.get_queries());
+}
+
+TEST(ResolverTest, TruncatedResponseRetriesOverTcp)
+{
+    auto dns = StubDns();
+    dns.add("host.test", "10.1.2.3", 60);
+    dns.set_truncate(true);
+    auto resolver = Resolver(dns.get_options());
+
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    ASSERT_EQ("10.1.2.3", to_string(resolver.resolve("host.test", AF_INET, deadline).value()));
+    ASSERT_EQ(1u, dns.get_queries());
+    ASSERT_EQ(1u, dns.get_tcp_queries());
+}
@@ -0,0 +1,91 @@
+/**
+ * @file      ScheduleTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <chrono>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "HostMonitorImpl.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using namespace std::chrono;
+
+namespace
+{
+HostMonitor::Impl make_monitor(HostMonitor::Schedule schedule)
+{
+    return HostMonitor::Impl(Endpoint::make_icmpv4_endpoint("127.0.0.1"), schedule);
+}
+} // anon namespace
+
+TEST(ScheduleTest, Fixed)
+{
+    auto monitor = make_monitor(HostMonitor::Schedule::fixed(milliseconds(250)));
+    for (auto i = 0; i < 50; ++i)
+    {
+        ASSERT_EQ(milliseconds(250), monitor.advance_schedule(i % 3 == 0));
+    }
+}
+
+TEST(ScheduleTest, FailuresAreRetriedQuickly)
+{
+    auto monitor = make_monitor(HostMonitor::Schedule::adaptive(seconds(1)));
+    ASSERT_EQ(milliseconds(1000), monitor.advance_schedule(true));
+
+    // Two fast retries confirm the failure, then the base interval applies
+    ASSERT_EQ(milliseconds(250), monitor.advance_schedule(false));
+    ASSERT_EQ(milliseconds(250), monitor.advance_schedule(false));
+    ASSERT_EQ(milliseconds(1000), monitor.advance_schedule(false));
+    ASSERT_EQ(milliseconds(1000), monitor.advance_schedule(false));
+
+    // A recovery restarts the retries
+    ASSERT_EQ(milliseconds(1000), monitor.advance_schedule(true));
+    ASSERT_EQ(milliseconds(250), monitor.advance_schedule(false));
+}
+
+TEST(ScheduleTest, StableHostsBackOff)
+{
+    auto monitor = make_monitor(HostMonitor::Schedule::adaptive(seconds(1)));
+
+    // The interval doubles after every 10 successes up to 8 times the base interval
+    auto expected = milliseconds(1000);
+    for (auto round = 0; round < 5; ++round)
+    {
+        for (auto i = 0; i < 9; ++i)
+        {
+            ASSERT_EQ(expected, monitor.advance_schedule(true));
+        }
+        expected = std::min(expected * 2, milliseconds(8000));
+        ASSERT_EQ(expected, monitor.advance_schedule(true));
+    }
+
+    // A failure restores the base interval
+    ASSERT_EQ(milliseconds(250), monitor.advance_schedule(false));
+    ASSERT_EQ(milliseconds(1000), monitor.advance_schedule(true));
+}
+
+TEST(ScheduleTest, Limits)
+{
+    auto schedule = HostMonitor::Schedule::adaptive(seconds(1));
+    schedule.min_interval = milliseconds(500);
+    schedule.max_interval = milliseconds(1500);
+    schedule.stable_tests = 1;
+
+    auto monitor = make_monitor(schedule);
+    ASSERT_EQ(milliseconds(500), monitor.advance_schedule(false));
+    ASSERT_EQ(milliseconds(1500), monitor.advance_schedule(true));
+    ASSERT_EQ(milliseconds(1500), monitor.advance_schedule(true));
+
+    schedule.min_interval = milliseconds(2000);
+    ASSERT_THROW(make_monitor(schedule), std::runtime_error);
+    ASSERT_THROW(make_monitor(HostMonitor::Schedule::fixed(milliseconds(0))), std::runtime_error);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file      SeqLockTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include "SeqLock.hpp"
+
+using host_monitor::SeqLock;
+
+namespace
+{
+// Spans several words, a torn read shows up as differing values.
+struct Value
+{
+    std::array<std::uint64_t, 5> words{};
+    std::uint8_t                 tail = 0;
+};
+} // anon namespace
+
+TEST(SeqLockTest, StoreAndLoad)
+{
+    auto value = Value();
+    value.words = {1, 2, 3, 4, 5};
+    value.tail = 6;
+
+    auto lock = SeqLock<Value>(value);
+    ASSERT_EQ(value.words, lock.load().words);
+    ASSERT_EQ(6, lock.load().tail);
+
+    value.tail = 7;
+    lock.store(value);
+    ASSERT_EQ(7, lock.load().tail);
+}
+
+TEST(SeqLockTest, ConcurrentReadsAreNeverTorn)
+{
+    auto lock = SeqLock<Value>();
+    auto done = std::atomic<bool>(false);
+    auto torn = std::atomic<std::size_t>(0);
+
+    auto readers = std::vector<std::thread>();
+    for (auto i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&lock, &done, &torn] ()
+        {
+            while (!done)
+            {
+                auto value = lock.load();
+                for (auto word : value.words)
+                {
+                    if (word != value.words[0] || static_cast<std::uint8_t>(word) != value.tail)
+                    {
+                        torn += 1;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto i = std::uint64_t(1); i <= 1000000; ++i)
+    {
+        auto value = Value();
+        value.words.fill(i);
+        value.tail = static_cast<std::uint8_t>(i);
+        lock.store(value);
+    }
+    done = true;
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    ASSERT_EQ(0u, torn);
+    ASSERT_EQ(1000000u, lock.load().words[4]);
+}
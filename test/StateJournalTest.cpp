@@ -0,0 +1,248 @@
+/**
+ * @file      StateJournalTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "HostMonitor.hpp"
+#include "MonitorEngine.hpp"
+#include "StateJournal.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::HostMonitor;
+using host_monitor::MonitorEngine;
+using host_monitor::StateJournal;
+using namespace std::chrono;
+
+namespace
+{
+struct CountingObserver : public host_monitor::HostMonitorObserver
+{
+    void state_change(Data const&) override
+    {
+        calls += 1;
+    }
+
+    std::atomic<int> calls = 0;
+};
+
+// Journal file removed at the end of the test
+struct TempPath
+{
+    TempPath()
+        : path(::testing::TempDir() + "host_monitor_journal_" + std::to_string(::getpid()))
+    {
+        ::unlink(path.c_str());
+    }
+
+    ~TempPath()
+    {
+        ::unlink(path.c_str());
+    }
+
+    std::string path;
+};
+
+bool wait_until(std::function<bool()> pred, milliseconds timeout)
+{
+    auto deadline = steady_clock::now() + timeout;
+    while (!pred() && steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(milliseconds(5));
+    }
+    return pred();
+}
+} // anon namespace
+
+TEST(StateJournalTest, WarmRestart)
+{
+    auto tmp = TempPath();
+    auto listener = LoopbackSocket();
+    listener.listen();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+
+    for (auto mode : {MonitorEngine::Mode::EVENT_LOOP, MonitorEngine::Mode::THREAD_PER_MONITOR})
+    {
+        // First run: the endpoint comes up
+        {
+            auto journal = StateJournal(tmp.path, 64);
+            auto engine = MonitorEngine(mode, 1);
+            engine.attach_journal(journal);
+            auto mon = HostMonitor(ep, seconds(10), engine);
+            ASSERT_TRUE(wait_until([&mon] () { return mon.is_available(); }, milliseconds(1000)));
+        }
+
+        auto journal = StateJournal(tmp.path);
+        auto recorded = journal.find(ep);
+        ASSERT_TRUE(recorded);
+        ASSERT_TRUE(recorded->available);
+        ASSERT_NE(system_clock::time_point(), recorded->last_change);
+        ASSERT_LE(1u, recorded->probes);
+        ASSERT_EQ(0u, recorded->failures);
+
+        // Restart: the monitor starts available, its first test changes nothing
+        auto engine = MonitorEngine(mode, 1);
+        engine.attach_journal(journal);
+        auto obs = std::make_shared<CountingObserver>();
+        auto mon = HostMonitor(ep, seconds(10), engine);
+        mon.add_observer(obs);
+        ASSERT_TRUE(mon.is_available());
+        ASSERT_EQ(recorded->last_change, mon.get_state().last_change);
+
+        ASSERT_TRUE(wait_until([&journal, &ep, &recorded] ()
+        {
+            return journal.find(ep)->probes > recorded->probes;
+        }, milliseconds(1000)));
+        ASSERT_TRUE(mon.is_available());
+        ASSERT_EQ(0, obs->calls);
+        ASSERT_EQ(recorded->changes, journal.find(ep)->changes);
+    }
+}
+
+TEST(StateJournalTest, ChangesAreRecorded)
+{
+    auto tmp = TempPath();
+    auto listener = std::make_unique<LoopbackSocket>();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener->port);
+    auto journal = StateJournal(tmp.path, 64);
+    ASSERT_FALSE(journal.find(ep));
+
+    // Nothing listens yet
+    auto schedule = HostMonitor::Schedule::fixed(milliseconds(50));
+    auto engine = MonitorEngine(1);
+    engine.attach_journal(journal);
+    auto mon = HostMonitor(ep, schedule, engine);
+    ASSERT_TRUE(wait_until([&journal, &ep] () { return journal.find(ep).has_value(); }, milliseconds(1000)));
+    ASSERT_FALSE(journal.find(ep)->available);
+    ASSERT_EQ(1u, journal.get_size());
+
+    listener->listen();
+    ASSERT_TRUE(wait_until([&journal, &ep] () { return journal.find(ep)->available; }, milliseconds(1000)));
+
+    auto entry = journal.find(ep);
+    ASSERT_EQ(1u, entry->changes);
+    ASSERT_LE(1u, entry->failures);
+    ASSERT_EQ(0u, entry->consecutive_failures);
+    ASSERT_EQ(mon.get_state().last_change, entry->last_change);
+}
+
+TEST(StateJournalTest, SharedEndpointHasOneWriter)
+{
+    auto tmp = TempPath();
+    auto listener = LoopbackSocket();
+    listener.listen();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+
+    // Both monitors test once, on different loops. Only the first one records.
+    auto journal = StateJournal(tmp.path, 64);
+    auto engine = MonitorEngine(2);
+    engine.attach_journal(journal);
+    auto first = HostMonitor(ep, seconds(10), engine);
+    auto second = HostMonitor(ep, seconds(10), engine);
+    ASSERT_TRUE(wait_until([&first, &second] () { return first.is_available() && second.is_available(); }, milliseconds(1000)));
+
+    std::this_thread::sleep_for(milliseconds(50));
+    ASSERT_EQ(1u, journal.find(ep)->probes);
+    ASSERT_EQ(1u, journal.get_size());
+}
+
+TEST(StateJournalTest, TornRecord)
+{
+    auto tmp = TempPath();
+    auto listener = LoopbackSocket();
+    listener.listen();
+    auto ep = Endpoint::make_tcp_endpoint("127.0.0.1", listener.port);
+    {
+        auto journal = StateJournal(tmp.path, 4);
+        auto engine = MonitorEngine(1);
+        engine.attach_journal(journal);
+        auto mon = HostMonitor(ep, seconds(10), engine);
+        ASSERT_TRUE(wait_until([&journal, &ep] () { return journal.find(ep).has_value(); }, milliseconds(1000)));
+    }
+
+    // Crash during a write: the sequence number of the used record stays odd.
+    // Records of 64 bytes follow a header of the same size, the sequence is their second word.
+    {
+        auto file = std::fstream(tmp.path, std::ios::in | std::ios::out | std::ios::binary);
+        for (auto offset = std::streamoff(64); offset < 64 * 5; offset += 64)
+        {
+            auto words = std::array<std::uint64_t, 2>();
+            file.seekg(offset);
+            file.read(reinterpret_cast<char*>(words.data()), sizeof(words));
+            if (words[0] != 0)
+            {
+                words[1] |= 1;
+                file.seekp(offset);
+                file.write(reinterpret_cast<char const*>(words.data()), sizeof(words));
+            }
+        }
+    }
+
+    auto journal = StateJournal(tmp.path);
+    ASSERT_FALSE(journal.find(ep));
+
+    // The next test repairs the record
+    auto engine = MonitorEngine(1);
+    engine.attach_journal(journal);
+    auto mon = HostMonitor(ep, seconds(10), engine);
+    ASSERT_TRUE(wait_until([&journal, &ep] () { return journal.find(ep).has_value(); }, milliseconds(1000)));
+    ASSERT_TRUE(journal.find(ep)->available);
+}
+
+TEST(StateJournalTest, Capacity)
+{
+    auto tmp = TempPath();
+    auto journal = StateJournal(tmp.path, 3);
+    ASSERT_EQ(4u, journal.get_capacity());
+
+    // Endpoints beyond the capacity are monitored without journal
+    auto engine = MonitorEngine(1);
+    engine.attach_journal(journal);
+    auto mons = std::vector<std::unique_ptr<HostMonitor>>();
+    for (auto i = 0; i < 6; ++i)
+    {
+        auto ep = Endpoint::make_icmpv4_endpoint("127.0.0." + std::to_string(i + 1));
+        mons.push_back(std::make_unique<HostMonitor>(ep, seconds(10), engine));
+    }
+    ASSERT_EQ(4u, journal.get_size());
+
+    for (auto const& mon : mons)
+    {
+        ASSERT_TRUE(wait_until([&mon] () { return mon->is_available(); }, milliseconds(1000)));
+    }
+}
+
+TEST(StateJournalTest, InvalidFiles)
+{
+    auto tmp = TempPath();
+    {
+        auto file = std::ofstream(tmp.path);
+        file << "not a journal";
+    }
+    ASSERT_THROW(StateJournal(tmp.path), std::runtime_error);
+    ::unlink(tmp.path.c_str());
+
+    // A journal has a single owner
+    auto journal = StateJournal(tmp.path, 16);
+    ASSERT_THROW(StateJournal(tmp.path), std::runtime_error);
+
+    ASSERT_THROW(StateJournal("/nonexistent/journal"), std::runtime_error);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file      TimerWheelTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include "TimerWheel.hpp"
+
+using host_monitor::TimerWheel;
+using namespace std::chrono;
+
+class TimerWheelTest : public ::testing::Test
+{
+public:
+    TimerWheel::Clock::time_point const start = TimerWheel::Clock::time_point();
+    TimerWheel                          wheel = TimerWheel(start);
+    std::vector<std::uint64_t>          fired;
+
+    void advance(milliseconds to)
+    {
+        wheel.advance(start + to, [this] (TimerWheel::Node& node)
+        {
+            fired.push_back(node.id);
+        });
+    }
+};
+
+TEST_F(TimerWheelTest, NeverFiresEarly)
+{
+    auto node = TimerWheel::Node();
+    node.id = 1;
+    wheel.schedule(node, start + milliseconds(10) + microseconds(1));
+
+    advance(milliseconds(10));
+    ASSERT_TRUE(fired.empty());
+
+    advance(milliseconds(11));
+    ASSERT_EQ(std::vector<std::uint64_t>{1}, fired);
+    ASSERT_FALSE(TimerWheel::is_scheduled(node));
+    ASSERT_EQ(0u, wheel.size());
+}
+
+TEST_F(TimerWheelTest, Cancel)
+{
+    auto node = TimerWheel::Node();
+    wheel.schedule(node, start + milliseconds(5));
+    ASSERT_EQ(1u, wheel.size());
+
+    wheel.cancel(node);
+    ASSERT_EQ(0u, wheel.size());
+
+    advance(milliseconds(100));
+    ASSERT_TRUE(fired.empty());
+}
+
+TEST_F(TimerWheelTest, CascadeFromHigherLevels)
+{
+    // Expiries on every level of the wheel, scheduled in reverse order
+    auto const expiries = std::vector<milliseconds>{ hours(30 * 24), hours(2), minutes(20)
+                                                   , seconds(20), milliseconds(300)
+                                                   , milliseconds(100) };
+    auto nodes = std::vector<TimerWheel::Node>(expiries.size());
+    for (auto i = std::size_t(0); i < expiries.size(); ++i)
+    {
+        nodes[i].id = i;
+        wheel.schedule(nodes[i], start + expiries[i]);
+    }
+
+    // Each node fires exactly on its tick
+    for (auto i = expiries.size(); i-- > 0;)
+    {
+        advance(expiries[i] - milliseconds(1));
+        ASSERT_EQ(expiries.size() - i - 1, fired.size());
+
+        advance(expiries[i]);
+        ASSERT_EQ(expiries.size() - i, fired.size());
+        ASSERT_EQ(i, fired.back());
+    }
+}
+
+TEST_F(TimerWheelTest, RescheduleFromCallback)
+{
+    auto node = TimerWheel::Node();
+    auto count = 0;
+    wheel.schedule(node, start + milliseconds(10));
+
+    for (auto now = milliseconds(0); now <= milliseconds(1000); now += milliseconds(4))
+    {
+        wheel.advance(start + now, [&] (TimerWheel::Node& n)
+        {
+            count += 1;
+            wheel.schedule(n, start + milliseconds(10) * (count + 1));
+        });
+    }
+    wheel.cancel(node);
+
+    ASSERT_EQ(100, count);
+}
+
+TEST_F(TimerWheelTest, NextTimeout)
+{
+    ASSERT_EQ(-1, wheel.next_timeout(start));
+
+    auto node = TimerWheel::Node();
+    wheel.schedule(node, start + milliseconds(50));
+    ASSERT_EQ(50, wheel.next_timeout(start));
+
+    // Far timers wake up once they cascade to the lowest level
+    wheel.schedule(node, start + seconds(60));
+    ASSERT_EQ(49152, wheel.next_timeout(start));
+
+    wheel.cancel(node);
+}
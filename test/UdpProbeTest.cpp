@@ -0,0 +1,117 @@
+/**
+ * @file      UdpProbeTest.cpp
+ * @author    Simon Brummer <simon.brummer@posteo.de>
+ * @copyright 2017 Simon Brummer. All rights reserved.
+ */
+
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include "TestConnection.hpp"
+#include "LoopbackSocket.hpp"
+
+using host_monitor::Endpoint;
+using host_monitor::test_connection;
+using namespace std::chrono;
+
+namespace
+{
+// UDP server on 127.0.0.1 echoing each datagram
+class UdpEchoServer
+{
+public:
+    UdpEchoServer()
+        : sock_(SOCK_DGRAM)
+        , stop_(false)
+        , thread_(&UdpEchoServer::run, this)
+    {
+    }
+
+    ~UdpEchoServer()
+    {
+        stop_ = true;
+        thread_.join();
+    }
+
+    std::string const& get_port() const
+    {
+        return sock_.port;
+    }
+
+private:
+    void run()
+    {
+        auto buffer = std::array<char, 2048>();
+        while (!stop_)
+        {
+            auto pfd = pollfd{sock_.fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 10) <= 0)
+            {
+                continue;
+            }
+
+            auto peer = sockaddr_storage();
+            auto peer_len = socklen_t(sizeof(peer));
+            auto len = ::recvfrom( sock_.fd, buffer.data(), buffer.size(), 0
+                                 , reinterpret_cast<sockaddr*>(&peer), &peer_len);
+            if (len >= 0)
+            {
+                ::sendto( sock_.fd, buffer.data(), static_cast<std::size_t>(len), 0
+                        , reinterpret_cast<sockaddr*>(&peer), peer_len);
+            }
+        }
+    }
+
+    LoopbackSocket    sock_;
+    std::atomic<bool> stop_;
+    std::thread       thread_;
+};
+} // anon namespace
+
+TEST(UdpProbeTest, EchoResponds)
+{
+    auto server = UdpEchoServer();
+    ASSERT_TRUE(test_connection(Endpoint::make_udp_endpoint("127.0.0.1", server.get_port(), "ping")));
+    ASSERT_TRUE(test_connection(Endpoint::make_udp_endpoint("127.0.0.1", server.get_port())));
+}
+
+TEST(UdpProbeTest, ResponseIsMatched)
+{
+    auto server = UdpEchoServer();
+    auto port = server.get_port();
+    ASSERT_TRUE(test_connection(Endpoint::make_udp_endpoint("127.0.0.1", port, "hello world", "hello")));
+    ASSERT_FALSE(test_connection(Endpoint::make_udp_endpoint("127.0.0.1", port, "hello world", "world")));
+    ASSERT_FALSE(test_connection(Endpoint::make_udp_endpoint("127.0.0.1", port, "hi", "hello")));
+}
+
+TEST(UdpProbeTest, PortUnreachableFailsFast)
+{
+    // Port is free again once the socket is closed
+    auto port = LoopbackSocket(SOCK_DGRAM).port;
+    auto ep = Endpoint::make_udp_endpoint("127.0.0.1", port, "ping");
+
+    auto start = steady_clock::now();
+    ASSERT_FALSE(test_connection(ep, seconds(5)));
+    ASSERT_GT(milliseconds(500), steady_clock::now() - start);
+}
+
+TEST(UdpProbeTest, SilenceTimesOut)
+{
+    // Socket receives datagrams but never responds
+    auto silent = LoopbackSocket(SOCK_DGRAM);
+    auto ep = Endpoint::make_udp_endpoint("127.0.0.1", silent.port, "ping");
+
+    auto start = steady_clock::now();
+    ASSERT_FALSE(test_connection(ep, milliseconds(200)));
+    ASSERT_LE(milliseconds(200), steady_clock::now() - start);
+}
@@ -18,10 +18,10 @@ using host_monitor::Version;
 class VersionTest : public ::testing::Test
 {
 public:
-    char const * const expected_major = "1";
-    char const * const expected_minor = "1";
+    char const * const expected_major = "2";
+    char const * const expected_minor = "0";
     char const * const expected_patch = "0";
-    char const * const expected_full  = "1.1.0";
+    char const * const expected_full  = "2.0.0";
 
     void SetUp(void)
     {